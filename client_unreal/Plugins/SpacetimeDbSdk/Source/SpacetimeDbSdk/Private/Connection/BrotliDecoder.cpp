@@ -0,0 +1,1245 @@
+#include "Connection/BrotliDecoder.h"
+
+namespace UE::SpacetimeDB::Compression
+{
+	/** RFC 7932 Appendix A static dictionary, defined in BrotliDictionary.cpp. */
+	extern const uint8 BrotliDictionaryData[122784];
+}
+
+namespace UE::SpacetimeDB::Compression::BrotliPrivate
+{
+	/** Bits resolved by the first level of a prefix code table, longer codes continue in a second level table. */
+	constexpr uint32 RootBits = 8;
+
+	/** Largest alphabet, the insert-and-copy lengths. */
+	constexpr int32 MaxAlphabetSize = 704;
+
+	/** Number of code length codes and the order their lengths are stored in (RFC 7932 3.5). */
+	constexpr int32 NumCodeLengthCodes = 18;
+	constexpr uint8 CodeLengthCodeOrder[NumCodeLengthCodes] = { 1, 2, 3, 4, 0, 5, 17, 6, 16, 7, 8, 9, 10, 11, 12, 13, 14, 15 };
+
+	/** Fixed prefix code of the code length code lengths, indexed by the next 4 bits. */
+	constexpr uint8 CodeLengthPrefixBits[16] = { 2, 2, 2, 3, 2, 2, 2, 4, 2, 2, 2, 3, 2, 2, 2, 4 };
+	constexpr uint8 CodeLengthPrefixValue[16] = { 0, 4, 3, 2, 0, 4, 3, 1, 0, 4, 3, 2, 0, 4, 3, 5 };
+
+	/** Block count codes (RFC 7932 6). */
+	constexpr uint32 BlockCountBase[26] = { 1, 5, 9, 13, 17, 25, 33, 41, 49, 65, 81, 97, 113, 145, 177, 209, 241, 305, 369, 497, 753, 1265, 2289, 4337, 8433, 16625 };
+	constexpr uint8 BlockCountExtra[26] = { 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 6, 6, 7, 8, 9, 10, 11, 12, 13, 24 };
+
+	/** Insert and copy length codes (RFC 7932 5). */
+	constexpr uint32 InsertLengthBase[24] = { 0, 1, 2, 3, 4, 5, 6, 8, 10, 14, 18, 26, 34, 50, 66, 98, 130, 194, 322, 578, 1090, 2114, 6210, 22594 };
+	constexpr uint8 InsertLengthExtra[24] = { 0, 0, 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 7, 8, 9, 10, 12, 14, 24 };
+	constexpr uint32 CopyLengthBase[24] = { 2, 3, 4, 5, 6, 7, 8, 9, 10, 12, 14, 18, 22, 30, 38, 54, 70, 102, 134, 198, 326, 582, 1094, 2118 };
+	constexpr uint8 CopyLengthExtra[24] = { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 7, 8, 9, 10, 24 };
+
+	/** First insert and copy length code of each 64 symbol cell of the insert-and-copy alphabet. */
+	constexpr uint8 CommandInsertBase[11] = { 0, 0, 0, 0, 8, 8, 0, 16, 8, 16, 16 };
+	constexpr uint8 CommandCopyBase[11] = { 0, 8, 0, 8, 0, 8, 16, 0, 16, 8, 16 };
+
+	/** Short distance codes 0 to 15, the last distance they start from and the delta applied to it. */
+	constexpr uint8 ShortDistanceIndex[16] = { 0, 1, 2, 3, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1 };
+	constexpr int8 ShortDistanceDelta[16] = { 0, 0, 0, 0, -1, 1, -2, 2, -3, 3, -1, 1, -2, 2, -3, 3 };
+
+	/** Dictionary words of each length 4 to 24: log2 of their count and their offset in the dictionary. */
+	constexpr uint8 DictionarySizeBits[25] = { 0, 0, 0, 0, 10, 10, 11, 11, 10, 10, 10, 10, 10, 9, 9, 8, 7, 7, 8, 7, 7, 6, 6, 5, 5 };
+	constexpr uint32 DictionaryOffsets[25] = { 0, 0, 0, 0, 0, 4096, 9216, 21504, 35840, 44032, 53248, 63488, 74752, 87040, 93696, 100864, 104704, 106752, 108928, 113536, 115968, 118528, 119872, 121280, 122016 };
+
+	/** Literal context modes (RFC 7932 7.1). */
+	enum class EContextMode : uint8
+	{
+		LSB6,
+		MSB6,
+		UTF8,
+		Signed
+	};
+
+	/** UTF8 context mode, looked up by the last byte. */
+	constexpr uint8 ContextLut0[256] =
+	{
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 4, 4, 0, 0, 4, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		8, 12, 16, 12, 12, 20, 12, 16, 24, 28, 12, 12, 32, 12, 36, 12,
+		44, 44, 44, 44, 44, 44, 44, 44, 44, 44, 32, 32, 24, 40, 28, 12,
+		12, 48, 52, 52, 52, 48, 52, 52, 52, 48, 52, 52, 52, 52, 52, 48,
+		52, 52, 52, 52, 52, 48, 52, 52, 52, 52, 52, 24, 12, 28, 12, 12,
+		12, 56, 60, 60, 60, 56, 60, 60, 60, 56, 60, 60, 60, 60, 60, 56,
+		60, 60, 60, 60, 60, 56, 60, 60, 60, 60, 60, 24, 12, 28, 12, 0,
+		0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
+		0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
+		0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
+		0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1, 0, 1,
+		2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3,
+		2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3,
+		2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3,
+		2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3, 2, 3,
+	};
+
+	/** UTF8 context mode, looked up by the byte before it. */
+	constexpr uint8 ContextLut1[256] =
+	{
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+		2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 1, 1, 1, 1, 1, 1,
+		1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+		2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 1, 1, 1, 1, 1,
+		1, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+		3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 1, 1, 1, 1, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+		2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+		2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+	};
+
+	/** Signed context mode, looked up by each of the two last bytes. */
+	constexpr uint8 ContextLut2[256] =
+	{
+		0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+		2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+		2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+		2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2,
+		3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+		3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+		3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+		3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3,
+		4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+		4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+		4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+		4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4,
+		5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+		5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+		5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5,
+		6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 7,
+	};
+
+	/** Word transforms of RFC 7932 Appendix B. */
+	enum class EWordTransform : uint8
+	{
+		Identity,
+		OmitLast1, OmitLast2, OmitLast3, OmitLast4, OmitLast5, OmitLast6, OmitLast7, OmitLast8, OmitLast9,
+		UppercaseFirst,
+		UppercaseAll,
+		OmitFirst1, OmitFirst2, OmitFirst3, OmitFirst4, OmitFirst5, OmitFirst6, OmitFirst7, OmitFirst8, OmitFirst9
+	};
+
+	struct FWordTransform
+	{
+		const char* Prefix;
+		EWordTransform Type;
+		const char* Suffix;
+	};
+
+	constexpr int32 NumWordTransforms = 121;
+	constexpr FWordTransform WordTransforms[NumWordTransforms] =
+	{
+		{ "", EWordTransform::Identity, "" },
+		{ "", EWordTransform::Identity, " " },
+		{ " ", EWordTransform::Identity, " " },
+		{ "", EWordTransform::OmitFirst1, "" },
+		{ "", EWordTransform::UppercaseFirst, " " },
+		{ "", EWordTransform::Identity, " the " },
+		{ " ", EWordTransform::Identity, "" },
+		{ "s ", EWordTransform::Identity, " " },
+		{ "", EWordTransform::Identity, " of " },
+		{ "", EWordTransform::UppercaseFirst, "" },
+		{ "", EWordTransform::Identity, " and " },
+		{ "", EWordTransform::OmitFirst2, "" },
+		{ "", EWordTransform::OmitLast1, "" },
+		{ ", ", EWordTransform::Identity, " " },
+		{ "", EWordTransform::Identity, ", " },
+		{ " ", EWordTransform::UppercaseFirst, " " },
+		{ "", EWordTransform::Identity, " in " },
+		{ "", EWordTransform::Identity, " to " },
+		{ "e ", EWordTransform::Identity, " " },
+		{ "", EWordTransform::Identity, "\"" },
+		{ "", EWordTransform::Identity, "." },
+		{ "", EWordTransform::Identity, "\">" },
+		{ "", EWordTransform::Identity, "\n" },
+		{ "", EWordTransform::OmitLast3, "" },
+		{ "", EWordTransform::Identity, "]" },
+		{ "", EWordTransform::Identity, " for " },
+		{ "", EWordTransform::OmitFirst3, "" },
+		{ "", EWordTransform::OmitLast2, "" },
+		{ "", EWordTransform::Identity, " a " },
+		{ "", EWordTransform::Identity, " that " },
+		{ " ", EWordTransform::UppercaseFirst, "" },
+		{ "", EWordTransform::Identity, ". " },
+		{ ".", EWordTransform::Identity, "" },
+		{ " ", EWordTransform::Identity, ", " },
+		{ "", EWordTransform::OmitFirst4, "" },
+		{ "", EWordTransform::Identity, " with " },
+		{ "", EWordTransform::Identity, "'" },
+		{ "", EWordTransform::Identity, " from " },
+		{ "", EWordTransform::Identity, " by " },
+		{ "", EWordTransform::OmitFirst5, "" },
+		{ "", EWordTransform::OmitFirst6, "" },
+		{ " the ", EWordTransform::Identity, "" },
+		{ "", EWordTransform::OmitLast4, "" },
+		{ "", EWordTransform::Identity, ". The " },
+		{ "", EWordTransform::UppercaseAll, "" },
+		{ "", EWordTransform::Identity, " on " },
+		{ "", EWordTransform::Identity, " as " },
+		{ "", EWordTransform::Identity, " is " },
+		{ "", EWordTransform::OmitLast7, "" },
+		{ "", EWordTransform::OmitLast1, "ing " },
+		{ "", EWordTransform::Identity, "\n\t" },
+		{ "", EWordTransform::Identity, ":" },
+		{ " ", EWordTransform::Identity, ". " },
+		{ "", EWordTransform::Identity, "ed " },
+		{ "", EWordTransform::OmitFirst9, "" },
+		{ "", EWordTransform::OmitFirst7, "" },
+		{ "", EWordTransform::OmitLast6, "" },
+		{ "", EWordTransform::Identity, "(" },
+		{ "", EWordTransform::UppercaseFirst, ", " },
+		{ "", EWordTransform::OmitLast8, "" },
+		{ "", EWordTransform::Identity, " at " },
+		{ "", EWordTransform::Identity, "ly " },
+		{ " the ", EWordTransform::Identity, " of " },
+		{ "", EWordTransform::OmitLast5, "" },
+		{ "", EWordTransform::OmitLast9, "" },
+		{ " ", EWordTransform::UppercaseFirst, ", " },
+		{ "", EWordTransform::UppercaseFirst, "\"" },
+		{ ".", EWordTransform::Identity, "(" },
+		{ "", EWordTransform::UppercaseAll, " " },
+		{ "", EWordTransform::UppercaseFirst, "\">" },
+		{ "", EWordTransform::Identity, "=\"" },
+		{ " ", EWordTransform::Identity, "." },
+		{ ".com/", EWordTransform::Identity, "" },
+		{ " the ", EWordTransform::Identity, " of the " },
+		{ "", EWordTransform::UppercaseFirst, "'" },
+		{ "", EWordTransform::Identity, ". This " },
+		{ "", EWordTransform::Identity, "," },
+		{ ".", EWordTransform::Identity, " " },
+		{ "", EWordTransform::UppercaseFirst, "(" },
+		{ "", EWordTransform::UppercaseFirst, "." },
+		{ "", EWordTransform::Identity, " not " },
+		{ " ", EWordTransform::Identity, "=\"" },
+		{ "", EWordTransform::Identity, "er " },
+		{ " ", EWordTransform::UppercaseAll, " " },
+		{ "", EWordTransform::Identity, "al " },
+		{ " ", EWordTransform::UppercaseAll, "" },
+		{ "", EWordTransform::Identity, "='" },
+		{ "", EWordTransform::UppercaseAll, "\"" },
+		{ "", EWordTransform::UppercaseFirst, ". " },
+		{ " ", EWordTransform::Identity, "(" },
+		{ "", EWordTransform::Identity, "ful " },
+		{ " ", EWordTransform::UppercaseFirst, ". " },
+		{ "", EWordTransform::Identity, "ive " },
+		{ "", EWordTransform::Identity, "less " },
+		{ "", EWordTransform::UppercaseAll, "'" },
+		{ "", EWordTransform::Identity, "est " },
+		{ " ", EWordTransform::UppercaseFirst, "." },
+		{ "", EWordTransform::UppercaseAll, "\">" },
+		{ " ", EWordTransform::Identity, "='" },
+		{ "", EWordTransform::UppercaseFirst, "," },
+		{ "", EWordTransform::Identity, "ize " },
+		{ "", EWordTransform::UppercaseAll, "." },
+		{ "\xc2\xa0", EWordTransform::Identity, "" },
+		{ " ", EWordTransform::Identity, "," },
+		{ "", EWordTransform::UppercaseFirst, "=\"" },
+		{ "", EWordTransform::UppercaseAll, "=\"" },
+		{ "", EWordTransform::Identity, "ous " },
+		{ "", EWordTransform::UppercaseAll, ", " },
+		{ "", EWordTransform::UppercaseFirst, "='" },
+		{ " ", EWordTransform::UppercaseFirst, "," },
+		{ " ", EWordTransform::UppercaseAll, "=\"" },
+		{ " ", EWordTransform::UppercaseAll, ", " },
+		{ "", EWordTransform::UppercaseAll, "," },
+		{ "", EWordTransform::UppercaseAll, "(" },
+		{ "", EWordTransform::UppercaseAll, ". " },
+		{ " ", EWordTransform::UppercaseAll, "." },
+		{ "", EWordTransform::UppercaseAll, "='" },
+		{ " ", EWordTransform::UppercaseAll, ". " },
+		{ " ", EWordTransform::UppercaseFirst, "=\"" },
+		{ " ", EWordTransform::UppercaseAll, "='" },
+		{ " ", EWordTransform::UppercaseFirst, "='" },	};
+
+	/** Entry of a two level prefix code table. */
+	struct FHuffmanEntry
+	{
+		/** Bits consumed by this level. */
+		uint8 Bits;
+		/** Non-zero in a root entry whose codes continue in a second level table of this many bits. */
+		uint8 SubBits;
+		/** Decoded symbol, or the offset of the second level table from the root. */
+		uint16 Value;
+	};
+
+	/** Little-endian bit reader over the whole input. Reading past the end yields zero bits and flags an overrun. */
+	struct FBitReader
+	{
+		const uint8* Next = nullptr;
+		const uint8* End = nullptr;
+		uint64 Buffer = 0;
+		uint32 Count = 0;
+		bool bOverrun = false;
+
+		void Refill()
+		{
+			while (Count <= 56 && Next < End)
+			{
+				Buffer |= static_cast<uint64>(*Next++) << Count;
+				Count += 8;
+			}
+		}
+
+		void Skip(uint32 NumBits)
+		{
+			if (NumBits > Count)
+			{
+				bOverrun = true;
+				Buffer = 0;
+				Count = 0;
+				return;
+			}
+			Buffer >>= NumBits;
+			Count -= NumBits;
+		}
+
+		/** Read up to 24 bits. */
+		uint32 Read(uint32 NumBits)
+		{
+			if (NumBits == 0)
+			{
+				return 0;
+			}
+			Refill();
+			const uint32 Value = static_cast<uint32>(Buffer) & ((1u << NumBits) - 1);
+			Skip(NumBits);
+			return Value;
+		}
+
+		/** Skip to the next byte boundary, the skipped bits must be zero. */
+		bool AlignToByte()
+		{
+			return Read(Count & 7) == 0;
+		}
+
+		/** Copy NumBytes whole bytes, only valid on a byte boundary. Dest may be null to skip them. */
+		bool ReadBytes(uint8* Dest, int64 NumBytes)
+		{
+			while (NumBytes > 0 && Count >= 8)
+			{
+				if (Dest)
+				{
+					*Dest++ = static_cast<uint8>(Buffer);
+				}
+				Buffer >>= 8;
+				Count -= 8;
+				--NumBytes;
+			}
+			if (End - Next < NumBytes)
+			{
+				bOverrun = true;
+				return false;
+			}
+			if (Dest && NumBytes > 0)
+			{
+				FMemory::Memcpy(Dest, Next, NumBytes);
+			}
+			Next += NumBytes;
+			return true;
+		}
+
+		uint32 Decode(const FHuffmanEntry* Table)
+		{
+			Refill();
+			const FHuffmanEntry* Entry = Table + (Buffer & ((1u << RootBits) - 1));
+			if (Entry->SubBits)
+			{
+				const FHuffmanEntry* SubTable = Table + Entry->Value;
+				const uint32 SubMask = (1u << Entry->SubBits) - 1;
+				Skip(RootBits);
+				Entry = SubTable + (Buffer & SubMask);
+			}
+			Skip(Entry->Bits);
+			return Entry->Value;
+		}
+	};
+
+	/** Prefix codes, block switches and context maps of one category of a meta-block. */
+	struct FBlockCategory
+	{
+		uint32 NumTypes = 1;
+		uint32 Type = 0;
+		/** Second to last and last block type. */
+		uint32 PreviousTypes[2] = { 1, 0 };
+		/** Symbols left in the current block. */
+		uint32 Remaining = MAX_uint32;
+		int32 TypeTable = 0;
+		int32 CountTable = 0;
+	};
+
+	class FDecoder
+	{
+	public:
+		FDecoder(TArrayView<const uint8> InData, TArray<uint8>& InOut)
+			: Out(InOut)
+		{
+			Reader.Next = InData.GetData();
+			Reader.End = InData.GetData() + InData.Num();
+		}
+
+		bool Decode()
+		{
+			Out.Reset();
+			if (!ReadWindowSize())
+			{
+				return false;
+			}
+
+			bool bLast = false;
+			while (!bLast)
+			{
+				bLast = Reader.Read(1) != 0;
+				if (bLast && Reader.Read(1) != 0)
+				{
+					// Empty last meta-block
+					break;
+				}
+
+				const uint32 SizeNibbles = Reader.Read(2);
+				if (SizeNibbles == 3)
+				{
+					if (!SkipMetadata())
+					{
+						return false;
+					}
+					continue;
+				}
+
+				const uint32 NumNibbles = SizeNibbles + 4;
+				int64 MetaBlockLength = 0;
+				for (uint32 Nibble = 0; Nibble < NumNibbles; ++Nibble)
+				{
+					const uint32 Value = Reader.Read(4);
+					if (Nibble + 1 == NumNibbles && NumNibbles > 4 && Value == 0)
+					{
+						return Fail(TEXT("meta-block length has a leading zero nibble"));
+					}
+					MetaBlockLength |= static_cast<int64>(Value) << (4 * Nibble);
+				}
+				++MetaBlockLength;
+
+				const bool bUncompressed = !bLast && Reader.Read(1) != 0;
+				if (Reader.bOverrun)
+				{
+					return Fail(TEXT("stream is truncated"));
+				}
+				if (bUncompressed)
+				{
+					if (!Reader.AlignToByte())
+					{
+						return Fail(TEXT("non-zero padding before an uncompressed meta-block"));
+					}
+					if (!Reserve(MetaBlockLength) || !Reader.ReadBytes(Out.GetData() + Pos, MetaBlockLength))
+					{
+						return Fail(Error ? Error : TEXT("stream is truncated"));
+					}
+					Pos += MetaBlockLength;
+				}
+				else if (!DecodeCompressed(MetaBlockLength))
+				{
+					return false;
+				}
+			}
+
+			if (Reader.bOverrun)
+			{
+				return Fail(TEXT("stream is truncated"));
+			}
+			Out.SetNum(static_cast<int32>(Pos), EAllowShrinking::No);
+			return true;
+		}
+
+		const TCHAR* Error = nullptr;
+
+	private:
+		bool Fail(const TCHAR* Message)
+		{
+			Error = Message;
+			return false;
+		}
+
+		bool ReadWindowSize()
+		{
+			uint32 WindowBits = 16;
+			if (Reader.Read(1))
+			{
+				const uint32 Large = Reader.Read(3);
+				if (Large != 0)
+				{
+					WindowBits = 17 + Large;
+				}
+				else
+				{
+					const uint32 Small = Reader.Read(3);
+					if (Small == 1)
+					{
+						return Fail(TEXT("invalid window size"));
+					}
+					WindowBits = Small != 0 ? 8 + Small : 17;
+				}
+			}
+			MaxBackwardDistance = (int64(1) << WindowBits) - 16;
+			return true;
+		}
+
+		bool SkipMetadata()
+		{
+			if (Reader.Read(1) != 0)
+			{
+				return Fail(TEXT("reserved bit set in a metadata meta-block"));
+			}
+			const uint32 SkipBytes = Reader.Read(2);
+			int64 SkipLength = 0;
+			for (uint32 Byte = 0; Byte < SkipBytes; ++Byte)
+			{
+				const uint32 Value = Reader.Read(8);
+				if (Byte + 1 == SkipBytes && SkipBytes > 1 && Value == 0)
+				{
+					return Fail(TEXT("metadata length has a leading zero byte"));
+				}
+				SkipLength |= static_cast<int64>(Value) << (8 * Byte);
+			}
+			if (SkipBytes > 0)
+			{
+				++SkipLength;
+			}
+			if (!Reader.AlignToByte())
+			{
+				return Fail(TEXT("non-zero padding before metadata"));
+			}
+			if (!Reader.ReadBytes(nullptr, SkipLength))
+			{
+				return Fail(TEXT("stream is truncated"));
+			}
+			return true;
+		}
+
+		/** Make room for NumBytes more output bytes. */
+		bool Reserve(int64 NumBytes)
+		{
+			const int64 Needed = Pos + NumBytes;
+			if (Needed <= Out.Num())
+			{
+				return true;
+			}
+			if (Needed > MAX_int32)
+			{
+				return Fail(TEXT("decoded data exceeds the maximum buffer size"));
+			}
+			const int64 Grown = FMath::Max<int64>(FMath::Max<int64>(static_cast<int64>(Out.Num()) * 2, 4096), Needed);
+			Out.SetNumUninitialized(static_cast<int32>(FMath::Min<int64>(Grown, MAX_int32)), EAllowShrinking::No);
+			return true;
+		}
+
+		uint32 ReadVarLenUint8()
+		{
+			if (!Reader.Read(1))
+			{
+				return 0;
+			}
+			const uint32 NumBits = Reader.Read(3);
+			return NumBits == 0 ? 1 : (1u << NumBits) + Reader.Read(NumBits);
+		}
+
+		/** Append the table of the canonical prefix code with the given code lengths, returns its offset or INDEX_NONE. */
+		int32 BuildTable(const uint8* CodeLengths, int32 AlphabetSize)
+		{
+			int32 NumSymbols = 0;
+			int32 LastSymbol = 0;
+			uint32 CountByLength[16] = {};
+			for (int32 Symbol = 0; Symbol < AlphabetSize; ++Symbol)
+			{
+				if (CodeLengths[Symbol])
+				{
+					++CountByLength[CodeLengths[Symbol]];
+					++NumSymbols;
+					LastSymbol = Symbol;
+				}
+			}
+			if (NumSymbols == 0)
+			{
+				Fail(TEXT("empty prefix code"));
+				return INDEX_NONE;
+			}
+
+			const int32 Base = Tables.AddZeroed(1 << RootBits);
+			if (NumSymbols == 1)
+			{
+				// A single symbol takes no bits
+				for (int32 Index = 0; Index < (1 << RootBits); ++Index)
+				{
+					Tables[Base + Index].Value = static_cast<uint16>(LastSymbol);
+				}
+				return Base;
+			}
+
+			uint32 NextCode[16] = {};
+			uint32 Code = 0;
+			for (int32 Length = 1; Length < 16; ++Length)
+			{
+				Code = (Code + CountByLength[Length - 1]) << 1;
+				NextCode[Length] = Code;
+			}
+
+			// Codes are stored most significant bit first but read least significant bit first
+			uint16 ReversedCodes[MaxAlphabetSize];
+			uint8 SubTableBits[1 << RootBits] = {};
+			for (int32 Symbol = 0; Symbol < AlphabetSize; ++Symbol)
+			{
+				const uint32 Length = CodeLengths[Symbol];
+				if (!Length)
+				{
+					continue;
+				}
+				const uint32 Canonical = NextCode[Length]++;
+				uint32 Reversed = 0;
+				for (uint32 Bit = 0; Bit < Length; ++Bit)
+				{
+					Reversed |= ((Canonical >> Bit) & 1) << (Length - 1 - Bit);
+				}
+				ReversedCodes[Symbol] = static_cast<uint16>(Reversed);
+				if (Length > RootBits)
+				{
+					uint8& Bits = SubTableBits[Reversed & ((1u << RootBits) - 1)];
+					Bits = FMath::Max<uint8>(Bits, static_cast<uint8>(Length - RootBits));
+				}
+			}
+
+			for (uint32 Root = 0; Root < (1u << RootBits); ++Root)
+			{
+				if (SubTableBits[Root])
+				{
+					const int32 SubTable = Tables.AddZeroed(1 << SubTableBits[Root]);
+					FHuffmanEntry& Entry = Tables[Base + Root];
+					Entry.Bits = RootBits;
+					Entry.SubBits = SubTableBits[Root];
+					Entry.Value = static_cast<uint16>(SubTable - Base);
+				}
+			}
+
+			for (int32 Symbol = 0; Symbol < AlphabetSize; ++Symbol)
+			{
+				const uint32 Length = CodeLengths[Symbol];
+				if (!Length)
+				{
+					continue;
+				}
+				const uint32 Reversed = ReversedCodes[Symbol];
+				if (Length <= RootBits)
+				{
+					for (uint32 Index = Reversed; Index < (1u << RootBits); Index += 1u << Length)
+					{
+						Tables[Base + Index] = FHuffmanEntry{ static_cast<uint8>(Length), 0, static_cast<uint16>(Symbol) };
+					}
+					continue;
+				}
+				const FHuffmanEntry& RootEntry = Tables[Base + (Reversed & ((1u << RootBits) - 1))];
+				const int32 SubTable = Base + RootEntry.Value;
+				const uint32 SubLength = Length - RootBits;
+				for (uint32 Index = Reversed >> RootBits; Index < (1u << RootEntry.SubBits); Index += 1u << SubLength)
+				{
+					Tables[SubTable + Index] = FHuffmanEntry{ static_cast<uint8>(SubLength), 0, static_cast<uint16>(Symbol) };
+				}
+			}
+			return Base;
+		}
+
+		/** Read a prefix code over AlphabetSize symbols (RFC 7932 3.4, 3.5), returns its table offset or INDEX_NONE. */
+		int32 ReadPrefixCode(int32 AlphabetSize)
+		{
+			uint8 CodeLengths[MaxAlphabetSize] = {};
+			const uint32 SkipOrType = Reader.Read(2);
+			if (SkipOrType == 1)
+			{
+				// Simple prefix code of up to four symbols
+				uint32 AlphabetBits = 0;
+				while ((1 << AlphabetBits) < AlphabetSize)
+				{
+					++AlphabetBits;
+				}
+				const uint32 NumSymbols = Reader.Read(2) + 1;
+				uint32 Symbols[4];
+				for (uint32 Index = 0; Index < NumSymbols; ++Index)
+				{
+					Symbols[Index] = Reader.Read(AlphabetBits);
+					if (Symbols[Index] >= static_cast<uint32>(AlphabetSize))
+					{
+						Fail(TEXT("prefix code symbol out of range"));
+						return INDEX_NONE;
+					}
+					for (uint32 Other = 0; Other < Index; ++Other)
+					{
+						if (Symbols[Other] == Symbols[Index])
+						{
+							Fail(TEXT("duplicate symbol in a simple prefix code"));
+							return INDEX_NONE;
+						}
+					}
+				}
+				switch (NumSymbols)
+				{
+				case 1:
+					CodeLengths[Symbols[0]] = 1;
+					break;
+				case 2:
+					CodeLengths[Symbols[0]] = 1;
+					CodeLengths[Symbols[1]] = 1;
+					break;
+				case 3:
+					CodeLengths[Symbols[0]] = 1;
+					CodeLengths[Symbols[1]] = 2;
+					CodeLengths[Symbols[2]] = 2;
+					break;
+				default:
+					if (Reader.Read(1))
+					{
+						CodeLengths[Symbols[0]] = 1;
+						CodeLengths[Symbols[1]] = 2;
+						CodeLengths[Symbols[2]] = 3;
+						CodeLengths[Symbols[3]] = 3;
+					}
+					else
+					{
+						for (uint32 Index = 0; Index < 4; ++Index)
+						{
+							CodeLengths[Symbols[Index]] = 2;
+						}
+					}
+					break;
+				}
+				return BuildTable(CodeLengths, AlphabetSize);
+			}
+
+			// Complex prefix code, first the lengths of the code length code
+			uint8 CodeLengthCodeLengths[NumCodeLengthCodes] = {};
+			int32 Space = 32;
+			int32 NumCodes = 0;
+			for (int32 Index = SkipOrType; Index < NumCodeLengthCodes; ++Index)
+			{
+				Reader.Refill();
+				const uint32 Peek = static_cast<uint32>(Reader.Buffer) & 15;
+				Reader.Skip(CodeLengthPrefixBits[Peek]);
+				const uint8 Length = CodeLengthPrefixValue[Peek];
+				CodeLengthCodeLengths[CodeLengthCodeOrder[Index]] = Length;
+				if (Length)
+				{
+					Space -= 32 >> Length;
+					++NumCodes;
+					if (Space <= 0)
+					{
+						break;
+					}
+				}
+			}
+			if (!(NumCodes == 1 || Space == 0))
+			{
+				Fail(TEXT("invalid code length code"));
+				return INDEX_NONE;
+			}
+
+			const int32 CodeLengthTable = BuildTable(CodeLengthCodeLengths, NumCodeLengthCodes);
+			if (CodeLengthTable == INDEX_NONE)
+			{
+				return INDEX_NONE;
+			}
+
+			// Then the symbol code lengths, 16 repeats the previous non-zero length and 17 repeats zero
+			uint8 PreviousLength = 8;
+			uint8 RepeatLength = 0;
+			uint32 Repeat = 0;
+			int32 Symbol = 0;
+			Space = 32768;
+			while (Symbol < AlphabetSize && Space > 0)
+			{
+				const uint32 Code = Reader.Decode(Tables.GetData() + CodeLengthTable);
+				if (Reader.bOverrun)
+				{
+					break;
+				}
+				if (Code < 16)
+				{
+					Repeat = 0;
+					CodeLengths[Symbol++] = static_cast<uint8>(Code);
+					if (Code)
+					{
+						PreviousLength = static_cast<uint8>(Code);
+						Space -= 32768 >> Code;
+					}
+					continue;
+				}
+
+				const uint32 ExtraBits = Code == 16 ? 2 : 3;
+				const uint8 NewLength = Code == 16 ? PreviousLength : 0;
+				if (RepeatLength != NewLength)
+				{
+					Repeat = 0;
+					RepeatLength = NewLength;
+				}
+				const uint32 OldRepeat = Repeat;
+				if (Repeat > 0)
+				{
+					Repeat = (Repeat - 2) << ExtraBits;
+				}
+				Repeat += Reader.Read(ExtraBits) + 3;
+				const uint32 Delta = Repeat - OldRepeat;
+				if (Symbol + Delta > static_cast<uint32>(AlphabetSize))
+				{
+					Fail(TEXT("code length repeat past the alphabet"));
+					return INDEX_NONE;
+				}
+				for (uint32 Index = 0; Index < Delta; ++Index)
+				{
+					CodeLengths[Symbol++] = RepeatLength;
+				}
+				if (RepeatLength)
+				{
+					Space -= static_cast<int32>(Delta << (15 - RepeatLength));
+				}
+			}
+			// The code length table is no longer needed
+			Tables.SetNum(CodeLengthTable, EAllowShrinking::No);
+			if (Space != 0)
+			{
+				Fail(Reader.bOverrun ? TEXT("stream is truncated") : TEXT("incomplete prefix code"));
+				return INDEX_NONE;
+			}
+			return BuildTable(CodeLengths, AlphabetSize);
+		}
+
+		uint32 ReadBlockCount(int32 CountTable)
+		{
+			const uint32 Code = Reader.Decode(Tables.GetData() + CountTable);
+			return BlockCountBase[Code] + Reader.Read(BlockCountExtra[Code]);
+		}
+
+		bool ReadBlockCategory(FBlockCategory& Category)
+		{
+			Category = FBlockCategory();
+			Category.NumTypes = ReadVarLenUint8() + 1;
+			if (Category.NumTypes < 2)
+			{
+				return true;
+			}
+			Category.TypeTable = ReadPrefixCode(Category.NumTypes + 2);
+			Category.CountTable = Category.TypeTable != INDEX_NONE ? ReadPrefixCode(26) : INDEX_NONE;
+			if (Category.CountTable == INDEX_NONE)
+			{
+				return false;
+			}
+			Category.Remaining = ReadBlockCount(Category.CountTable);
+			return true;
+		}
+
+		void SwitchBlock(FBlockCategory& Category)
+		{
+			const uint32 Code = Reader.Decode(Tables.GetData() + Category.TypeTable);
+			uint32 Type = Code == 0 ? Category.PreviousTypes[0] : Code == 1 ? Category.PreviousTypes[1] + 1 : Code - 2;
+			if (Type >= Category.NumTypes)
+			{
+				Type -= Category.NumTypes;
+			}
+			Category.PreviousTypes[0] = Category.PreviousTypes[1];
+			Category.PreviousTypes[1] = Type;
+			Category.Type = Type;
+			Category.Remaining = ReadBlockCount(Category.CountTable);
+		}
+
+		/** Read a context map (RFC 7932 7.3) of Size entries over NumTrees prefix codes. */
+		bool ReadContextMap(int32 Size, uint32 NumTrees, TArray<uint8>& Map)
+		{
+			Map.Reset();
+			Map.SetNumZeroed(Size);
+			if (NumTrees < 2)
+			{
+				return true;
+			}
+
+			const uint32 MaxRunLengthPrefix = Reader.Read(1) ? Reader.Read(4) + 1 : 0;
+			const int32 Table = ReadPrefixCode(NumTrees + MaxRunLengthPrefix);
+			if (Table == INDEX_NONE)
+			{
+				return false;
+			}
+			for (int32 Index = 0; Index < Size;)
+			{
+				const uint32 Code = Reader.Decode(Tables.GetData() + Table);
+				if (Code == 0)
+				{
+					Map[Index++] = 0;
+				}
+				else if (Code <= MaxRunLengthPrefix)
+				{
+					const uint32 RunLength = (1u << Code) + Reader.Read(Code);
+					if (Index + static_cast<int64>(RunLength) > Size)
+					{
+						return Fail(TEXT("context map run past its end"));
+					}
+					Index += RunLength;
+				}
+				else
+				{
+					Map[Index++] = static_cast<uint8>(Code - MaxRunLengthPrefix);
+				}
+				if (Reader.bOverrun)
+				{
+					return Fail(TEXT("stream is truncated"));
+				}
+			}
+			Tables.SetNum(Table, EAllowShrinking::No);
+
+			if (Reader.Read(1))
+			{
+				// Inverse move-to-front transform
+				uint8 MoveToFront[256];
+				for (int32 Index = 0; Index < 256; ++Index)
+				{
+					MoveToFront[Index] = static_cast<uint8>(Index);
+				}
+				for (uint8& Value : Map)
+				{
+					const uint8 Position = Value;
+					Value = MoveToFront[Position];
+					FMemory::Memmove(MoveToFront + 1, MoveToFront, Position);
+					MoveToFront[0] = Value;
+				}
+			}
+			return true;
+		}
+
+		/** Append a transformed dictionary word, returns its length or INDEX_NONE. */
+		int32 WriteDictionaryWord(int32 Length, int64 WordId, int64 MetaBlockLeft)
+		{
+			const uint32 SizeBits = Length <= 24 ? DictionarySizeBits[Length] : 0;
+			if (SizeBits == 0)
+			{
+				Fail(TEXT("dictionary reference with an invalid length"));
+				return INDEX_NONE;
+			}
+			const int64 WordIndex = WordId & ((int64(1) << SizeBits) - 1);
+			const int64 TransformIndex = WordId >> SizeBits;
+			if (TransformIndex >= NumWordTransforms)
+			{
+				Fail(TEXT("dictionary reference with an invalid transform"));
+				return INDEX_NONE;
+			}
+			const uint8* Word = BrotliDictionaryData + DictionaryOffsets[Length] + WordIndex * Length;
+			const FWordTransform& Transform = WordTransforms[TransformIndex];
+			const uint32 TransformType = static_cast<uint32>(Transform.Type);
+
+			uint8 Transformed[64];
+			int32 Written = 0;
+			for (const char* Prefix = Transform.Prefix; *Prefix; ++Prefix)
+			{
+				Transformed[Written++] = static_cast<uint8>(*Prefix);
+			}
+
+			int32 WordLength = Length;
+			if (TransformType >= static_cast<uint32>(EWordTransform::OmitFirst1))
+			{
+				const int32 Omit = FMath::Min<int32>(TransformType - static_cast<uint32>(EWordTransform::OmitFirst1) + 1, WordLength);
+				Word += Omit;
+				WordLength -= Omit;
+			}
+			else if (TransformType <= static_cast<uint32>(EWordTransform::OmitLast9))
+			{
+				WordLength = FMath::Max<int32>(WordLength - static_cast<int32>(TransformType), 0);
+			}
+			uint8* WordStart = Transformed + Written;
+			FMemory::Memcpy(WordStart, Word, WordLength);
+			Written += WordLength;
+
+			if (Transform.Type == EWordTransform::UppercaseFirst)
+			{
+				UppercaseCharacter(WordStart, WordLength);
+			}
+			else if (Transform.Type == EWordTransform::UppercaseAll)
+			{
+				for (int32 Offset = 0; Offset < WordLength;)
+				{
+					Offset += UppercaseCharacter(WordStart + Offset, WordLength - Offset);
+				}
+			}
+
+			for (const char* Suffix = Transform.Suffix; *Suffix; ++Suffix)
+			{
+				Transformed[Written++] = static_cast<uint8>(*Suffix);
+			}
+
+			if (Written > MetaBlockLeft)
+			{
+				Fail(TEXT("dictionary word past the end of the meta-block"));
+				return INDEX_NONE;
+			}
+			if (!Reserve(Written))
+			{
+				return INDEX_NONE;
+			}
+			FMemory::Memcpy(Out.GetData() + Pos, Transformed, Written);
+			Pos += Written;
+			return Written;
+		}
+
+		/** RFC 7932 uppercase step on one UTF-8 character, returns the number of bytes it covers. */
+		static int32 UppercaseCharacter(uint8* Character, int32 Left)
+		{
+			if (Character[0] < 0xC0)
+			{
+				if (Character[0] >= 'a' && Character[0] <= 'z')
+				{
+					Character[0] ^= 32;
+				}
+				return 1;
+			}
+			if (Character[0] < 0xE0)
+			{
+				if (Left > 1)
+				{
+					Character[1] ^= 32;
+				}
+				return 2;
+			}
+			if (Left > 2)
+			{
+				Character[2] ^= 5;
+			}
+			return 3;
+		}
+
+		bool DecodeCompressed(int64 MetaBlockLeft)
+		{
+			Tables.Reset();
+			FBlockCategory Literals, Commands, Distances;
+			if (!ReadBlockCategory(Literals) || !ReadBlockCategory(Commands) || !ReadBlockCategory(Distances))
+			{
+				return false;
+			}
+
+			const uint32 Postfix = Reader.Read(2);
+			const uint32 NumDirect = Reader.Read(4) << Postfix;
+			const uint32 PostfixMask = (1u << Postfix) - 1;
+
+			ContextModes.SetNumUninitialized(Literals.NumTypes);
+			for (uint8& Mode : ContextModes)
+			{
+				Mode = static_cast<uint8>(Reader.Read(2));
+			}
+
+			const uint32 NumLiteralTrees = ReadVarLenUint8() + 1;
+			if (!ReadContextMap(Literals.NumTypes << 6, NumLiteralTrees, LiteralContextMap))
+			{
+				return false;
+			}
+			const uint32 NumDistanceTrees = ReadVarLenUint8() + 1;
+			if (!ReadContextMap(Distances.NumTypes << 2, NumDistanceTrees, DistanceContextMap))
+			{
+				return false;
+			}
+
+			LiteralTrees.Reset();
+			CommandTrees.Reset();
+			DistanceTrees.Reset();
+			for (uint32 Index = 0; Index < NumLiteralTrees; ++Index)
+			{
+				LiteralTrees.Add(ReadPrefixCode(256));
+			}
+			for (uint32 Index = 0; Index < Commands.NumTypes; ++Index)
+			{
+				CommandTrees.Add(ReadPrefixCode(704));
+			}
+			const int32 DistanceAlphabetSize = 16 + NumDirect + (48 << Postfix);
+			for (uint32 Index = 0; Index < NumDistanceTrees; ++Index)
+			{
+				DistanceTrees.Add(ReadPrefixCode(DistanceAlphabetSize));
+			}
+			if (Error || LiteralTrees.Contains(INDEX_NONE) || CommandTrees.Contains(INDEX_NONE) || DistanceTrees.Contains(INDEX_NONE))
+			{
+				return Fail(Error ? Error : TEXT("invalid prefix code"));
+			}
+			if (Reader.bOverrun)
+			{
+				return Fail(TEXT("stream is truncated"));
+			}
+
+			const FHuffmanEntry* TableData = Tables.GetData();
+			while (MetaBlockLeft > 0)
+			{
+				if (Commands.Remaining == 0)
+				{
+					SwitchBlock(Commands);
+				}
+				--Commands.Remaining;
+				const uint32 Command = Reader.Decode(TableData + CommandTrees[Commands.Type]);
+				const uint32 Cell = Command >> 6;
+				const uint32 InsertCode = CommandInsertBase[Cell] + ((Command >> 3) & 7);
+				const uint32 CopyCode = CommandCopyBase[Cell] + (Command & 7);
+				const int64 InsertLength = InsertLengthBase[InsertCode] + Reader.Read(InsertLengthExtra[InsertCode]);
+				const int64 CopyLength = CopyLengthBase[CopyCode] + Reader.Read(CopyLengthExtra[CopyCode]);
+
+				if (InsertLength > MetaBlockLeft)
+				{
+					return Fail(TEXT("insert past the end of the meta-block"));
+				}
+				if (!Reserve(InsertLength))
+				{
+					return false;
+				}
+				uint8* Output = Out.GetData();
+				for (int64 Index = 0; Index < InsertLength; ++Index)
+				{
+					if (Literals.Remaining == 0)
+					{
+						SwitchBlock(Literals);
+					}
+					--Literals.Remaining;
+					const uint8 Last = Pos > 0 ? Output[Pos - 1] : 0;
+					const uint8 BeforeLast = Pos > 1 ? Output[Pos - 2] : 0;
+					uint32 Context = 0;
+					switch (static_cast<EContextMode>(ContextModes[Literals.Type]))
+					{
+					case EContextMode::LSB6: Context = Last & 0x3F; break;
+					case EContextMode::MSB6: Context = Last >> 2; break;
+					case EContextMode::UTF8: Context = ContextLut0[Last] | ContextLut1[BeforeLast]; break;
+					default: Context = (ContextLut2[Last] << 3) | ContextLut2[BeforeLast]; break;
+					}
+					const int32 Tree = LiteralTrees[LiteralContextMap[(Literals.Type << 6) + Context]];
+					Output[Pos++] = static_cast<uint8>(Reader.Decode(TableData + Tree));
+				}
+				MetaBlockLeft -= InsertLength;
+				if (Reader.bOverrun)
+				{
+					return Fail(TEXT("stream is truncated"));
+				}
+				if (MetaBlockLeft <= 0)
+				{
+					// The copy of the last command is ignored when the inserts complete the meta-block
+					break;
+				}
+
+				// Cells 0 and 1 reuse the last distance without reading a distance code
+				uint32 DistanceCode = 0;
+				if (Cell >= 2)
+				{
+					if (Distances.Remaining == 0)
+					{
+						SwitchBlock(Distances);
+					}
+					--Distances.Remaining;
+					const uint32 DistanceContext = CopyLength > 4 ? 3 : static_cast<uint32>(CopyLength - 2);
+					const int32 Tree = DistanceTrees[DistanceContextMap[(Distances.Type << 2) + DistanceContext]];
+					DistanceCode = Reader.Decode(TableData + Tree);
+				}
+
+				int64 Distance = 0;
+				if (DistanceCode < 16)
+				{
+					Distance = LastDistances[(NextDistance - 1 - ShortDistanceIndex[DistanceCode]) & 3] + ShortDistanceDelta[DistanceCode];
+					if (Distance <= 0)
+					{
+						return Fail(TEXT("invalid distance"));
+					}
+				}
+				else if (DistanceCode < 16 + NumDirect)
+				{
+					Distance = DistanceCode - 15;
+				}
+				else
+				{
+					const uint32 Code = DistanceCode - NumDirect - 16;
+					const uint32 NumExtraBits = 1 + (Code >> (Postfix + 1));
+					const int64 Offset = ((2 + ((Code >> Postfix) & 1)) << NumExtraBits) - 4;
+					Distance = ((Offset + Reader.Read(NumExtraBits)) << Postfix) + (Code & PostfixMask) + NumDirect + 1;
+				}
+
+				const int64 MaxDistance = FMath::Min(Pos, MaxBackwardDistance);
+				if (Distance > MaxDistance)
+				{
+					// Past the output, a reference into the static dictionary
+					const int32 Written = WriteDictionaryWord(static_cast<int32>(CopyLength), Distance - MaxDistance - 1, MetaBlockLeft);
+					if (Written == INDEX_NONE)
+					{
+						return false;
+					}
+					MetaBlockLeft -= Written;
+					continue;
+				}
+
+				if (CopyLength > MetaBlockLeft)
+				{
+					return Fail(TEXT("copy past the end of the meta-block"));
+				}
+				if (!Reserve(CopyLength))
+				{
+					return false;
+				}
+				Output = Out.GetData();
+				const uint8* Source = Output + Pos - Distance;
+				uint8* Dest = Output + Pos;
+				if (Distance >= CopyLength)
+				{
+					FMemory::Memcpy(Dest, Source, CopyLength);
+				}
+				else
+				{
+					// Overlapping copy repeats the last Distance bytes
+					for (int64 Index = 0; Index < CopyLength; ++Index)
+					{
+						Dest[Index] = Source[Index];
+					}
+				}
+				Pos += CopyLength;
+				MetaBlockLeft -= CopyLength;
+				if (DistanceCode != 0)
+				{
+					LastDistances[NextDistance++ & 3] = Distance;
+				}
+			}
+
+			if (Reader.bOverrun)
+			{
+				return Fail(TEXT("stream is truncated"));
+			}
+			return true;
+		}
+
+		FBitReader Reader;
+		TArray<uint8>& Out;
+		int64 Pos = 0;
+		int64 MaxBackwardDistance = 0;
+
+		/** Ring of the last four distances, kept across meta-blocks. */
+		int64 LastDistances[4] = { 16, 15, 11, 4 };
+		uint32 NextDistance = 0;
+
+		/** Prefix code tables of the current meta-block and the offsets of its trees. */
+		TArray<FHuffmanEntry> Tables;
+		TArray<int32> LiteralTrees;
+		TArray<int32> CommandTrees;
+		TArray<int32> DistanceTrees;
+		TArray<uint8> ContextModes;
+		TArray<uint8> LiteralContextMap;
+		TArray<uint8> DistanceContextMap;
+	};
+}
+
+namespace UE::SpacetimeDB::Compression
+{
+	bool DecodeBrotli(TArrayView<const uint8> InData, TArray<uint8>& OutData, const TCHAR*& OutError)
+	{
+		BrotliPrivate::FDecoder Decoder(InData, OutData);
+		if (!Decoder.Decode())
+		{
+			OutError = Decoder.Error ? Decoder.Error : TEXT("stream is truncated");
+			OutData.Reset();
+			return false;
+		}
+		OutError = nullptr;
+		return true;
+	}
+}
@@ -13,12 +13,60 @@
 #include "Misc/ScopeLock.h"
 #include "Async/Async.h"
 #include "BSATN/UEBSATNHelpers.h"
+#include "Connection/PayloadDecompression.h"
+
+namespace
+{
+	/** The database update carried by a server message, null for messages without one. */
+	const FDatabaseUpdateType* FindDatabaseUpdate(const FServerMessageType& Message)
+	{
+		switch (Message.Tag)
+		{
+		case EServerMessageTag::InitialSubscription:
+			return &Message.GetAsInitialSubscription().DatabaseUpdate;
+		case EServerMessageTag::TransactionUpdate:
+		{
+			const FUpdateStatusType& Status = Message.GetAsTransactionUpdate().Status;
+			return Status.IsCommitted() ? &Status.GetAsCommitted() : nullptr;
+		}
+		case EServerMessageTag::TransactionUpdateLight:
+			return &Message.GetAsTransactionUpdateLight().Update;
+		case EServerMessageTag::SubscribeMultiApplied:
+			return &Message.GetAsSubscribeMultiApplied().Update;
+		case EServerMessageTag::UnsubscribeMultiApplied:
+			return &Message.GetAsUnsubscribeMultiApplied().Update;
+		default:
+			return nullptr;
+		}
+	}
+}
 
 UDbConnectionBase::UDbConnectionBase(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
 	NextRequestId = 1;
 	NextSubscriptionId = 1;
+	DeserializersById = MakeUnique<std::atomic<UE::SpacetimeDB::ITableRowDeserializer*>[]>(MaxIndexedTableId);
+}
+
+void UDbConnectionBase::BeginDestroy()
+{
+	// Join the decode workers and the apply thread before the connection goes away, in-flight jobs still reference it
+	ReleaseRing.Close();
+	if (ApplyThread)
+	{
+		// Joined first since it applies to the tables, freed last since decode jobs still notify it
+		ApplyThread->Shutdown();
+	}
+	if (DecodePool)
+	{
+		DecodePool->Shutdown();
+		DecodePool.Reset();
+	}
+	ApplyThread.Reset();
+	DeferredFrames.Empty();
+	NumDeferredFrames = 0;
+	Super::BeginDestroy();
 }
 
 void UDbConnectionBase::Disconnect()
@@ -52,12 +100,22 @@ FSpacetimeDBConnectionId UDbConnectionBase::GetConnectionId() const
 	return ConnectionId;
 }
 
+TArray<FDecodeWorkerStats> UDbConnectionBase::GetDecodeWorkerStats() const
+{
+	return DecodePool ? DecodePool->GetWorkerStats() : TArray<FDecodeWorkerStats>();
+}
+
+int32 UDbConnectionBase::GetDecodeQueueDepth() const
+{
+	return (DecodePool ? DecodePool->GetQueueDepth() : 0) + NumDeferredFrames;
+}
+
 bool UDbConnectionBase::SendRawMessage(const FString& Message)
 {
 	return WebSocket && WebSocket->SendMessage(Message);
 }
 
-bool UDbConnectionBase::SendRawMessage(const TArray<uint8>& Message)
+bool UDbConnectionBase::SendRawMessage(TArrayView<const uint8> Message)
 {
 	return WebSocket && WebSocket->SendMessage(Message);
 }
@@ -85,66 +143,166 @@ void UDbConnectionBase::HandleWSClosed(int32 /*StatusCode*/, const FString& Reas
 
 void UDbConnectionBase::HandleWSBinaryMessage(const TArray<uint8>& Message)
 {
-	//tag for arrival order
-	const int32 Id = NextPreprocessId.GetValue();
-	NextPreprocessId.Increment();
+	// Legacy entry point, the dynamic delegate already handed us a copy
+	HandleWSBinaryFrame(MakeShared<TArray<uint8>, ESPMode::ThreadSafe>(Message));
+}
+
+void UDbConnectionBase::HandleWSBinaryFrame(const FWebsocketFrameBuffer& Frame)
+{
+	PendingReceiveTimes.Enqueue(FPlatformTime::Seconds());
+
+	if (bUseApplyThread && !ApplyThread)
+	{
+		// Before the first job is queued, so the apply thread sees every message
+		StartApplyThread();
+	}
 
-	//do expensive work off-thread
+	if (!DecodePool)
+	{
+		const int32 NumWorkers = DecodeWorkerCount > 0 ? DecodeWorkerCount : FDecodeWorkerPool::GetDefaultNumWorkers();
+		DecodePool = MakeUnique<FDecodeWorkerPool>(NumWorkers, DecodeQueueCapacity);
+	}
+
+	//queue behind any held back frame so arrival order is kept
+	DeferredFrames.Enqueue(Frame);
+	++NumDeferredFrames;
+	DispatchDeferredFrames();
+}
+
+void UDbConnectionBase::DispatchDeferredFrames()
+{
 	TWeakObjectPtr<UDbConnectionBase> WeakThis(this);
-	Async(EAsyncExecution::Thread, [WeakThis, Message, Id]()
+	while (const FWebsocketFrameBuffer* Frame = DeferredFrames.Peek())
 	{
-		if (!WeakThis.IsValid())
+		//a message more than a lap ahead of the last released one would find its ring slot still held
+		if (NextPreprocessId - NumReleasedMessages >= ReleaseRingCapacity)
 		{
-			return;
+			break;
 		}
-		UDbConnectionBase* This = WeakThis.Get();
 
-		//parse the message, decompress if needed
-		FServerMessageType Parsed = This->PreProcessMessage(Message);
-
-		//queue: re-order buffer
-		TArray<FServerMessageType> Ready;
+		//do expensive work off-thread, the job holds a reference to the frame rather than a copy
+		const uint64 Id = NextPreprocessId;
+		if (!DecodePool || !DecodePool->TryEnqueue([WeakThis, Message = *Frame, Id]()
 		{
-			FScopeLock Lock(&This->PreprocessMutex);
-			// Move the parsed message into the map to avoid copying
-			This->PreprocessedMessages.Add(Id, MoveTemp(Parsed));
-			//check if we can release any messages in order
-			while (This->PreprocessedMessages.Contains(This->NextReleaseId))
+			if (!WeakThis.IsValid())
 			{
-				Ready.Add(This->PreprocessedMessages.FindAndRemoveChecked(This->NextReleaseId));
-				++This->NextReleaseId;
+				return;
 			}
-		}
-		//if we have any ready messages, append them to the pending messages list that is processed in Tick
-		if (Ready.Num() > 0)
+			UDbConnectionBase* This = WeakThis.Get();
+
+			//parse the message, decompress if needed
+			FParsedServerMessage Parsed = This->PreProcessMessage(Message);
+
+			//publish into the slot for this id, FrameTick or the apply thread releases it once every earlier id is in
+			if (!This->ReleaseRing.Publish(Id, MoveTemp(Parsed)))
+			{
+				// Ids are dispatched less than a lap ahead of the consumer, so only a closed ring refuses them
+				ensureMsgf(This->ReleaseRing.IsClosed(), TEXT("Release slot of message %llu is still held"), Id);
+				return;
+			}
+			if (This->ApplyThread)
+			{
+				This->ApplyThread->Notify();
+			}
+		}))
 		{
-			FScopeLock Lock(&This->PendingMessagesMutex);
-			This->PendingMessages.Append(MoveTemp(Ready));
+			//decode queue is full, FrameTick retries once workers caught up
+			break;
 		}
+
+		++NextPreprocessId;
+		DeferredFrames.Pop();
+		--NumDeferredFrames;
+	}
+}
+
+void UDbConnectionBase::StartApplyThread()
+{
+	ApplyThread = MakeUnique<TCacheApplyThread<FParsedServerMessage>>(ReleaseRing, [this](FParsedServerMessage& Parsed)
+	{
+		ApplyMessageToCaches(Parsed);
+	}, MaxAppliedAhead);
+	if (!ApplyThread->IsRunning())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("StartApplyThread: Apply thread could not be started, applying table updates on the game thread"));
+		ApplyThread.Reset();
+		bUseApplyThread = false;
+		return;
+	}
+
+	// Nothing has been queued yet, the thread cannot touch a cache before it is handed over
+	FScopeLock Lock(&RegisteredTablesMutex);
+	for (const TPair<FString, TSharedPtr<ITableUpdateHandler>>& Pair : RegisteredTables)
+	{
+		Pair.Value->TakeCacheOwnership();
+	}
+}
+
+void UDbConnectionBase::ApplyMessageToCaches(FParsedServerMessage& Parsed)
+{
+	Parsed.bCacheApplied = true;
+
+	// ProcessServerMessage ignores the update of the legacy InitialSubscription, so the caches must too
+	const FDatabaseUpdateType* Update = Parsed.Message.Tag != EServerMessageTag::InitialSubscription ? FindDatabaseUpdate(Parsed.Message) : nullptr;
+	if (!Update)
+	{
+		return;
+	}
+
+	const TArray<TSharedPtr<UE::SpacetimeDB::FPreprocessedTableDataBase>>* TableData = Parsed.TableData.Num() == Update->Tables.Num() ? &Parsed.TableData : nullptr;
+	FResolvedTableUpdates Resolved;
+	ResolveTableUpdates(*Update, TableData, Resolved);
+
+	Parsed.AppliedTables.SetNum(Resolved.Handlers.Num());
+	UE::SpacetimeDB::ApplyTableUpdates(Resolved.RowCounts, Resolved.bDistinctTables ? ParallelApplyMinRows.load(std::memory_order_relaxed) : 0, [&](int32 Index)
+	{
+		const int32 TableIndex = Resolved.TableIndices[Index];
+		Parsed.AppliedTables[Index] = Resolved.Handlers[Index]->ApplyToCache(Update->Tables[TableIndex], TableData ? (*TableData)[TableIndex] : nullptr);
 	});
 }
 
 void UDbConnectionBase::FrameTick()
 {
-	TArray<FServerMessageType> Local;
+	const double StartTime = FPlatformTime::Seconds();
+	const double Budget = FrameBudgetMs > 0.0f ? FrameBudgetMs / 1000.0 : 0.0;
+
+	//send coalesced reducer calls first so input is not held back by a slow apply
+	OutgoingScheduler.Tick(StartTime, [this](const FString& Reducer, UE::SpacetimeDB::FReducerArgsWriter WriteArgs, USetReducerFlagsBase* Flags)
 	{
-		FScopeLock Lock(&PendingMessagesMutex);
-		if (PendingMessages.Num() == 0)
-		{
-			//nothing to process, return early
-			return;
-		}
-		//move pending messages to local array for processing
-		Local = MoveTemp(PendingMessages);
-		PendingMessages.Empty();
-	}
+		InternalCallReducer(Reducer, WriteArgs, Flags);
+	});
 
-	//process all messages in the local array
-	for (const FServerMessageType& Msg : Local)
+	//process messages in arrival order until we reach one that is still being decoded, or applied by the apply thread
+	FParsedServerMessage Msg;
+	while (ApplyThread ? ApplyThread->TryDequeue(Msg) : ReleaseRing.TryDequeue(Msg))
 	{
+		++NumReleasedMessages;
+		PendingReceiveTimes.Pop();
+
 		//process the message, this will call DbUpdate or trigger subscription events as needed
 		ProcessServerMessage(Msg);
+
+		//messages are applied whole, so the budget is only checked between them
+		if (Budget > 0.0 && FPlatformTime::Seconds() - StartTime >= Budget)
+		{
+			UE_LOG(LogTemp, VeryVerbose, TEXT("FrameTick: Budget of %.2f ms used, carrying over %d messages"), FrameBudgetMs, GetPendingMessageCount());
+			break;
+		}
 	}
+
+	//released messages and decoded jobs made room for frames held back by the socket callback
+	DispatchDeferredFrames();
+}
+
+int32 UDbConnectionBase::GetPendingMessageCount() const
+{
+	return static_cast<int32>(NextPreprocessId - NumReleasedMessages) + NumDeferredFrames;
+}
+
+float UDbConnectionBase::GetOldestPendingMessageAgeMs() const
+{
+	const double* Oldest = PendingReceiveTimes.Peek();
+	return Oldest ? static_cast<float>((FPlatformTime::Seconds() - *Oldest) * 1000.0) : 0.0f;
 }
 void UDbConnectionBase::Tick(float DeltaTime)
 {
@@ -171,8 +329,11 @@ bool UDbConnectionBase::IsTickableInEditor() const
 }
 
 
-void UDbConnectionBase::ProcessServerMessage(const FServerMessageType& Message)
+void UDbConnectionBase::ProcessServerMessage(const FParsedServerMessage& Parsed)
 {
+	// DbUpdate is handed the update inside this message, ApplyRegisteredTableUpdates pairs it with the preprocessed rows
+	TGuardValue<const FParsedServerMessage*> ApplyingGuard(ApplyingMessage, &Parsed);
+	const FServerMessageType& Message = Parsed.Message;
 	bool bIsValid = false;
 	switch (Message.Tag)
 	{
@@ -184,7 +345,7 @@ void UDbConnectionBase::ProcessServerMessage(const FServerMessageType& Message)
 	case EServerMessageTag::TransactionUpdate:
 	{
 		// Process a transaction update message
-		const FTransactionUpdateType Payload = Message.GetAsTransactionUpdate();
+		const FTransactionUpdateType& Payload = Message.GetAsTransactionUpdate();
 
 		// Create a status object based on the transaction status
 		FSpacetimeDBStatus StatusObj;
@@ -216,6 +377,9 @@ void UDbConnectionBase::ProcessServerMessage(const FServerMessageType& Message)
 		RedEvent.EnergyConsumed = Payload.EnergyQuantaUsed;
 		RedEvent.ReducerCall = Payload.ReducerCall;
 
+		// Decode the reducer arguments once for both the table update and the reducer callbacks
+		BeginReducerEvent(RedEvent);
+
 		// If the status is committed, we update the database
 		if (bSuccess)
 		{
@@ -227,12 +391,14 @@ void UDbConnectionBase::ProcessServerMessage(const FServerMessageType& Message)
 			ReducerEvent(RedEvent); // Trigger the reducer event
 			ReducerEventFailed(RedEvent, ErrorMessage);
 		}
+
+		EndReducerEvent();
 		break;
 	}
 	case EServerMessageTag::TransactionUpdateLight:
 	{
 		// Process a light transaction update message
-		const FTransactionUpdateLightType Payload = Message.GetAsTransactionUpdateLight();
+		const FTransactionUpdateLightType& Payload = Message.GetAsTransactionUpdateLight();
 
 		//@TODO: Implement light update fully
 		DbUpdate(Payload.Update, FSpacetimeDBEvent::UnknownTransaction(FSpacetimeDBUnit()));
@@ -242,7 +408,7 @@ void UDbConnectionBase::ProcessServerMessage(const FServerMessageType& Message)
 	case EServerMessageTag::IdentityToken:
 	{
 		// Process an identity token message
-		const FIdentityTokenType Payload = Message.GetAsIdentityToken();
+		const FIdentityTokenType& Payload = Message.GetAsIdentityToken();
 
 		Token = Payload.Token;
 		UCredentials::SaveToken(Token);
@@ -274,7 +440,7 @@ void UDbConnectionBase::ProcessServerMessage(const FServerMessageType& Message)
 	case EServerMessageTag::SubscriptionError:
 	{
 		// Process a subscription error message
-		const FSubscriptionErrorType Payload = Message.GetAsSubscriptionError();
+		const FSubscriptionErrorType& Payload = Message.GetAsSubscriptionError();
 		if (TObjectPtr<USubscriptionHandleBase> Handle = *ActiveSubscriptions.Find(Payload.QueryId.Value))
 		{
 			if (!Handle)
@@ -293,7 +459,7 @@ void UDbConnectionBase::ProcessServerMessage(const FServerMessageType& Message)
 	case EServerMessageTag::SubscribeMultiApplied:
 	{
 		// Process a multi-subscription applied message
-		const FSubscribeMultiAppliedType Payload = Message.GetAsSubscribeMultiApplied();
+		const FSubscribeMultiAppliedType& Payload = Message.GetAsSubscribeMultiApplied();
 		// Update the database with the subscription applied event
 		DbUpdate(Payload.Update, FSpacetimeDBEvent::SubscribeApplied(FSpacetimeDBUnit()));
 
@@ -313,7 +479,7 @@ void UDbConnectionBase::ProcessServerMessage(const FServerMessageType& Message)
 	case EServerMessageTag::UnsubscribeMultiApplied:
 	{
 		// Process a multi-unsubscription applied message
-		const FUnsubscribeMultiAppliedType Payload = Message.GetAsUnsubscribeMultiApplied();
+		const FUnsubscribeMultiAppliedType& Payload = Message.GetAsUnsubscribeMultiApplied();
 
 		// Update the database with the unsubscription applied event
 		DbUpdate(Payload.Update, FSpacetimeDBEvent::UnsubscribeApplied(FSpacetimeDBUnit()));
@@ -343,88 +509,67 @@ void UDbConnectionBase::ProcessServerMessage(const FServerMessageType& Message)
 	}
 }
 
-bool UDbConnectionBase::DecompressBrotli(const TArray<uint8>& InData, TArray<uint8>& OutData)
+bool UDbConnectionBase::DecompressBrotli(TArrayView<const uint8> InData, TArray<uint8>& OutData)
 {
-	UE_LOG(LogTemp, Error, TEXT("Brotli decompression unavilable"));
-	return false;
+	return UE::SpacetimeDB::Compression::DecompressBrotli(InData, OutData);
 }
 
-bool UDbConnectionBase::DecompressGzip(const TArray<uint8>& InData, TArray<uint8>& OutData)
+bool UDbConnectionBase::DecompressGzip(TArrayView<const uint8> InData, TArray<uint8>& OutData)
 {
-	if (InData.Num() < 4)
-	{
-		UE_LOG(LogTemp, Error, TEXT("Gzip data too small"));
-		return false;
-	}
-
-	// Gzip data ends with 4 bytes indicating the uncompressed size
-	const uint8* SizePtr = InData.GetData() + InData.Num() - 4;
-	uint32 OutSize = SizePtr[0] | (SizePtr[1] << 8) | (SizePtr[2] << 16) | (SizePtr[3] << 24);
-
-	// Validate the output size
-	OutData.SetNumUninitialized(OutSize);
-	// Attempt to decompress the Gzip data
-	if (!FCompression::UncompressMemory(NAME_Gzip, OutData.GetData(), OutSize, InData.GetData(), InData.Num()))
-	{
-		UE_LOG(LogTemp, Error, TEXT("Gzip decompression failed"));
-		return false;
-	}
-
-	OutData.SetNum(OutSize);
-	return true;
+	return UE::SpacetimeDB::Compression::DecompressGzip(InData, OutData);
 }
 
-bool UDbConnectionBase::DecompressPayload(ECompressableQueryUpdateTag Variant, const TArray<uint8>& In, TArray<uint8>& Out)
+bool UDbConnectionBase::DecompressPayload(ECompressableQueryUpdateTag Variant, TArrayView<const uint8> In, TArray<uint8>& Out)
 {
-	switch (Variant)
-	{
-	case ECompressableQueryUpdateTag::Uncompressed:
-		// No compression, just copy the data
-		Out = In;
-		return true;
-	case ECompressableQueryUpdateTag::Brotli:
-		return DecompressBrotli(In, Out);
-	case ECompressableQueryUpdateTag::Gzip:
-		return DecompressGzip(In, Out);
-	default:
-		UE_LOG(LogTemp, Error, TEXT("Unknown compression variant"));
-		return false;
-	}
+	return UE::SpacetimeDB::Compression::DecompressPayload(Variant, In, Out);
 }
 
-void UDbConnectionBase::PreProcessDatabaseUpdate(const FDatabaseUpdateType& Update)
+void UDbConnectionBase::PreProcessDatabaseUpdate(const FDatabaseUpdateType& Update, TArray<TSharedPtr<UE::SpacetimeDB::FPreprocessedTableDataBase>>& OutTableData)
 {
-	for (const FTableUpdateType& TableUpdate : Update.Tables)
+	// One entry per table, left null for tables that cannot be preprocessed
+	OutTableData.SetNum(Update.Tables.Num());
+
+	// Shared by every compressed query update in this message
+	TArray<uint8> CQUScratch;
+	for (int32 TableIndex = 0; TableIndex < Update.Tables.Num(); ++TableIndex)
 	{
-		TArray<FCompressableQueryUpdateType> UncompressedCQUs;
+		const FTableUpdateType& TableUpdate = Update.Tables[TableIndex];
+
+		// Find the deserializer first, rows of unknown tables are not worth decompressing
+		UE::SpacetimeDB::ITableRowDeserializer* Deserializer = FindTableDeserializer(TableUpdate);
+		if (!Deserializer)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Skipping table %s updates due to missing deserializer"), *TableUpdate.TableName);
+			continue;
+		}
+
+		// Uncompressed updates are read in place, only decompressed ones need storage of their own
+		TArray<const FQueryUpdateType*> QueryUpdates;
+		TArray<FQueryUpdateType> DecompressedUpdates;
+		QueryUpdates.Reserve(TableUpdate.Updates.Num());
+		DecompressedUpdates.Reserve(TableUpdate.Updates.Num());
 		for (const FCompressableQueryUpdateType& CQU : TableUpdate.Updates)
 		{
-	
 			// Uncompress the CQU based on its tag
-			FQueryUpdateType UncompressedUpdate;
+			const FQueryUpdateType* UncompressedUpdate = nullptr;
 			switch (CQU.Tag)
 			{
 			case ECompressableQueryUpdateTag::Uncompressed:
-				UncompressedUpdate = CQU.GetAsUncompressed();
+				UncompressedUpdate = &CQU.GetAsUncompressed();
 				break;
 			case ECompressableQueryUpdateTag::Brotli:
 			{
-				TArray<uint8> Data = CQU.GetAsBrotli();
-				TArray<uint8> Dec;
-				if (DecompressBrotli(Data, Dec))
+				if (DecompressBrotli(CQU.GetAsBrotli(), CQUScratch))
 				{
-					//@Note: This will never trigger until Brotli decompression is implemented
-					UncompressedUpdate = UE::SpacetimeDB::Deserialize<FQueryUpdateType>(Dec);
+					UncompressedUpdate = &DecompressedUpdates.Add_GetRef(UE::SpacetimeDB::Deserialize<FQueryUpdateType>(CQUScratch));
 				}
 				break;
 			}
 			case ECompressableQueryUpdateTag::Gzip:
 			{
-				TArray<uint8> Data = CQU.GetAsGzip();
-				TArray<uint8> Dec;
-				if (DecompressGzip(Data, Dec))
+				if (DecompressGzip(CQU.GetAsGzip(), CQUScratch))
 				{
-					UncompressedUpdate = UE::SpacetimeDB::Deserialize<FQueryUpdateType>(Dec);
+					UncompressedUpdate = &DecompressedUpdates.Add_GetRef(UE::SpacetimeDB::Deserialize<FQueryUpdateType>(CQUScratch));
 				}
 				break;
 			}
@@ -432,67 +577,116 @@ void UDbConnectionBase::PreProcessDatabaseUpdate(const FDatabaseUpdateType& Upda
 				UE_LOG(LogTemp, Error, TEXT("Unknown compression variant in CQU"));
 				break;
 			}
-			UncompressedCQUs.Add(FCompressableQueryUpdateType::Uncompressed(UncompressedUpdate));
-			UE_LOG(LogTemp, Verbose, TEXT("Table %s Inserts:%d Deletes:%d"), *TableUpdate.TableName, UncompressedUpdate.Inserts.RowsData.Num(), UncompressedUpdate.Deletes.RowsData.Num());
-		}
-
-		// After ensuring all updates are uncompressed, attempt to deserialize rows
-		TSharedPtr<UE::SpacetimeDB::ITableRowDeserializer> Deserializer;
-		{
-			// Find the deserializer for this table
-			FScopeLock Lock(&TableDeserializersMutex);
-			if (TSharedPtr<UE::SpacetimeDB::ITableRowDeserializer>* Found = TableDeserializers.Find(TableUpdate.TableName))
-			{
-				// If found, use the deserializer
-				Deserializer = *Found;
-			}
-			else
+			if (!UncompressedUpdate)
 			{
-				UE_LOG(LogTemp, Error, TEXT("No deserializer found for table %s"), *TableUpdate.TableName);
+				continue;
 			}
+			QueryUpdates.Add(UncompressedUpdate);
+			UE_LOG(LogTemp, Verbose, TEXT("Table %s Inserts:%d Deletes:%d"), *TableUpdate.TableName, UncompressedUpdate->Inserts.RowsData.Num(), UncompressedUpdate->Deletes.RowsData.Num());
 		}
-		if (Deserializer)
+
+		// Preprocess the table data using the deserializer, it travels with the message to the game thread
+		OutTableData[TableIndex] = Deserializer->PreProcess(QueryUpdates, TableUpdate.TableName);
+	}
+}
+
+UE::SpacetimeDB::ITableRowDeserializer* UDbConnectionBase::FindTableDeserializer(const FTableUpdateType& TableUpdate)
+{
+	const bool bIndexed = TableUpdate.TableId < MaxIndexedTableId;
+	if (bIndexed)
+	{
+		if (UE::SpacetimeDB::ITableRowDeserializer* Cached = DeserializersById[TableUpdate.TableId].load(std::memory_order_acquire))
 		{
-			// Preprocess the table data using the deserializer
-			TSharedPtr<UE::SpacetimeDB::FPreprocessedTableDataBase> Data = Deserializer->PreProcess(UncompressedCQUs, TableUpdate.TableName);
-			if (Data.IsValid())
-			{
-				// Store the preprocessed data in the mutex-protected map
-				FScopeLock Lock(&PreprocessedDataMutex);
-				FPreprocessedTableKey Key(TableUpdate.TableId, TableUpdate.TableName);
-				TArray<TSharedPtr<UE::SpacetimeDB::FPreprocessedTableDataBase>>& Queue = PreprocessedTableData.FindOrAdd(Key);
-				Queue.Add(Data);
-			}
+			return Cached;
 		}
-		else
+	}
+
+	// First update for this table, or an id too large to index, resolve it by name
+	FScopeLock Lock(&TableDeserializersMutex);
+	TSharedPtr<UE::SpacetimeDB::ITableRowDeserializer>* Found = TableDeserializers.Find(TableUpdate.TableName);
+	if (!Found)
+	{
+		UE_LOG(LogTemp, Error, TEXT("No deserializer found for table %s"), *TableUpdate.TableName);
+		return nullptr;
+	}
+	if (bIndexed)
+	{
+		DeserializersById[TableUpdate.TableId].store(Found->Get(), std::memory_order_release);
+	}
+	return Found->Get();
+}
+
+void UDbConnectionBase::ResetDeserializersById()
+{
+	for (uint32 TableId = 0; TableId < MaxIndexedTableId; ++TableId)
+	{
+		DeserializersById[TableId].store(nullptr, std::memory_order_release);
+	}
+}
+
+UDbConnectionBase::ITableUpdateHandler* UDbConnectionBase::FindTableUpdateHandler(const FTableUpdateType& TableUpdate)
+{
+	const int32 TableId = static_cast<int32>(TableUpdate.TableId);
+	const bool bIndexed = TableUpdate.TableId < MaxIndexedTableId;
+	if (bIndexed && HandlersById.IsValidIndex(TableId) && HandlersById[TableId].bResolved)
+	{
+		return HandlersById[TableId].Handler.Get();
+	}
+
+	// First update for this table, or an id too large to index, resolve it by name
+	TSharedPtr<ITableUpdateHandler> Handler;
+	{
+		FScopeLock Lock(&RegisteredTablesMutex);
+		if (TSharedPtr<ITableUpdateHandler>* Found = RegisteredTables.Find(TableUpdate.TableName))
 		{
-			UE_LOG(LogTemp, Error, TEXT("Skipping table %s updates due to missing deserializer"), *TableUpdate.TableName);
+			Handler = *Found;
 		}
 	}
+	if (!bIndexed)
+	{
+		// Nothing caches it, the map keeps the handler alive
+		return Handler.Get();
+	}
+	if (HandlersById.Num() <= TableId)
+	{
+		HandlersById.SetNum(TableId + 1);
+	}
+	HandlersById[TableId].Handler = Handler;
+	HandlersById[TableId].bResolved = true;
+	return Handler.Get();
 }
 
-FServerMessageType UDbConnectionBase::PreProcessMessage(const TArray<uint8>& Message)
+FParsedServerMessage UDbConnectionBase::PreProcessMessage(const FWebsocketFrameBuffer& Frame)
 {
+	FParsedServerMessage Result;
+	const TArray<uint8>& Message = *Frame;
 	if (Message.Num() == 0)
 	{
 		UE_LOG(LogTemp, Error, TEXT("Empty message recived from server, ignored"));
-		return FServerMessageType{};
+		return Result;
 	}
 	// Check if the first byte is a valid compression tag
 	ECompressableQueryUpdateTag Compression = static_cast<ECompressableQueryUpdateTag>(Message[0]);
-	TArray<uint8> CompressedPayload;
-	CompressedPayload.Append(Message.GetData() + 1, Message.Num() - 1);
+	const TArrayView<const uint8> CompressedPayload(Message.GetData() + 1, Message.Num() - 1);
 
-	// Decompress the payload based on the compression tag
-	TArray<uint8> Decompressed;
-	if (!DecompressPayload(Compression, CompressedPayload, Decompressed))
+	// Decompress into this worker's scratch buffer, uncompressed frames are read in place
+	static thread_local TArray<uint8> DecompressScratch;
+	TArrayView<const uint8> Decompressed;
+	if (!UE::SpacetimeDB::Compression::DecompressPayload(Compression, CompressedPayload, DecompressScratch, Decompressed))
 	{
 		UE_LOG(LogTemp, Error, TEXT("Failed to decompress incoming message"));
-		return FServerMessageType{};
+		return Result;
 	}
 
 	// Deserialize the decompressed data into a UServerMessageType object
-	FServerMessageType Parsed = UE::SpacetimeDB::Deserialize<FServerMessageType>(Decompressed);
+	Result.Message = UE::SpacetimeDB::Deserialize<FServerMessageType>(Decompressed);
+	const FServerMessageType& Parsed = Result.Message;
+
+	// Don't let one huge subscription pin its buffer on the worker forever
+	if (DecompressScratch.Max() > MaxRetainedScratchBytes)
+	{
+		DecompressScratch.Empty();
+	}
 
 	// Process it based on its tag. Messages containing rows will be deserialized into rows based on registered type and table name.
 	bool bValid = false;
@@ -500,46 +694,46 @@ FServerMessageType UDbConnectionBase::PreProcessMessage(const TArray<uint8>& Mes
 	{
 		case EServerMessageTag::InitialSubscription:
 		{
-			const FInitialSubscriptionType Payload = Parsed.GetAsInitialSubscription();
+			const FInitialSubscriptionType& Payload = Parsed.GetAsInitialSubscription();
 			// PreProcess the initial subscription payload
-			PreProcessDatabaseUpdate(Payload.DatabaseUpdate);
+			PreProcessDatabaseUpdate(Payload.DatabaseUpdate, Result.TableData);
 			break;
 		}
 		case EServerMessageTag::TransactionUpdate:
 		{
 
-			const FTransactionUpdateType Payload = Parsed.GetAsTransactionUpdate();
+			const FTransactionUpdateType& Payload = Parsed.GetAsTransactionUpdate();
 			if (Payload.Status.IsCommitted())
 			{
 				// PreProcess the database update with the committed status
-				PreProcessDatabaseUpdate(Payload.Status.GetAsCommitted());
+				PreProcessDatabaseUpdate(Payload.Status.GetAsCommitted(), Result.TableData);
 			}
 			break;
 		}
 		case EServerMessageTag::TransactionUpdateLight:
 		{
 			//@Note: Light tag in not implemented as an option in connection builder, this will never trigger but we keep this for future compatibility
-			const FTransactionUpdateLightType Payload = Parsed.GetAsTransactionUpdateLight();
+			const FTransactionUpdateLightType& Payload = Parsed.GetAsTransactionUpdateLight();
 			// PreProcess the light transaction update
-			PreProcessDatabaseUpdate(Payload.Update);
+			PreProcessDatabaseUpdate(Payload.Update, Result.TableData);
 			break;
 		}
 		case EServerMessageTag::SubscribeMultiApplied:
 		{
-			const FSubscribeMultiAppliedType Payload = Parsed.GetAsSubscribeMultiApplied();
-			PreProcessDatabaseUpdate(Payload.Update);
+			const FSubscribeMultiAppliedType& Payload = Parsed.GetAsSubscribeMultiApplied();
+			PreProcessDatabaseUpdate(Payload.Update, Result.TableData);
 			break;
 		}
 		case EServerMessageTag::UnsubscribeMultiApplied:
 		{
-			const FUnsubscribeMultiAppliedType Payload = Parsed.GetAsUnsubscribeMultiApplied();
-			PreProcessDatabaseUpdate(Payload.Update);
+			const FUnsubscribeMultiAppliedType& Payload = Parsed.GetAsUnsubscribeMultiApplied();
+			PreProcessDatabaseUpdate(Payload.Update, Result.TableData);
 			break;
 		}
 		default:
 			break;
 	}
-	return Parsed;
+	return Result;
 }
 
 
@@ -600,6 +794,11 @@ void UDbConnectionBase::UnsubscribeInternal(USubscriptionHandleBase* Handle)
 }
 
 void UDbConnectionBase::InternalCallReducer(const FString& Reducer, TArray<uint8> Args, USetReducerFlagsBase* Flags)
+{
+	InternalCallReducer(Reducer, [&Args](UE::SpacetimeDB::UEWriter& Writer) { Writer.write_raw_bytes(Args); }, Flags);
+}
+
+void UDbConnectionBase::InternalCallReducer(const FString& Reducer, UE::SpacetimeDB::FReducerArgsWriter WriteArgs, USetReducerFlagsBase* Flags)
 {
 
 	if (!WebSocket || !WebSocket->IsConnected())
@@ -609,51 +808,79 @@ void UDbConnectionBase::InternalCallReducer(const FString& Reducer, TArray<uint8
 	}
 
 	uint8 FlagToUse = 0; // Default to FullUpdate
-	if (Flags && Flags->FlagMap.Contains(Reducer))
+	if (const ECallReducerFlags* FlagFound = Flags ? Flags->FlagMap.Find(Reducer) : nullptr)
 	{
 		//Select flag if set by user
-		ECallReducerFlags FlagFound = *Flags->FlagMap.Find(Reducer);
-		FlagToUse = static_cast<uint8>(FlagFound);
+		FlagToUse = static_cast<uint8>(*FlagFound);
 	}
 
-	FCallReducerType MsgData;
-	MsgData.Reducer = Reducer;
-	MsgData.Args = Args;
-	MsgData.RequestId = GetNextRequestId();
-	MsgData.Flags = FlagToUse;
-
-	FClientMessageType Msg = FClientMessageType::CallReducer(MsgData);
-	TArray<uint8> Data = UE::SpacetimeDB::Serialize(Msg);
+	//header and args go straight into the thread's send buffer, no intermediate FClientMessageType
+	const TArrayView<const uint8> Data = UE::SpacetimeDB::WriteCallReducerMessage(Reducer, static_cast<uint32>(GetNextRequestId()), FlagToUse, WriteArgs);
 	SendRawMessage(Data);
 
 }
 
 void UDbConnectionBase::ApplyRegisteredTableUpdates(const FDatabaseUpdateType& Update, void* Context)
 {
-	// Ensure we have a valid context for the update
-	TArray<TSharedPtr<ITableUpdateHandler>> Handlers;
-	for (const FTableUpdateType& TableUpdate : Update.Tables)
+	const bool bIsApplyingMessage = ApplyingMessage && FindDatabaseUpdate(ApplyingMessage->Message) == &Update;
+	if (bIsApplyingMessage && ApplyingMessage->bCacheApplied)
 	{
-		TSharedPtr<ITableUpdateHandler> Handler;
+		// The apply thread already updated the caches, show reads the state this update left them in before firing its events
+		for (const TSharedPtr<UE::SpacetimeDB::FAppliedTableUpdateBase>& Applied : ApplyingMessage->AppliedTables)
 		{
-			// Find the handler for this table update
-			FScopeLock Lock(&RegisteredTablesMutex);
-			if (TSharedPtr<ITableUpdateHandler>* Found = RegisteredTables.Find(TableUpdate.TableName))
-			{
-				Handler = *Found;
-			}
+			Applied->MakeVisible();
 		}
-		if (Handler.IsValid())
+		for (const TSharedPtr<UE::SpacetimeDB::FAppliedTableUpdateBase>& Applied : ApplyingMessage->AppliedTables)
 		{
-			// Update the cache for the handler with the table update and context
-			Handler->UpdateCache(this, TableUpdate, Context);
-			Handlers.Add(Handler);
+			Applied->Broadcast(this, Context);
 		}
+		return;
 	}
-	
-	for (TSharedPtr<ITableUpdateHandler>& Handler : Handlers)
+	if (ApplyThread)
+	{
+		UE_LOG(LogTemp, Error, TEXT("ApplyRegisteredTableUpdates: Update was not applied by the apply thread, the game thread does not own the table caches"));
+		return;
+	}
+
+	// Ensure we have a valid context for the update
+	// Rows deserialized by the decode worker, only valid if Update is the one carried by the message being applied
+	const TArray<TSharedPtr<UE::SpacetimeDB::FPreprocessedTableDataBase>>* TableData = nullptr;
+	if (bIsApplyingMessage && ApplyingMessage->TableData.Num() == Update.Tables.Num())
+	{
+		TableData = &ApplyingMessage->TableData;
+	}
+
+	// Resolve the handlers on the game thread, the cache updates may then run on task threads
+	FResolvedTableUpdates Resolved;
+	ResolveTableUpdates(Update, TableData, Resolved);
+
+	// Update the cache of every table, tables listed twice share a handler and must be applied in order
+	UE::SpacetimeDB::ApplyTableUpdates(Resolved.RowCounts, Resolved.bDistinctTables ? ParallelApplyMinRows.load(std::memory_order_relaxed) : 0, [&](int32 Index)
+	{
+		const int32 TableIndex = Resolved.TableIndices[Index];
+		Resolved.Handlers[Index]->UpdateCache(this, Update.Tables[TableIndex], TableData ? (*TableData)[TableIndex] : nullptr, Context);
+	});
+
+	for (ITableUpdateHandler* Handler : Resolved.Handlers)
 	{
 		// Broadcast the diff for each handler
 		Handler->BroadcastDiff(this, Context);
 	}
+}
+
+void UDbConnectionBase::ResolveTableUpdates(const FDatabaseUpdateType& Update, const TArray<TSharedPtr<UE::SpacetimeDB::FPreprocessedTableDataBase>>* TableData, FResolvedTableUpdates& Out)
+{
+	for (int32 TableIndex = 0; TableIndex < Update.Tables.Num(); ++TableIndex)
+	{
+		const FTableUpdateType& TableUpdate = Update.Tables[TableIndex];
+		// Find the handler for this table update
+		if (ITableUpdateHandler* Handler = FindTableUpdateHandler(TableUpdate))
+		{
+			const UE::SpacetimeDB::FPreprocessedTableDataBase* Preprocessed = TableData ? (*TableData)[TableIndex].Get() : nullptr;
+			Out.bDistinctTables &= !Out.Handlers.Contains(Handler);
+			Out.Handlers.Add(Handler);
+			Out.TableIndices.Add(TableIndex);
+			Out.RowCounts.Add(Preprocessed ? Preprocessed->NumRows() : static_cast<int64>(TableUpdate.NumRows));
+		}
+	}
 }
\ No newline at end of file
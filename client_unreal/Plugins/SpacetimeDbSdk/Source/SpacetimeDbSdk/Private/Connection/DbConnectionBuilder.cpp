@@ -43,16 +43,25 @@ UDbConnectionBuilderBase* UDbConnectionBuilderBase::WithTokenBase(const FString&
 
 UDbConnectionBuilderBase* UDbConnectionBuilderBase::WithCompressionBase(const ESpacetimeDBCompression& InCompression)
 {
-	if (InCompression == ESpacetimeDBCompression::Brotli)
-	{
-		UE_LOG(LogTemp, Warning, TEXT("Brotli compression is not available in this version of SDK. Defaulting to Gzip."));
-		Compression = ESpacetimeDBCompression::Gzip;
-	}
-	else
+	Compression = InCompression;
+	bCompressionSet = true;
+	return this;
+}
+
+UDbConnectionBuilderBase* UDbConnectionBuilderBase::WithDecodeWorkerCountBase(int32 InWorkerCount)
+{
+	if (InWorkerCount < 0)
 	{
-		Compression = InCompression;
+		UE_LOG(LogTemp, Warning, TEXT("WithDecodeWorkerCountBase called with negative worker count, using default"));
+		InWorkerCount = 0;
 	}
-	bCompressionSet = true;
+	DecodeWorkerCount = InWorkerCount;
+	return this;
+}
+
+UDbConnectionBuilderBase* UDbConnectionBuilderBase::WithApplyThreadBase(bool bInUseApplyThread)
+{
+	bUseApplyThread = bInUseApplyThread;
 	return this;
 }
 
@@ -118,6 +127,8 @@ UDbConnectionBase* UDbConnectionBuilderBase::BuildConnection(UDbConnectionBase*
 	Connection->OnConnectBaseDelegate = OnConnectCallback;
 	Connection->OnConnectErrorDelegate = OnConnectErrorCallback;
 	Connection->OnDisconnectBaseDelegate = OnDisconnectCallback;
+	Connection->DecodeWorkerCount = DecodeWorkerCount;
+	Connection->bUseApplyThread = bUseApplyThread;
 
 	Connection->WebSocket = NewObject<UWebsocketManager>(Connection);
 
@@ -138,7 +149,7 @@ UDbConnectionBase* UDbConnectionBuilderBase::BuildConnection(UDbConnectionBase*
 
 	Connection->WebSocket->OnConnectionError.AddDynamic(Connection, &UDbConnectionBase::HandleWSError);
 	Connection->WebSocket->OnClosed.AddDynamic(Connection, &UDbConnectionBase::HandleWSClosed);
-	Connection->WebSocket->OnBinaryMessageReceived.AddDynamic(Connection, &UDbConnectionBase::HandleWSBinaryMessage);
+	Connection->WebSocket->OnBinaryFrameReceived.AddUObject(Connection, &UDbConnectionBase::HandleWSBinaryFrame);
 	// Set the initialization token for the WebSocket connection
 	Connection->WebSocket->SetInitToken(Token);
 	// Connect the WebSocket to the constructed URL
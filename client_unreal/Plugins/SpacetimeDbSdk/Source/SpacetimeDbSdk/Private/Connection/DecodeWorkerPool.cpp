@@ -0,0 +1,180 @@
+#include "Connection/DecodeWorkerPool.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/PlatformMisc.h"
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+	/** Upper bound on a single wait so a missed wake-up only costs a short delay. */
+	constexpr uint32 WaitSliceMs = 50;
+}
+
+/** Worker thread body, pulls jobs from the owning pool and tracks its own busy/idle time. */
+class FDecodeWorkerPool::FWorker : public FRunnable
+{
+public:
+	FWorker(FDecodeWorkerPool& InPool, int32 InIndex) : Pool(InPool), Index(InIndex) {}
+
+	virtual uint32 Run() override
+	{
+		TUniqueFunction<void()> Job;
+		while (true)
+		{
+			const uint64 WaitStart = FPlatformTime::Cycles64();
+			const bool bGotJob = Pool.WaitForJob(Job);
+			const uint64 WorkStart = FPlatformTime::Cycles64();
+			IdleCycles.fetch_add(WorkStart - WaitStart, std::memory_order_relaxed);
+			if (!bGotJob)
+			{
+				break;
+			}
+
+			Job();
+			Job.Reset();
+
+			BusyCycles.fetch_add(FPlatformTime::Cycles64() - WorkStart, std::memory_order_relaxed);
+			JobsProcessed.fetch_add(1, std::memory_order_relaxed);
+		}
+		return 0;
+	}
+
+	FDecodeWorkerStats GetStats() const
+	{
+		FDecodeWorkerStats Stats;
+		Stats.WorkerIndex = Index;
+		Stats.JobsProcessed = JobsProcessed.load(std::memory_order_relaxed);
+		Stats.BusySeconds = FPlatformTime::ToSeconds64(BusyCycles.load(std::memory_order_relaxed));
+		Stats.IdleSeconds = FPlatformTime::ToSeconds64(IdleCycles.load(std::memory_order_relaxed));
+		return Stats;
+	}
+
+private:
+	FDecodeWorkerPool& Pool;
+	int32 Index;
+	std::atomic<int64> JobsProcessed{ 0 };
+	std::atomic<uint64> BusyCycles{ 0 };
+	std::atomic<uint64> IdleCycles{ 0 };
+};
+
+FDecodeWorkerPool::FDecodeWorkerPool(int32 NumWorkers, int32 InMaxQueuedJobs)
+	: MaxQueuedJobs(FMath::Max(1, InMaxQueuedJobs))
+{
+	WorkAvailable = FPlatformProcess::GetSynchEventFromPool(false);
+
+	NumWorkers = FMath::Max(1, NumWorkers);
+	for (int32 Index = 0; Index < NumWorkers; ++Index)
+	{
+		FWorker* Worker = new FWorker(*this, Index);
+		FRunnableThread* Thread = FRunnableThread::Create(Worker, *FString::Printf(TEXT("SpacetimeDBDecode%d"), Index), 0, TPri_Normal);
+		if (!Thread)
+		{
+			UE_LOG(LogTemp, Error, TEXT("FDecodeWorkerPool: Failed to create decode worker %d"), Index);
+			delete Worker;
+			continue;
+		}
+		Workers.Add(Worker);
+		Threads.Add(Thread);
+	}
+}
+
+FDecodeWorkerPool::~FDecodeWorkerPool()
+{
+	Shutdown();
+	FPlatformProcess::ReturnSynchEventToPool(WorkAvailable);
+}
+
+int32 FDecodeWorkerPool::GetDefaultNumWorkers()
+{
+	// Leave the game and render threads their cores, decoding rarely needs more than a couple of threads
+	return FMath::Clamp(FPlatformMisc::NumberOfCoresIncludingHyperthreads() - 2, 1, 4);
+}
+
+bool FDecodeWorkerPool::TryEnqueue(TUniqueFunction<void()>&& Job)
+{
+	if (bStopping.load(std::memory_order_acquire))
+	{
+		return false;
+	}
+	if (Threads.Num() == 0)
+	{
+		// No worker could be started, run inline so messages are not lost
+		Job();
+		return true;
+	}
+
+	{
+		FScopeLock Lock(&QueueMutex);
+		if (QueuedJobs.load(std::memory_order_relaxed) >= MaxQueuedJobs)
+		{
+			BackpressureStalls.fetch_add(1, std::memory_order_relaxed);
+			UE_LOG(LogTemp, Verbose, TEXT("FDecodeWorkerPool: Queue full (%d jobs), job refused"), MaxQueuedJobs);
+			return false;
+		}
+		Jobs.Enqueue(MoveTemp(Job));
+		QueuedJobs.fetch_add(1, std::memory_order_relaxed);
+	}
+	WorkAvailable->Trigger();
+	return true;
+}
+
+bool FDecodeWorkerPool::WaitForJob(TUniqueFunction<void()>& OutJob)
+{
+	while (!bStopping.load(std::memory_order_acquire))
+	{
+		{
+			FScopeLock Lock(&QueueMutex);
+			if (Jobs.Dequeue(OutJob))
+			{
+				QueuedJobs.fetch_sub(1, std::memory_order_relaxed);
+				return true;
+			}
+		}
+		WorkAvailable->Wait(WaitSliceMs);
+	}
+	return false;
+}
+
+void FDecodeWorkerPool::Shutdown()
+{
+	if (bStopping.exchange(true))
+	{
+		return;
+	}
+
+	// Wake every worker so they observe the stop flag
+	for (int32 Index = 0; Index < Threads.Num(); ++Index)
+	{
+		WorkAvailable->Trigger();
+	}
+
+	for (FRunnableThread* Thread : Threads)
+	{
+		Thread->WaitForCompletion();
+		delete Thread;
+	}
+	Threads.Reset();
+
+	for (FWorker* Worker : Workers)
+	{
+		delete Worker;
+	}
+	Workers.Reset();
+
+	FScopeLock Lock(&QueueMutex);
+	Jobs.Empty();
+	QueuedJobs.store(0, std::memory_order_relaxed);
+}
+
+TArray<FDecodeWorkerStats> FDecodeWorkerPool::GetWorkerStats() const
+{
+	TArray<FDecodeWorkerStats> Out;
+	Out.Reserve(Workers.Num());
+	for (const FWorker* Worker : Workers)
+	{
+		Out.Add(Worker->GetStats());
+	}
+	return Out;
+}
@@ -0,0 +1,27 @@
+#include "Connection/OutgoingReducerScheduler.h"
+
+void FOutgoingReducerScheduler::Tick(double Now, FSendFunction Send)
+{
+	if (Now - LastFlushTime < SendInterval)
+	{
+		return;
+	}
+	LastFlushTime = Now;
+	Flush(Send);
+}
+
+void FOutgoingReducerScheduler::Flush(FSendFunction Send)
+{
+	for (TPair<FSlotKey, TUniquePtr<FSlotBase>>& Pair : Slots)
+	{
+		bool bSkipped = false;
+		if (Pair.Value->SendPending(Pair.Key.Reducer, Send, bSkipped))
+		{
+			++Stats.Sent;
+		}
+		else if (bSkipped)
+		{
+			++Stats.SkippedBelowThreshold;
+		}
+	}
+}
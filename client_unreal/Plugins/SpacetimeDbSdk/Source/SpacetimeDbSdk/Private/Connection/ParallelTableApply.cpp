@@ -0,0 +1,38 @@
+#include "Connection/ParallelTableApply.h"
+#include "Async/ParallelFor.h"
+
+namespace UE::SpacetimeDB
+{
+	bool ApplyTableUpdates(TArrayView<const int64> RowCounts, int32 MinRows, TFunctionRef<void(int32 TableIndex)> Apply)
+	{
+		int64 TotalRows = 0;
+		for (const int64 Rows : RowCounts)
+		{
+			TotalRows += Rows;
+		}
+
+		if (MinRows <= 0 || RowCounts.Num() < 2 || TotalRows < MinRows)
+		{
+			for (int32 TableIndex = 0; TableIndex < RowCounts.Num(); ++TableIndex)
+			{
+				Apply(TableIndex);
+			}
+			return false;
+		}
+
+		// Start the largest tables first, the update is done when its largest table is
+		TArray<int32, TInlineAllocator<16>> Order;
+		for (int32 TableIndex = 0; TableIndex < RowCounts.Num(); ++TableIndex)
+		{
+			Order.Add(TableIndex);
+		}
+		Order.StableSort([&RowCounts](int32 A, int32 B) { return RowCounts[A] > RowCounts[B]; });
+
+		// Tables vary wildly in size, hand them out one at a time instead of in equal batches
+		ParallelFor(Order.Num(), [&Order, &Apply](int32 Index)
+		{
+			Apply(Order[Index]);
+		}, EParallelForFlags::Unbalanced);
+		return true;
+	}
+}
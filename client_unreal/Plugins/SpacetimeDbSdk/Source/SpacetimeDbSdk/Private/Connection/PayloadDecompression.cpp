@@ -0,0 +1,113 @@
+#include "Connection/PayloadDecompression.h"
+#include "Connection/BrotliDecoder.h"
+
+THIRD_PARTY_INCLUDES_START
+#include "zlib.h"
+THIRD_PARTY_INCLUDES_END
+
+namespace UE::SpacetimeDB::Compression
+{
+	bool DecompressGzip(TArrayView<const uint8> InData, TArray<uint8>& OutData)
+	{
+		if (InData.Num() < 4)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Gzip data too small"));
+			return false;
+		}
+
+		// The ISIZE trailer wraps past 4 GB and is not validated, only trust it within deflate's maximum ratio
+		const uint8* SizePtr = InData.GetData() + InData.Num() - 4;
+		const int64 SizeHint = static_cast<uint32>(SizePtr[0] | (SizePtr[1] << 8) | (SizePtr[2] << 16) | (SizePtr[3] << 24));
+		const int64 MaxRatioSize = static_cast<int64>(InData.Num()) * 1032;
+		const int64 InitialSize = (SizeHint > 0 && SizeHint <= MaxRatioSize) ? SizeHint : static_cast<int64>(InData.Num()) * 4;
+		OutData.Reset();
+		OutData.SetNumUninitialized(static_cast<int32>(FMath::Min<int64>(InitialSize, MAX_int32)), EAllowShrinking::No);
+
+		z_stream Stream = {};
+		Stream.next_in = const_cast<Bytef*>(InData.GetData());
+		Stream.avail_in = InData.Num();
+		// 16 + MAX_WBITS selects the gzip wrapper
+		if (inflateInit2(&Stream, 16 + MAX_WBITS) != Z_OK)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Gzip inflate could not be initialised"));
+			return false;
+		}
+
+		int Result = Z_OK;
+		do
+		{
+			if (Stream.total_out == static_cast<uLong>(OutData.Num()))
+			{
+				if (OutData.Num() > MAX_int32 / 2)
+				{
+					UE_LOG(LogTemp, Error, TEXT("Gzip payload exceeds maximum buffer size"));
+					Result = Z_MEM_ERROR;
+					break;
+				}
+				OutData.SetNumUninitialized(FMath::Max(OutData.Num() * 2, 4096), EAllowShrinking::No);
+			}
+			Stream.next_out = OutData.GetData() + Stream.total_out;
+			Stream.avail_out = OutData.Num() - Stream.total_out;
+			Result = inflate(&Stream, Z_NO_FLUSH);
+		}
+		// Z_BUF_ERROR with a full output buffer only means inflate wants more room
+		while (Result == Z_OK || (Result == Z_BUF_ERROR && Stream.avail_out == 0));
+
+		const int32 TotalOut = static_cast<int32>(Stream.total_out);
+		inflateEnd(&Stream);
+
+		if (Result != Z_STREAM_END)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Gzip decompression failed (%d)"), Result);
+			return false;
+		}
+
+		OutData.SetNum(TotalOut, EAllowShrinking::No);
+		return true;
+	}
+
+	bool DecompressBrotli(TArrayView<const uint8> InData, TArray<uint8>& OutData)
+	{
+		const TCHAR* Error = nullptr;
+		if (!DecodeBrotli(InData, OutData, Error))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Brotli decompression failed: %s"), Error);
+			return false;
+		}
+		return true;
+	}
+
+	bool DecompressPayload(ECompressableQueryUpdateTag Variant, TArrayView<const uint8> In, TArray<uint8>& Scratch, TArrayView<const uint8>& OutView)
+	{
+		bool bOk = false;
+		switch (Variant)
+		{
+		case ECompressableQueryUpdateTag::Uncompressed:
+			// No compression, read straight from the input
+			OutView = In;
+			return true;
+		case ECompressableQueryUpdateTag::Brotli:
+			bOk = DecompressBrotli(In, Scratch);
+			break;
+		case ECompressableQueryUpdateTag::Gzip:
+			bOk = DecompressGzip(In, Scratch);
+			break;
+		default:
+			UE_LOG(LogTemp, Error, TEXT("Unknown compression variant"));
+			return false;
+		}
+		OutView = bOk ? TArrayView<const uint8>(Scratch) : TArrayView<const uint8>();
+		return bOk;
+	}
+
+	bool DecompressPayload(ECompressableQueryUpdateTag Variant, TArrayView<const uint8> In, TArray<uint8>& Out)
+	{
+		if (Variant == ECompressableQueryUpdateTag::Uncompressed)
+		{
+			Out = TArray<uint8>(In.GetData(), In.Num());
+			return true;
+		}
+		TArrayView<const uint8> View;
+		return DecompressPayload(Variant, In, Out, View);
+	}
+}
@@ -0,0 +1,32 @@
+#include "Connection/ReducerCallWriter.h"
+#include "ModuleBindings/Types/ClientMessageType.g.h"
+
+namespace UE::SpacetimeDB
+{
+	namespace
+	{
+		/** Cleared before every message, never shrunk. */
+		thread_local TArray<uint8> SendBuffer;
+	}
+
+	TArrayView<const uint8> WriteCallReducerMessage(const FString& Reducer, uint32 RequestId, uint8 Flags, FReducerArgsWriter WriteArgs)
+	{
+		SendBuffer.Reset();
+		UEWriter Writer(SendBuffer);
+
+		// Same layout as FClientMessageType::CallReducer(FCallReducerType{ Reducer, Args, RequestId, Flags })
+		Writer.write_u8(static_cast<uint8>(EClientMessageTag::CallReducer));
+		Writer.write_string(Reducer);
+
+		// Args is a length prefixed byte array, reserve the prefix and patch it once the size is known
+		const int32 ArgsLengthOffset = Writer.size();
+		Writer.write_u32(0);
+		WriteArgs(Writer);
+		const uint32 ArgsLength = static_cast<uint32>(Writer.size() - ArgsLengthOffset - sizeof(uint32));
+		Writer.patch_u32_le(ArgsLengthOffset, ArgsLength);
+
+		Writer.write_u32(RequestId);
+		Writer.write_u8(Flags);
+		return SendBuffer;
+	}
+}
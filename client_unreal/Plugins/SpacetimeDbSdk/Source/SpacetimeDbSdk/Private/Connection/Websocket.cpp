@@ -5,6 +5,7 @@
 #include "ModuleBindings/Types/ServerMessageType.g.h"
 #include "ModuleBindings/Types/CompressableQueryUpdateType.g.h"
 #include "Misc/Compression.h"
+#include "HAL/FileManager.h"
 
 #include "Dom/JsonObject.h"
 #include "Serialization/JsonWriter.h"
@@ -36,6 +37,7 @@ void UWebsocketManager::BeginDestroy()
 	if (!HasAnyFlags(RF_ClassDefaultObject))
 	{
 		Disconnect();
+		StopFrameCapture();
 	}
 	Super::BeginDestroy();
 }
@@ -125,7 +127,7 @@ bool UWebsocketManager::SendMessage(const FString& Message)
 	return true;
 }
 
-bool UWebsocketManager::SendMessage(const TArray<uint8>& Data)
+bool UWebsocketManager::SendMessage(TArrayView<const uint8> Data)
 {
 	if (!IsConnected())
 	{
@@ -175,6 +177,13 @@ void UWebsocketManager::HandleMessageReceived(const FString& Message)
 
 void UWebsocketManager::HandleBinaryMessageReceived(const void* Data, SIZE_T Size, SIZE_T BytesRemaining)
 {
+	// Drop the rest of a frame that was rejected as too large
+	if (bDiscardingBinaryFrame)
+	{
+		bDiscardingBinaryFrame = BytesRemaining > 0;
+		return;
+	}
+
 	if (Size == 0)
 	{
 		return;
@@ -183,13 +192,39 @@ void UWebsocketManager::HandleBinaryMessageReceived(const void* Data, SIZE_T Siz
 	// Handle binary messages, which may be fragmented
 	const uint8* Bytes = static_cast<const uint8*>(Data);
 
-	if (IncompleteMessage.Num() > 0 && !bAwaitingBinaryFragments)
+	if (IncompleteMessage.IsValid() && !bAwaitingBinaryFragments)
 	{
 		UE_LOG(LogTemp, Error, TEXT("Received binary fragment while previous data pending"));
 	}
 
+	// Frame buffers are int32 sized, refuse frames that would not fit instead of truncating the size
+	const uint64 FrameSize = static_cast<uint64>(IncompleteMessage.IsValid() ? IncompleteMessage->Num() : 0) + Size + BytesRemaining;
+	if (FrameSize > static_cast<uint64>(MAX_int32))
+	{
+		UE_LOG(LogTemp, Error, TEXT("UWebsocketManager: Dropping binary frame of %llu bytes, the limit is %d"), FrameSize, MAX_int32);
+		IncompleteMessage.Reset();
+		IncompleteMessageBytesCopied = 0;
+		bAwaitingBinaryFragments = false;
+		bDiscardingBinaryFrame = BytesRemaining > 0;
+		return;
+	}
+
+	if (!IncompleteMessage.IsValid())
+	{
+		// First fragment, BytesRemaining tells us the rest of the frame so reserve it all up front
+		IncompleteMessage = FramePool->Acquire(static_cast<int32>(Size + BytesRemaining));
+		IncompleteMessageBytesCopied = 0;
+	}
+
+	// Growing past the reservation moves the bytes already received
+	if (IncompleteMessage->Num() + static_cast<int64>(Size) > IncompleteMessage->Max())
+	{
+		IncompleteMessageBytesCopied += IncompleteMessage->Num();
+	}
+
 	// Append new incoming bytes to any incomplete message
-	IncompleteMessage.Append(Bytes, Size);
+	IncompleteMessage->Append(Bytes, Size);
+	IncompleteMessageBytesCopied += Size;
 
 	if (BytesRemaining > 0)
 	{
@@ -201,12 +236,112 @@ void UWebsocketManager::HandleBinaryMessageReceived(const void* Data, SIZE_T Siz
 	// Final fragment received, reset and process
 	bAwaitingBinaryFragments = false;
 
-	TArray<uint8> MessageBytes = IncompleteMessage;
+	FWebsocketFrameBuffer Frame = IncompleteMessage.ToSharedRef();
 	IncompleteMessage.Reset();
 
+	// Dynamic delegates marshal their parameters by value, so each legacy listener pays a copy
+	if (OnBinaryMessageReceived.IsBound())
+	{
+		IncompleteMessageBytesCopied += Frame->Num();
+	}
+
+	FrameStats.LastFrameBytes = Frame->Num();
+	FrameStats.LastFrameBytesCopied = IncompleteMessageBytesCopied;
+	FrameStats.TotalBytesCopied += IncompleteMessageBytesCopied;
+	++FrameStats.TotalFrames;
+	UE_LOG(LogTemp, VeryVerbose, TEXT("UWebsocketManager: Frame of %d bytes, %lld bytes copied"), Frame->Num(), IncompleteMessageBytesCopied);
+
+	if (FrameCapture)
+	{
+		int32 CapturedFrameSize = Frame->Num();
+		*FrameCapture << CapturedFrameSize;
+		FrameCapture->Serialize(Frame->GetData(), CapturedFrameSize);
+	}
+
 	// Forward the complete binary payload to listeners.
-	OnBinaryMessageReceived.Broadcast(MessageBytes);
+	OnBinaryFrameReceived.Broadcast(Frame);
+	OnBinaryMessageReceived.Broadcast(*Frame);
+}
+
+bool UWebsocketManager::StartFrameCapture(const FString& FilePath)
+{
+	StopFrameCapture();
+	FrameCapture.Reset(IFileManager::Get().CreateFileWriter(*FilePath));
+	if (!FrameCapture)
+	{
+		UE_LOG(LogTemp, Error, TEXT("UWebsocketManager::StartFrameCapture: Could not open %s"), *FilePath);
+		return false;
+	}
+	UE_LOG(LogTemp, Log, TEXT("UWebsocketManager::StartFrameCapture: Recording frames to %s"), *FilePath);
+	return true;
+}
+
+void UWebsocketManager::StopFrameCapture()
+{
+	if (FrameCapture)
+	{
+		FrameCapture->Close();
+		FrameCapture.Reset();
+	}
+}
 
+FWebsocketFramePool::~FWebsocketFramePool()
+{
+	for (TArray<uint8>* Buffer : FreeBuffers)
+	{
+		delete Buffer;
+	}
+}
+
+FWebsocketFrameBuffer FWebsocketFramePool::Acquire(int32 MinCapacity)
+{
+	TArray<uint8>* Buffer = nullptr;
+	{
+		FScopeLock Lock(&Mutex);
+		if (FreeBuffers.Num() > 0)
+		{
+			Buffer = FreeBuffers.Pop(EAllowShrinking::No);
+		}
+	}
+	if (!Buffer)
+	{
+		Buffer = new TArray<uint8>();
+	}
+	Buffer->Reset(MinCapacity);
+
+	// The deleter only holds a weak reference so outstanding frames never keep the pool alive
+	TWeakPtr<FWebsocketFramePool, ESPMode::ThreadSafe> WeakPool = AsShared();
+	return MakeShareable(Buffer, [WeakPool](TArray<uint8>* Released)
+	{
+		if (TSharedPtr<FWebsocketFramePool, ESPMode::ThreadSafe> Pool = WeakPool.Pin())
+		{
+			Pool->Release(Released);
+		}
+		else
+		{
+			delete Released;
+		}
+	});
+}
+
+int32 FWebsocketFramePool::NumFree() const
+{
+	FScopeLock Lock(&Mutex);
+	return FreeBuffers.Num();
+}
+
+void FWebsocketFramePool::Release(TArray<uint8>* Buffer)
+{
+	if (Buffer->GetAllocatedSize() <= MaxRetainedBufferBytes)
+	{
+		FScopeLock Lock(&Mutex);
+		if (FreeBuffers.Num() < MaxFreeBuffers)
+		{
+			FreeBuffers.Add(Buffer);
+			return;
+		}
+	}
+	delete Buffer;
 }
 
 void UWebsocketManager::HandleClosed(int32 StatusCode, const FString& Reason, bool bWasClean)
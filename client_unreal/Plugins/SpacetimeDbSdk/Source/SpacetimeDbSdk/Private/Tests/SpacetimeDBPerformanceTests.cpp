@@ -0,0 +1,3593 @@
+/**
+ * Performance benchmarks for the SpacetimeDB client pipeline (Simple Automation Test)
+ * Results are reported through the automation log, failures only flag broken invariants.
+ */
+
+#include "Tests/SpacetimeDBBSATNTestOrg.h"
+
+#include "Connection/SequencedMessageRing.h"
+#include "Connection/DecodeWorkerPool.h"
+#include "Connection/PayloadDecompression.h"
+#include "Connection/BrotliDecoder.h"
+#include "Connection/ReducerCallWriter.h"
+#include "Connection/ReducerNameHash.h"
+#include "Connection/OutgoingReducerScheduler.h"
+#include "Connection/ParallelTableApply.h"
+#include "Connection/CacheApplyThread.h"
+#include "Connection/DbConnectionBase.h"
+#include "Tests/SpacetimeDBTestConnection.h"
+#include "BSATN/UEBSATNHelpers.h"
+#include "DBCache/ClientCache.h"
+#include "DBCache/TableHandle.h"
+#include "ModuleBindings/Types/ClientMessageType.g.h"
+#include "ModuleBindings/Types/ServerMessageType.g.h"
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "HAL/MemoryBase.h"
+#include "HAL/PlatformTLS.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Compression.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/MemoryReader.h"
+#include <atomic>
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace SpacetimeDBPerf
+{
+	/** Stand-in for a decoded server message. */
+	struct FFakeMessage
+	{
+		uint64 Sequence = 0;
+		TArray<uint8> Payload;
+	};
+
+	/** Game-thread wait statistics over a run. */
+	struct FWaitStats
+	{
+		double TotalSeconds = 0.0;
+		double MaxSeconds = 0.0;
+		int32 Ticks = 0;
+		int32 Released = 0;
+		bool bInOrder = true;
+
+		void AddTick(uint64 Cycles)
+		{
+			const double Seconds = FPlatformTime::ToSeconds64(Cycles);
+			TotalSeconds += Seconds;
+			MaxSeconds = FMath::Max(MaxSeconds, Seconds);
+			++Ticks;
+		}
+	};
+
+	/** Previous release path: reorder map and pending array, each behind its own lock. */
+	struct FLockedReleaseQueue
+	{
+		TMap<uint64, FFakeMessage> Preprocessed;
+		FCriticalSection PreprocessMutex;
+		uint64 NextReleaseId = 0;
+		TArray<FFakeMessage> Pending;
+		FCriticalSection PendingMutex;
+
+		void Publish(uint64 Id, FFakeMessage&& Message)
+		{
+			TArray<FFakeMessage> Ready;
+			{
+				FScopeLock Lock(&PreprocessMutex);
+				Preprocessed.Add(Id, MoveTemp(Message));
+				while (Preprocessed.Contains(NextReleaseId))
+				{
+					Ready.Add(Preprocessed.FindAndRemoveChecked(NextReleaseId));
+					++NextReleaseId;
+				}
+			}
+			if (Ready.Num() > 0)
+			{
+				FScopeLock Lock(&PendingMutex);
+				Pending.Append(MoveTemp(Ready));
+			}
+		}
+
+		void Drain(TArray<FFakeMessage>& Out)
+		{
+			FScopeLock Lock(&PendingMutex);
+			Out = MoveTemp(Pending);
+			Pending.Reset();
+		}
+	};
+
+	/**
+	 * Drive NumProducers decode threads at roughly MessagesPerSecond total for Seconds,
+	 * while the calling thread ticks at 60 Hz and measures only the time spent taking messages.
+	 */
+	template<typename PublishFn, typename DrainFn>
+	FWaitStats RunReleaseBenchmark(int32 NumProducers, int32 MessagesPerSecond, double Seconds, PublishFn&& Publish, DrainFn&& Drain)
+	{
+		const int32 TotalMessages = FMath::CeilToInt(MessagesPerSecond * Seconds);
+		const float ProducerInterval = static_cast<float>(NumProducers) / MessagesPerSecond;
+		std::atomic<uint64> NextId{ 0 };
+
+		TArray<TFuture<void>> Producers;
+		for (int32 ProducerIndex = 0; ProducerIndex < NumProducers; ++ProducerIndex)
+		{
+			Producers.Add(Async(EAsyncExecution::Thread, [&, ProducerIndex]()
+			{
+				FRandomStream Random(ProducerIndex + 1);
+				while (true)
+				{
+					const uint64 Id = NextId.fetch_add(1);
+					if (Id >= static_cast<uint64>(TotalMessages))
+					{
+						return;
+					}
+					// Simulated decode time so messages finish out of order
+					FPlatformProcess::SleepNoStats(Random.FRandRange(0.0f, 0.0005f));
+					FFakeMessage Message;
+					Message.Sequence = Id;
+					Message.Payload.SetNumZeroed(256);
+					Publish(Id, MoveTemp(Message));
+					FPlatformProcess::SleepNoStats(ProducerInterval);
+				}
+			}));
+		}
+
+		FWaitStats Stats;
+		uint64 Expected = 0;
+		while (Stats.Released < TotalMessages)
+		{
+			const uint64 Start = FPlatformTime::Cycles64();
+			TArray<FFakeMessage> Taken;
+			Drain(Taken);
+			Stats.AddTick(FPlatformTime::Cycles64() - Start);
+
+			for (const FFakeMessage& Message : Taken)
+			{
+				Stats.bInOrder &= Message.Sequence == Expected++;
+			}
+			Stats.Released += Taken.Num();
+			FPlatformProcess::SleepNoStats(1.0f / 60.0f);
+		}
+
+		for (TFuture<void>& Producer : Producers)
+		{
+			Producer.Wait();
+		}
+		return Stats;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FSpacetimeDBReleaseQueueContentionTest,
+	"SpacetimeDB.Performance.ReleaseQueueContention",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+	bool FSpacetimeDBReleaseQueueContentionTest::RunTest(const FString& /*Parameters*/)
+{
+	using namespace SpacetimeDBPerf;
+
+	constexpr int32 NumProducers = 4;
+	constexpr int32 MessagesPerSecond = 1000;
+	constexpr double Seconds = 2.0;
+
+	LOG_Category("Release queue contention, 1k messages/second");
+
+	FLockedReleaseQueue Locked;
+	const FWaitStats LockedStats = RunReleaseBenchmark(NumProducers, MessagesPerSecond, Seconds,
+		[&Locked](uint64 Id, FFakeMessage&& Message) { Locked.Publish(Id, MoveTemp(Message)); },
+		[&Locked](TArray<FFakeMessage>& Out) { Locked.Drain(Out); });
+
+	TSequencedMessageRing<FFakeMessage> Ring(1024);
+	const FWaitStats RingStats = RunReleaseBenchmark(NumProducers, MessagesPerSecond, Seconds,
+		[&Ring](uint64 Id, FFakeMessage&& Message)
+		{
+			// Refused while the slot is a lap ahead of the consumer, the message is kept for the retry
+			while (!Ring.Publish(Id, MoveTemp(Message)))
+			{
+				FPlatformProcess::Yield();
+			}
+		},
+		[&Ring](TArray<FFakeMessage>& Out)
+		{
+			FFakeMessage Message;
+			while (Ring.TryDequeue(Message))
+			{
+				Out.Add(MoveTemp(Message));
+			}
+		});
+
+	const auto Report = [this](const TCHAR* Name, const FWaitStats& Stats)
+	{
+		LOG_INFO(TEXT("%s: %d messages over %d ticks, game-thread wait avg %.2f us, max %.2f us"),
+			Name, Stats.Released, Stats.Ticks,
+			Stats.Ticks > 0 ? Stats.TotalSeconds * 1e6 / Stats.Ticks : 0.0,
+			Stats.MaxSeconds * 1e6);
+		if (!Stats.bInOrder)
+		{
+			LOG_FAIL(TEXT("%s released messages out of order"), Name);
+		}
+	};
+	Report(TEXT("Locked map + pending array"), LockedStats);
+	Report(TEXT("Sequenced ring"), RingStats);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FSpacetimeDBDecodeBackpressureTest,
+	"SpacetimeDB.Performance.DecodeBackpressure",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+	bool FSpacetimeDBDecodeBackpressureTest::RunTest(const FString& /*Parameters*/)
+{
+	using namespace SpacetimeDBPerf;
+
+	LOG_Category("Full release ring and decode queue refuse work instead of waiting");
+
+	bool bOk = true;
+
+	// A message a lap ahead of the consumer is refused and kept by the producer
+	TSequencedMessageRing<FFakeMessage> Ring(4);
+	for (uint64 Id = 0; Id < 4; ++Id)
+	{
+		bOk &= Ring.Publish(Id, FFakeMessage{ Id, {} });
+	}
+	FFakeMessage Lapped{ 4, { 1, 2, 3 } };
+	FFakeMessage Taken;
+	if (!bOk || Ring.Publish(4, MoveTemp(Lapped)) || Lapped.Payload.Num() != 3)
+	{
+		LOG_FAIL(TEXT("Release ring took a message into a slot still held one lap behind"));
+		bOk = false;
+	}
+	if (!Ring.TryDequeue(Taken) || Taken.Sequence != 0 || !Ring.Publish(4, MoveTemp(Lapped)))
+	{
+		LOG_FAIL(TEXT("Release ring refused a message after its slot was freed"));
+		bOk = false;
+	}
+
+	// One busy worker and one queued job fill the pool, the next job is refused without waiting
+	FDecodeWorkerPool Pool(1, 1);
+	if (Pool.GetNumWorkers() == 0)
+	{
+		LOG_FAIL(TEXT("Could not start a decode worker"));
+		return false;
+	}
+	FEvent* Release = FPlatformProcess::GetSynchEventFromPool(true);
+	std::atomic<int32> Ran{ 0 };
+	bOk &= Pool.TryEnqueue([Release, &Ran]() { Release->Wait(); ++Ran; });
+	while (Pool.GetQueueDepth() != 0)
+	{
+		FPlatformProcess::Yield();
+	}
+	bOk &= Pool.TryEnqueue([&Ran]() { ++Ran; });
+
+	TUniqueFunction<void()> Refused = [&Ran]() { ++Ran; };
+	const uint64 Start = FPlatformTime::Cycles64();
+	const bool bRefusedAccepted = Pool.TryEnqueue(MoveTemp(Refused));
+	const double RefuseUs = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - Start) * 1e6;
+	if (!bOk || bRefusedAccepted || !Refused || Pool.GetBackpressureStalls() != 1)
+	{
+		LOG_FAIL(TEXT("Decode queue accepted a job beyond its capacity"));
+		bOk = false;
+	}
+
+	Release->Trigger();
+	while (Pool.GetQueueDepth() != 0)
+	{
+		FPlatformProcess::Yield();
+	}
+	if (!Pool.TryEnqueue(MoveTemp(Refused)))
+	{
+		LOG_FAIL(TEXT("Decode queue refused a job after a worker took the queued one"));
+		bOk = false;
+	}
+	Pool.Shutdown();
+	FPlatformProcess::ReturnSynchEventToPool(Release);
+
+	LOG_INFO(TEXT("Refusing a job took %.2f us, %d jobs ran"), RefuseUs, Ran.load());
+	return bOk;
+}
+
+namespace SpacetimeDBPerf
+{
+	/** Totals for every recorded frame that used one compression variant. */
+	struct FDecodeTotals
+	{
+		int32 Frames = 0;
+		int64 WireBytes = 0;
+		int64 DecodedBytes = 0;
+		double Seconds = 0.0;
+		int32 Failures = 0;
+	};
+
+	/** Load frames written by UWebsocketManager::StartFrameCapture. */
+	static void LoadCapturedFrames(const FString& FilePath, TArray<TArray<uint8>>& OutFrames)
+	{
+		TArray<uint8> FileBytes;
+		if (!FFileHelper::LoadFileToArray(FileBytes, *FilePath))
+		{
+			return;
+		}
+		FMemoryReader Reader(FileBytes);
+		while (!Reader.AtEnd())
+		{
+			int32 FrameSize = 0;
+			Reader << FrameSize;
+			if (FrameSize <= 0 || Reader.Tell() + FrameSize > Reader.TotalSize())
+			{
+				break;
+			}
+			TArray<uint8>& Frame = OutFrames.AddDefaulted_GetRef();
+			Frame.SetNumUninitialized(FrameSize);
+			Reader.Serialize(Frame.GetData(), FrameSize);
+		}
+	}
+
+	/** Row-heavy frames shaped like entity updates, gzip compressed with the compression tag prefix. */
+	static void BuildSyntheticGzipSession(int32 NumFrames, int32 RowsPerFrame, TArray<TArray<uint8>>& OutFrames)
+	{
+		FRandomStream Random(1234);
+		for (int32 FrameIndex = 0; FrameIndex < NumFrames; ++FrameIndex)
+		{
+			TArray<uint8> Raw;
+			for (int32 Row = 0; Row < RowsPerFrame; ++Row)
+			{
+				const uint32 Id = Row;
+				const float Transform[6] = { Random.FRandRange(-5000.f, 5000.f), Random.FRandRange(-5000.f, 5000.f), 100.f, Random.FRandRange(0.f, 360.f), 0.f, 0.f };
+				Raw.Append(reinterpret_cast<const uint8*>(&Id), sizeof(Id));
+				Raw.Append(reinterpret_cast<const uint8*>(Transform), sizeof(Transform));
+			}
+
+			int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Gzip, Raw.Num());
+			TArray<uint8>& Frame = OutFrames.AddDefaulted_GetRef();
+			Frame.SetNumUninitialized(CompressedSize + 1);
+			Frame[0] = static_cast<uint8>(ECompressableQueryUpdateTag::Gzip);
+			if (!FCompression::CompressMemory(NAME_Gzip, Frame.GetData() + 1, CompressedSize, Raw.GetData(), Raw.Num()))
+			{
+				OutFrames.Pop();
+				continue;
+			}
+			Frame.SetNum(CompressedSize + 1);
+		}
+	}
+
+	static void DecodeFrames(const TArray<TArray<uint8>>& Frames, TMap<uint8, FDecodeTotals>& Totals)
+	{
+		for (const TArray<uint8>& Frame : Frames)
+		{
+			const uint8 Tag = Frame[0];
+			TArray<uint8> Payload(Frame.GetData() + 1, Frame.Num() - 1);
+			TArray<uint8> Decoded;
+
+			const uint64 Start = FPlatformTime::Cycles64();
+			const bool bOk = UE::SpacetimeDB::Compression::DecompressPayload(static_cast<ECompressableQueryUpdateTag>(Tag), Payload, Decoded);
+			const uint64 End = FPlatformTime::Cycles64();
+
+			FDecodeTotals& Total = Totals.FindOrAdd(Tag);
+			++Total.Frames;
+			Total.WireBytes += Frame.Num();
+			Total.DecodedBytes += Decoded.Num();
+			Total.Seconds += FPlatformTime::ToSeconds64(End - Start);
+			Total.Failures += bOk ? 0 : 1;
+		}
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FSpacetimeDBCompressionDecodeTest,
+	"SpacetimeDB.Performance.CompressionDecode",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+	bool FSpacetimeDBCompressionDecodeTest::RunTest(const FString& /*Parameters*/)
+{
+	using namespace SpacetimeDBPerf;
+
+	LOG_Category("Gzip vs Brotli decode");
+
+	// Recordings of the same session captured once per compression mode give a like-for-like comparison
+	const FString SessionDir = FPaths::ProjectSavedDir() / TEXT("SpacetimeDB/Sessions");
+	TArray<FString> Recordings;
+	IFileManager::Get().FindFiles(Recordings, *(SessionDir / TEXT("*.frames")), true, false);
+
+	TArray<TArray<uint8>> Frames;
+	for (const FString& Recording : Recordings)
+	{
+		LoadCapturedFrames(SessionDir / Recording, Frames);
+	}
+	if (Frames.Num() == 0)
+	{
+		LOG_INFO(TEXT("No recordings in %s, using a synthetic gzip session. Record with UWebsocketManager::StartFrameCapture to compare Brotli."), *SessionDir);
+		BuildSyntheticGzipSession(200, 2000, Frames);
+	}
+
+	TMap<uint8, FDecodeTotals> Totals;
+	DecodeFrames(Frames, Totals);
+
+	const UEnum* TagEnum = StaticEnum<ECompressableQueryUpdateTag>();
+	for (const TPair<uint8, FDecodeTotals>& Pair : Totals)
+	{
+		const FDecodeTotals& Total = Pair.Value;
+		LOG_INFO(TEXT("%s: %d frames, %lld bytes on the wire, %lld bytes decoded (ratio %.2f), %.1f MB/s, %d failures"),
+			*TagEnum->GetNameStringByValue(Pair.Key),
+			Total.Frames, Total.WireBytes, Total.DecodedBytes,
+			Total.WireBytes > 0 ? static_cast<double>(Total.DecodedBytes) / Total.WireBytes : 0.0,
+			Total.Seconds > 0.0 ? Total.DecodedBytes / Total.Seconds / (1024.0 * 1024.0) : 0.0,
+			Total.Failures);
+
+		if (Total.Failures > 0)
+		{
+			LOG_FAIL(TEXT("%s: %d frames failed to decode"), *TagEnum->GetNameStringByValue(Pair.Key), Total.Failures);
+		}
+	}
+
+	return true;
+}
+
+namespace SpacetimeDBPerf
+{
+	/** Same shape as the game's update_player_input arguments, six floats. */
+	struct FTransformArgs
+	{
+		float X = 0.0f;
+		float Y = 0.0f;
+		float Z = 0.0f;
+		float Yaw = 0.0f;
+		float Pitch = 0.0f;
+		float Roll = 0.0f;
+
+		bool operator==(const FTransformArgs& Other) const
+		{
+			return X == Other.X && Y == Other.Y && Z == Other.Z && Yaw == Other.Yaw && Pitch == Other.Pitch && Roll == Other.Roll;
+		}
+	};
+}
+
+namespace UE::SpacetimeDB
+{
+	UE_SPACETIMEDB_STRUCT(SpacetimeDBPerf::FTransformArgs, X, Y, Z, Yaw, Pitch, Roll);
+}
+
+namespace SpacetimeDBPerf
+{
+	/** Forwards to the wrapped allocator and counts the allocations, and their bytes, made by one thread. */
+	class FCountingMalloc final : public FMalloc
+	{
+	public:
+		explicit FCountingMalloc(FMalloc* InInner) : Inner(InInner) {}
+
+		virtual void* Malloc(SIZE_T Size, uint32 Alignment) override { Record(Size); return Inner->Malloc(Size, Alignment); }
+		virtual void* TryMalloc(SIZE_T Size, uint32 Alignment) override { Record(Size); return Inner->TryMalloc(Size, Alignment); }
+		virtual void* Realloc(void* Original, SIZE_T Size, uint32 Alignment) override { if (Size > 0) { Record(Size); } return Inner->Realloc(Original, Size, Alignment); }
+		virtual void* TryRealloc(void* Original, SIZE_T Size, uint32 Alignment) override { if (Size > 0) { Record(Size); } return Inner->TryRealloc(Original, Size, Alignment); }
+		virtual void Free(void* Original) override { Inner->Free(Original); }
+		virtual SIZE_T QuantizeSize(SIZE_T Size, uint32 Alignment) override { return Inner->QuantizeSize(Size, Alignment); }
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+		virtual void Trim(bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+		virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+		virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+		virtual bool ValidateHeap() override { return Inner->ValidateHeap(); }
+		virtual const TCHAR* GetDescriptiveName() override { return Inner->GetDescriptiveName(); }
+
+		/** Allocations of at least MinSize bytes made by the calling thread while running Body. */
+		int32 CountAllocations(TFunctionRef<void()> Body, SIZE_T MinSize = 0)
+		{
+			ThreadId = FPlatformTLS::GetCurrentThreadId();
+			MinRecordedSize = MinSize;
+			Allocations = 0;
+			AllocatedBytes = 0;
+			GMalloc = this;
+			Body();
+			GMalloc = Inner;
+			return Allocations;
+		}
+
+		/** Bytes requested by the allocations the last CountAllocations counted. */
+		SIZE_T GetCountedBytes() const { return AllocatedBytes; }
+
+	private:
+		void Record(SIZE_T Size)
+		{
+			if (FPlatformTLS::GetCurrentThreadId() == ThreadId && Size >= MinRecordedSize)
+			{
+				++Allocations;
+				AllocatedBytes += Size;
+			}
+		}
+
+		FMalloc* Inner;
+		std::atomic<uint32> ThreadId{ 0 };
+		SIZE_T MinRecordedSize = 0;
+		int32 Allocations = 0;
+		SIZE_T AllocatedBytes = 0;
+	};
+
+	/** Installed allocator proxy, never freed since other threads may still be inside it after it is removed. */
+	FCountingMalloc& GetCountingMalloc()
+	{
+		static FCountingMalloc* Proxy = new FCountingMalloc(GMalloc);
+		return *Proxy;
+	}
+
+	/** Previous send path: args serialized on their own, copied into FCallReducerType, then the whole message serialized again. */
+	TArray<uint8> SerializeCallReducerByMessage(const FString& Reducer, const FTransformArgs& Args, uint32 RequestId, uint8 Flags)
+	{
+		TArray<uint8> Bytes = UE::SpacetimeDB::Serialize(Args);
+		FCallReducerType MsgData;
+		MsgData.Reducer = Reducer;
+		MsgData.Args = Bytes;
+		MsgData.RequestId = RequestId;
+		MsgData.Flags = Flags;
+		return UE::SpacetimeDB::Serialize(FClientMessageType::CallReducer(MsgData));
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FSpacetimeDBReducerCallAllocationTest,
+	"SpacetimeDB.Performance.ReducerCallAllocations",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+	bool FSpacetimeDBReducerCallAllocationTest::RunTest(const FString& /*Parameters*/)
+{
+	using namespace SpacetimeDBPerf;
+
+	constexpr int32 Iterations = 1000;
+
+	LOG_Category("Heap allocations per update_player_input call");
+
+	const FString Reducer(TEXT("update_player_input"));
+	const FTransformArgs Args{ 1.0f, 2.0f, 3.0f, 90.0f, 0.0f, 0.0f };
+
+	// The envelope must match the message the previous path produced byte for byte
+	const TArray<uint8> Expected = SerializeCallReducerByMessage(Reducer, Args, 7, 1);
+	const TArrayView<const uint8> Written = UE::SpacetimeDB::WriteCallReducerMessage(Reducer, Args, 7, 1);
+	if (Written.Num() != Expected.Num() || FMemory::Memcmp(Written.GetData(), Expected.GetData(), Expected.Num()) != 0)
+	{
+		LOG_FAIL(TEXT("CallReducer envelope differs from the serialized FClientMessageType (%d vs %d bytes)"), Written.Num(), Expected.Num());
+		return false;
+	}
+
+	FCountingMalloc& Counter = GetCountingMalloc();
+	const auto Measure = [this, &Counter](const TCHAR* Name, TFunctionRef<void()> Call)
+	{
+		// First call sizes the thread's send buffer and any lazily created state
+		Call();
+		const uint64 Start = FPlatformTime::Cycles64();
+		const int32 Allocations = Counter.CountAllocations([&Call]()
+		{
+			for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+			{
+				Call();
+			}
+		});
+		const double Seconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - Start);
+		LOG_INFO(TEXT("%s: %.2f allocations per call, %.3f us per call"),
+			Name, static_cast<double>(Allocations) / Iterations, Seconds * 1e6 / Iterations);
+		return Allocations;
+	};
+
+	int64 BytesSent = 0;
+	Measure(TEXT("Serialize args, then FClientMessageType (previous path)"), [&]()
+	{
+		BytesSent += SerializeCallReducerByMessage(Reducer, Args, 7, 1).Num();
+	});
+
+	const int32 EnvelopeAllocations = Measure(TEXT("WriteCallReducerMessage"), [&]()
+	{
+		BytesSent += UE::SpacetimeDB::WriteCallReducerMessage(Reducer, Args, 7, 1).Num();
+	});
+	if (EnvelopeAllocations != 0)
+	{
+		LOG_FAIL(TEXT("WriteCallReducerMessage made %d heap allocations over %d calls"), EnvelopeAllocations, Iterations);
+	}
+
+	// Coalesced path used by the character: queue, then flush straight into the envelope
+	FOutgoingReducerScheduler Scheduler;
+	const auto IsSignificant = [](const FTransformArgs& LastSent, const FTransformArgs& Next) { return LastSent.X != Next.X; };
+	FTransformArgs Moving = Args;
+	const int32 CoalescedAllocations = Measure(TEXT("CallReducerCoalesced flush"), [&]()
+	{
+		Moving.X += 1.0f;
+		Scheduler.Queue(Reducer, 1, Moving, nullptr, IsSignificant);
+		Scheduler.Flush([&BytesSent](const FString& Name, UE::SpacetimeDB::FReducerArgsWriter WriteArgs, USetReducerFlagsBase* /*Flags*/)
+		{
+			BytesSent += UE::SpacetimeDB::WriteCallReducerMessage(Name, 7, 1, WriteArgs).Num();
+		});
+	});
+	if (CoalescedAllocations != 0)
+	{
+		LOG_FAIL(TEXT("Coalesced reducer call made %d heap allocations over %d calls"), CoalescedAllocations, Iterations);
+	}
+	if (Scheduler.GetStats().Sent != Iterations + 1)
+	{
+		LOG_FAIL(TEXT("Coalesced reducer call sent %lld of %d values"), Scheduler.GetStats().Sent, Iterations + 1);
+	}
+
+	LOG_INFO(TEXT("%lld bytes written in total"), BytesSent);
+	return true;
+}
+
+namespace SpacetimeDBPerf
+{
+	/** Typical small table row: integers, a position and a short name. */
+	struct FBenchRow
+	{
+		uint64 Id = 0;
+		int32 Score = 0;
+		float X = 0.0f;
+		float Y = 0.0f;
+		float Z = 0.0f;
+		FString Name;
+
+		bool operator==(const FBenchRow& Other) const
+		{
+			return Id == Other.Id && Score == Other.Score && X == Other.X && Y == Other.Y && Z == Other.Z && Name == Other.Name;
+		}
+	};
+}
+
+namespace UE::SpacetimeDB
+{
+	UE_SPACETIMEDB_STRUCT(SpacetimeDBPerf::FBenchRow, Id, Score, X, Y, Z, Name);
+}
+
+namespace SpacetimeDBPerf
+{
+	TArray<FBenchRow> BuildBenchRows(int32 NumRows)
+	{
+		TArray<FBenchRow> Rows;
+		Rows.Reserve(NumRows);
+		for (int32 Index = 0; Index < NumRows; ++Index)
+		{
+			FBenchRow& Row = Rows.AddDefaulted_GetRef();
+			Row.Id = static_cast<uint64>(Index) * 7919;
+			Row.Score = Index % 1000;
+			Row.X = Index * 0.5f;
+			Row.Y = Index * -0.25f;
+			Row.Z = 100.0f;
+			Row.Name = FString::Printf(TEXT("player_%d"), Index);
+		}
+		return Rows;
+	}
+
+	/** Previous UEWriter: core std::vector writer, strings through std::string, then a byte by byte copy into a TArray. */
+	TArray<uint8> WriteRowsWithCoreWriter(const TArray<FBenchRow>& Rows)
+	{
+		::SpacetimeDb::bsatn::Writer Writer;
+		Writer.write_u32_le(static_cast<uint32_t>(Rows.Num()));
+		for (const FBenchRow& Row : Rows)
+		{
+			Writer.write_u64_le(Row.Id);
+			Writer.write_i32_le(Row.Score);
+			Writer.write_f32_le(Row.X);
+			Writer.write_f32_le(Row.Y);
+			Writer.write_f32_le(Row.Z);
+			FTCHARToUTF8 Converter(*Row.Name);
+			Writer.write_string(std::string(Converter.Get(), Converter.Length()));
+		}
+		std::vector<uint8_t> Buffer = std::move(Writer).take_buffer();
+		TArray<uint8> Out;
+		Out.Reserve(static_cast<int32>(Buffer.size()));
+		for (uint8_t Byte : Buffer)
+		{
+			Out.Add(Byte);
+		}
+		return Out;
+	}
+
+	/** Previous UEReader: copy the input into a std::vector, strings through std::string. */
+	TArray<FBenchRow> ReadRowsWithCoreReader(const TArray<uint8>& Bytes)
+	{
+		const std::vector<uint8_t> Stored(Bytes.GetData(), Bytes.GetData() + Bytes.Num());
+		::SpacetimeDb::bsatn::Reader Reader(Stored);
+		const uint32 Count = Reader.read_u32_le();
+		TArray<FBenchRow> Rows;
+		Rows.Reserve(Count);
+		for (uint32 Index = 0; Index < Count; ++Index)
+		{
+			FBenchRow& Row = Rows.AddDefaulted_GetRef();
+			Row.Id = Reader.read_u64_le();
+			Row.Score = Reader.read_i32_le();
+			Row.X = Reader.read_f32_le();
+			Row.Y = Reader.read_f32_le();
+			Row.Z = Reader.read_f32_le();
+			const std::string Name = Reader.read_string();
+			Row.Name = FString(UTF8_TO_TCHAR(Name.c_str()));
+		}
+		return Rows;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FSpacetimeDBBsatnReaderWriterThroughputTest,
+	"SpacetimeDB.Performance.BsatnReaderWriterThroughput",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+	bool FSpacetimeDBBsatnReaderWriterThroughputTest::RunTest(const FString& /*Parameters*/)
+{
+	using namespace SpacetimeDBPerf;
+
+	constexpr int32 Iterations = 50;
+
+	LOG_Category("BSATN reader and writer throughput");
+
+	const TArray<FBenchRow> Rows = BuildBenchRows(10000);
+
+	const auto Measure = [this](const TCHAR* Name, int64 BytesPerIteration, TFunctionRef<void()> Body)
+	{
+		Body();
+		const uint64 Start = FPlatformTime::Cycles64();
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			Body();
+		}
+		const double Seconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - Start);
+		const double MBPerSecond = static_cast<double>(BytesPerIteration) * Iterations / (1024.0 * 1024.0) / FMath::Max(Seconds, 1e-9);
+		LOG_INFO(TEXT("%s: %.1f MB/s"), Name, MBPerSecond);
+		return MBPerSecond;
+	};
+
+	// Both writers must produce the same bytes
+	const TArray<uint8> Expected = WriteRowsWithCoreWriter(Rows);
+	TArray<uint8> Buffer;
+	{
+		UE::SpacetimeDB::UEWriter Writer(Buffer);
+		UE::SpacetimeDB::serialize(Writer, Rows);
+	}
+	if (Buffer != Expected)
+	{
+		LOG_FAIL(TEXT("UEWriter output differs from the core writer (%d vs %d bytes)"), Buffer.Num(), Expected.Num());
+		return false;
+	}
+
+	Measure(TEXT("Write, core Writer + TArray copy (previous)"), Expected.Num(), [&]()
+	{
+		const TArray<uint8> Out = WriteRowsWithCoreWriter(Rows);
+		check(Out.Num() == Expected.Num());
+	});
+	Measure(TEXT("Write, UEWriter into a reused caller TArray"), Expected.Num(), [&]()
+	{
+		Buffer.Reset();
+		UE::SpacetimeDB::UEWriter Writer(Buffer);
+		UE::SpacetimeDB::serialize(Writer, Rows);
+	});
+
+	if (ReadRowsWithCoreReader(Expected) != Rows || UE::SpacetimeDB::Deserialize<TArray<FBenchRow>>(Expected) != Rows)
+	{
+		LOG_FAIL(TEXT("Decoded rows differ from the rows written"));
+		return false;
+	}
+
+	Measure(TEXT("Read, std::vector copy + core Reader (previous)"), Expected.Num(), [&]()
+	{
+		const TArray<FBenchRow> Out = ReadRowsWithCoreReader(Expected);
+		check(Out.Num() == Rows.Num());
+	});
+	Measure(TEXT("Read, UEReader borrowing the TArray"), Expected.Num(), [&]()
+	{
+		UE::SpacetimeDB::UEReader Reader(Expected);
+		const TArray<FBenchRow> Out = Reader.read_array<FBenchRow>();
+		check(Out.Num() == Rows.Num());
+	});
+
+	return true;
+}
+
+namespace SpacetimeDBPerf
+{
+	/** Element by element encoding, what write_array did for every element type before the bulk path. */
+	template<typename T>
+	void WriteArrayPerElement(UE::SpacetimeDB::UEWriter& Writer, const TArray<T>& Values)
+	{
+		Writer.write_u32(static_cast<uint32>(Values.Num()));
+		for (const T& Value : Values)
+		{
+			UE::SpacetimeDB::serialize(Writer, Value);
+		}
+	}
+
+	/** Element by element decoding, what read_array did for every element type before the bulk path. */
+	template<typename T>
+	TArray<T> ReadArrayPerElement(UE::SpacetimeDB::UEReader& Reader)
+	{
+		const uint32 Count = Reader.read_u32();
+		TArray<T> Values;
+		Values.Reserve(Count);
+		for (uint32 Index = 0; Index < Count; ++Index)
+		{
+			Values.Add(UE::SpacetimeDB::deserialize<T>(Reader));
+		}
+		return Values;
+	}
+
+	/** Measures per-element and bulk encode and decode of a ByteSize array of T. Returns false if the encodings differ. */
+	template<typename T>
+	bool MeasureArrayThroughput(const TCHAR* TypeName, int32 ByteSize, FString& OutSummary)
+	{
+		const int32 Count = ByteSize / static_cast<int32>(sizeof(T));
+		TArray<T> Values;
+		Values.SetNumUninitialized(Count);
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			Values[Index] = static_cast<T>(Index * 31 + 7);
+		}
+
+		TArray<uint8> Bulk;
+		TArray<uint8> PerElement;
+		{
+			UE::SpacetimeDB::UEWriter BulkWriter(Bulk);
+			BulkWriter.write_array(Values);
+			UE::SpacetimeDB::UEWriter PerElementWriter(PerElement);
+			WriteArrayPerElement(PerElementWriter, Values);
+		}
+		if (Bulk != PerElement)
+		{
+			return false;
+		}
+		UE::SpacetimeDB::UEReader CheckReader(Bulk);
+		if (CheckReader.read_array<T>() != Values)
+		{
+			return false;
+		}
+
+		// Enough passes to move about 64 MB per measurement
+		const int32 Passes = FMath::Max(1, (64 << 20) / ByteSize);
+		TArray<uint8> Scratch;
+		Scratch.Reserve(Bulk.Num());
+		const auto MBPerSecond = [ByteSize, Passes](uint64 Cycles)
+		{
+			return static_cast<double>(ByteSize) * Passes / (1024.0 * 1024.0) / FMath::Max(FPlatformTime::ToSeconds64(Cycles), 1e-9);
+		};
+		const auto Time = [Passes](TFunctionRef<void()> Body)
+		{
+			const uint64 Start = FPlatformTime::Cycles64();
+			for (int32 Pass = 0; Pass < Passes; ++Pass)
+			{
+				Body();
+			}
+			return FPlatformTime::Cycles64() - Start;
+		};
+
+		const uint64 WritePerElement = Time([&]() { Scratch.Reset(); UE::SpacetimeDB::UEWriter Writer(Scratch); WriteArrayPerElement(Writer, Values); });
+		const uint64 WriteBulk = Time([&]() { Scratch.Reset(); UE::SpacetimeDB::UEWriter Writer(Scratch); Writer.write_array(Values); });
+		int64 Checksum = 0;
+		const uint64 ReadPerElement = Time([&]() { UE::SpacetimeDB::UEReader Reader(Bulk); Checksum += ReadArrayPerElement<T>(Reader).Num(); });
+		const uint64 ReadBulk = Time([&]() { UE::SpacetimeDB::UEReader Reader(Bulk); Checksum += Reader.read_array<T>().Num(); });
+
+		OutSummary = FString::Printf(TEXT("%s[%d KB]: write %.0f -> %.0f MB/s, read %.0f -> %.0f MB/s (%lld elements decoded)"),
+			TypeName, ByteSize / 1024, MBPerSecond(WritePerElement), MBPerSecond(WriteBulk),
+			MBPerSecond(ReadPerElement), MBPerSecond(ReadBulk), Checksum);
+		return true;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FSpacetimeDBBsatnBulkArrayTest,
+	"SpacetimeDB.Performance.BsatnBulkArrays",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+	bool FSpacetimeDBBsatnBulkArrayTest::RunTest(const FString& /*Parameters*/)
+{
+	using namespace SpacetimeDBPerf;
+
+	LOG_Category("Arithmetic array encode and decode, per element -> bulk");
+
+	const auto Run = [this](const TCHAR* TypeName, int32 ByteSize, TFunctionRef<bool(const TCHAR*, int32, FString&)> Measure)
+	{
+		FString Summary;
+		if (!Measure(TypeName, ByteSize, Summary))
+		{
+			LOG_FAIL(TEXT("Bulk %s array encoding does not match the per element encoding at %d bytes"), TypeName, ByteSize);
+			return false;
+		}
+		LOG_INFO(TEXT("%s"), *Summary);
+		return true;
+	};
+
+	bool bOk = true;
+	for (const int32 ByteSize : { 1 << 10, 64 << 10, 4 << 20 })
+	{
+		bOk &= Run(TEXT("uint8"), ByteSize, &MeasureArrayThroughput<uint8>);
+		bOk &= Run(TEXT("uint32"), ByteSize, &MeasureArrayThroughput<uint32>);
+		bOk &= Run(TEXT("uint64"), ByteSize, &MeasureArrayThroughput<uint64>);
+		bOk &= Run(TEXT("float"), ByteSize, &MeasureArrayThroughput<float>);
+	}
+	return bOk;
+}
+
+namespace SpacetimeDBPerf
+{
+	/** Previous row list parse: every row copied into its own slice array, which the row then kept. */
+	template<typename RowType>
+	void ParseRowListWithSlices(const FBsatnRowListType& List, TArray<TPair<TArray<uint8>, RowType>>& OutRows)
+	{
+		const auto AddSlice = [&List, &OutRows](int64 Start, int64 Length)
+		{
+			TArray<uint8> Slice;
+			Slice.Append(List.RowsData.GetData() + Start, Length);
+			RowType Row = UE::SpacetimeDB::Deserialize<RowType>(Slice);
+			OutRows.Add(TPair<TArray<uint8>, RowType>(Slice, Row));
+		};
+		if (List.SizeHint.IsFixedSize())
+		{
+			const int32 Size = List.SizeHint.GetAsFixedSize();
+			for (int32 i = 0; i < List.RowsData.Num() / Size; ++i)
+			{
+				AddSlice(i * Size, Size);
+			}
+			return;
+		}
+		const TArray<uint64>& Offsets = List.SizeHint.GetAsRowOffsets();
+		for (int32 i = 0; i < Offsets.Num(); ++i)
+		{
+			const int64 End = (i + 1 < Offsets.Num()) ? Offsets[i + 1] : List.RowsData.Num();
+			AddSlice(Offsets[i], End - Offsets[i]);
+		}
+	}
+
+	/** Encode Rows as one row list, fixed size when every row has the same length. */
+	template<typename RowType>
+	FBsatnRowListType MakeRowList(const TArray<RowType>& Rows, bool bFixedSize)
+	{
+		FBsatnRowListType List;
+		TArray<uint64> Offsets;
+		UE::SpacetimeDB::UEWriter Writer(List.RowsData);
+		for (const RowType& Row : Rows)
+		{
+			Offsets.Add(Writer.size());
+			UE::SpacetimeDB::serialize(Writer, Row);
+		}
+		List.SizeHint = bFixedSize
+			? FRowSizeHintType::FixedSize(static_cast<uint16>(List.RowsData.Num() / Rows.Num()))
+			: FRowSizeHintType::RowOffsets(Offsets);
+		return List;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FSpacetimeDBRowListArenaTest,
+	"SpacetimeDB.Performance.RowListArena",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+	bool FSpacetimeDBRowListArenaTest::RunTest(const FString& /*Parameters*/)
+{
+	using namespace SpacetimeDBPerf;
+
+	constexpr int32 RowCount = 10000;
+
+	LOG_Category("Row list decode of a 10k row subscription, per row slices -> shared arena");
+
+	TArray<FTransformArgs> Transforms;
+	TArray<FBenchRow> BenchRows;
+	for (int32 i = 0; i < RowCount; ++i)
+	{
+		Transforms.Add(FTransformArgs{ float(i), float(i) * 2.0f, 3.0f, 0.0f, 0.0f, float(i % 360) });
+		BenchRows.Add(FBenchRow{ uint64(i), i * 7, float(i), 0.0f, 1.0f, FString::Printf(TEXT("Player_%d"), i) });
+	}
+
+	FCountingMalloc& Counter = GetCountingMalloc();
+	bool bOk = true;
+
+	const auto Compare = [this, &Counter, &bOk](const TCHAR* Name, const auto& Rows, const FBsatnRowListType& List)
+	{
+		using RowType = typename TDecay<decltype(Rows)>::Type::ElementType;
+
+		TArray<TPair<TArray<uint8>, RowType>> Sliced;
+		uint64 Start = FPlatformTime::Cycles64();
+		const int32 SliceAllocations = Counter.CountAllocations([&]() { ParseRowListWithSlices<RowType>(List, Sliced); });
+		const double SliceSeconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - Start);
+
+		TArray<FWithBsatn<RowType>> Parsed;
+		Start = FPlatformTime::Cycles64();
+		const int32 ArenaAllocations = Counter.CountAllocations([&]() { UE::SpacetimeDB::ParseRowListWithBsatn<RowType>(List, Parsed); });
+		const double ArenaSeconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - Start);
+
+		LOG_INFO(TEXT("%s: %d -> %d allocations, %.2f -> %.2f ms"), Name, SliceAllocations, ArenaAllocations, SliceSeconds * 1e3, ArenaSeconds * 1e3);
+
+		if (Parsed.Num() != Rows.Num() || Sliced.Num() != Rows.Num())
+		{
+			LOG_FAIL(TEXT("%s: decoded %d rows from the arena and %d from slices, expected %d"), Name, Parsed.Num(), Sliced.Num(), Rows.Num());
+			bOk = false;
+			return;
+		}
+		for (int32 i = 0; i < Parsed.Num(); ++i)
+		{
+			if (Parsed[i].Arena != Parsed[0].Arena || !(FRowKey(Sliced[i].Key) == Parsed[i].GetKey()) || !(Parsed[i].Row == Sliced[i].Value))
+			{
+				LOG_FAIL(TEXT("%s: row %d differs between the arena and slice decodes"), Name, i);
+				bOk = false;
+				return;
+			}
+		}
+
+		// The cache must find rows stored under owned keys from the arena views
+		UClientCache<RowType> Cache;
+		Cache.GetOrAdd(TEXT("bench"));
+		Cache.ApplyDiff(TEXT("bench"), TArray<FWithBsatn<RowType>>(Parsed), {});
+		const int32 Cached = Cache.Table->Entries.Num();
+		Cache.ApplyDiff(TEXT("bench"), {}, Parsed);
+		if (Cached != Rows.Num() || Cache.Table->Entries.Num() != 0)
+		{
+			LOG_FAIL(TEXT("%s: cache held %d of %d rows after insert and %d after delete"), Name, Cached, Rows.Num(), Cache.Table->Entries.Num());
+			bOk = false;
+		}
+	};
+
+	Compare(TEXT("Fixed size rows"), Transforms, MakeRowList(Transforms, true));
+	Compare(TEXT("Row offset rows"), BenchRows, MakeRowList(BenchRows, false));
+
+	// Offsets past INT64_MAX would turn negative once narrowed, they must be rejected instead of read
+	FBsatnRowListType Malformed = MakeRowList(BenchRows, false);
+	TArray<uint64> BadOffsets = Malformed.SizeHint.GetAsRowOffsets();
+	BadOffsets[1] = uint64(MAX_int64) + 2;
+	Malformed.SizeHint = FRowSizeHintType::RowOffsets(BadOffsets);
+	TArray<FWithBsatn<FBenchRow>> MalformedRows;
+	AddExpectedError(TEXT("out of range"), EAutomationExpectedErrorFlags::Contains, 1);
+	UE::SpacetimeDB::ParseRowListWithBsatn<FBenchRow>(Malformed, MalformedRows);
+	if (MalformedRows.Num() != 0)
+	{
+		LOG_FAIL(TEXT("Row list with an offset past INT64_MAX decoded %d rows"), MalformedRows.Num());
+		bOk = false;
+	}
+	return bOk;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FSpacetimeDBRowKeyHashTest,
+	"SpacetimeDB.Performance.RowKeyHash",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+	bool FSpacetimeDBRowKeyHashTest::RunTest(const FString& /*Parameters*/)
+{
+	using namespace SpacetimeDBPerf;
+
+	constexpr int64 BytesPerRun = 64 << 20;
+
+	LOG_Category("Row key hashing, CRC32 -> XXH3");
+
+	bool bOk = true;
+	for (const int32 RowSize : { 24, 64, 256, 4096 })
+	{
+		TArray<uint8> Row;
+		Row.SetNumUninitialized(RowSize);
+		for (int32 i = 0; i < RowSize; ++i)
+		{
+			Row[i] = static_cast<uint8>(i * 31 + 7);
+		}
+
+		const int64 Rows = BytesPerRun / RowSize;
+		const auto Measure = [&Row, Rows](TFunctionRef<uint32(TArrayView<const uint8>)> Hash, uint32& OutChecksum)
+		{
+			const uint64 Start = FPlatformTime::Cycles64();
+			for (int64 i = 0; i < Rows; ++i)
+			{
+				Row[0] = static_cast<uint8>(i);
+				OutChecksum ^= Hash(Row);
+			}
+			return FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - Start);
+		};
+
+		uint32 Checksum = 0;
+		const double CrcSeconds = Measure([](TArrayView<const uint8> Bytes) { return FCrc::MemCrc32(Bytes.GetData(), Bytes.Num()); }, Checksum);
+		const double XxhSeconds = Measure([](TArrayView<const uint8> Bytes) { return HashRowBytes(Bytes); }, Checksum);
+		LOG_INFO(TEXT("%d byte rows: %.1f -> %.1f Mrows/s (checksum %08x)"),
+			RowSize, Rows / CrcSeconds / 1e6, Rows / XxhSeconds / 1e6, Checksum);
+
+		// The hash computed at decode time is the one the cache key carries
+		const FWithBsatn<int32> Decoded(Row, 0);
+		const FRowKey Key(Decoded.GetKey());
+		if (Decoded.Hash != HashRowBytes(Row) || GetTypeHash(Key) != Decoded.Hash || !(Key == Decoded.GetKey()))
+		{
+			LOG_FAIL(TEXT("%d byte row: key hash does not match the decoded row hash"), RowSize);
+			bOk = false;
+		}
+	}
+	return bOk;
+}
+
+namespace SpacetimeDBPerf
+{
+	/** Same shape as the game's entities row. */
+	struct FEntityRow
+	{
+		uint32 EntityId = 0;
+		FString EntityType;
+		FTransformArgs Transform;
+
+		bool operator==(const FEntityRow& Other) const
+		{
+			return EntityId == Other.EntityId && EntityType == Other.EntityType && Transform == Other.Transform;
+		}
+	};
+
+	/** Declares the primary key the way the generated entities table does. */
+	struct FEntityRowTable
+	{
+		using FPrimaryKey = uint32;
+		static const uint32& GetPrimaryKey(const FEntityRow& Row) { return Row.EntityId; }
+	};
+}
+
+namespace UE::SpacetimeDB
+{
+	UE_SPACETIMEDB_STRUCT(SpacetimeDBPerf::FEntityRow, EntityId, EntityType, Transform);
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FSpacetimeDBPrimaryKeyCacheTest,
+	"SpacetimeDB.Performance.PrimaryKeyCache",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+	bool FSpacetimeDBPrimaryKeyCacheTest::RunTest(const FString& /*Parameters*/)
+{
+	using namespace SpacetimeDBPerf;
+	using namespace UE::SpacetimeDB;
+
+	constexpr int32 RowCount = 100000;
+
+	LOG_Category("Cache memory per 100k entities, row keyed -> primary keyed");
+
+	TArray<FEntityRow> Rows;
+	for (int32 i = 0; i < RowCount; ++i)
+	{
+		Rows.Add(FEntityRow{ uint32(i), TEXT("npc"), FTransformArgs{ float(i), 0.0f, 0.0f, 0.0f, 0.0f, 0.0f } });
+	}
+	const FBsatnRowListType List = MakeRowList(Rows, false);
+
+	// Entity 7 moves: one delete of the old row and one insert of the new one
+	FEntityRow Moved = Rows[7];
+	Moved.Transform.X += 100.0f;
+	const FBsatnRowListType MoveDeletes = MakeRowList(TArray<FEntityRow>{ Rows[7] }, false);
+	const FBsatnRowListType MoveInserts = MakeRowList(TArray<FEntityRow>{ Moved }, false);
+
+	bool bOk = true;
+	const auto Measure = [&](const TCHAR* Name, const TRowKeyWriter<FEntityRow>& WriteKey, bool bExpectInPlaceUpdate)
+	{
+		TArray<FWithBsatn<FEntityRow>> Inserts;
+		ParseRowListWithBsatn(List, Inserts, WriteKey);
+
+		UClientCache<FEntityRow> Cache;
+		Cache.GetOrAdd(TEXT("entities"));
+		const uint64 Start = FPlatformTime::Cycles64();
+		const FTableAppliedDiff<FEntityRow> InitialDiff = Cache.ApplyDiff(TEXT("entities"), MoveTemp(Inserts), {});
+		const double ApplySeconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - Start);
+
+		const SIZE_T CacheBytes = Cache.Table->GetAllocatedSize();
+		SIZE_T DiffKeyBytes = InitialDiff.Inserts.GetAllocatedSize();
+		for (const TPair<FRowKey, TSharedPtr<const FEntityRow>>& Pair : InitialDiff.Inserts)
+		{
+			DiffKeyBytes += Pair.Key.Bytes.GetAllocatedSize();
+		}
+		LOG_INFO(TEXT("%s: cache %.2f MB (%.1f bytes per row), initial diff %.2f MB, apply %.2f ms"),
+			Name, CacheBytes / (1024.0 * 1024.0), double(CacheBytes) / RowCount, DiffKeyBytes / (1024.0 * 1024.0), ApplySeconds * 1e3);
+
+		TArray<FWithBsatn<FEntityRow>> UpdateInserts, UpdateDeletes;
+		ParseRowListWithBsatn(MoveInserts, UpdateInserts, WriteKey);
+		ParseRowListWithBsatn(MoveDeletes, UpdateDeletes, WriteKey);
+		const FRowKey MovedKey(UpdateInserts[0].GetKey());
+		const FTableAppliedDiff<FEntityRow> UpdateDiff = Cache.ApplyDiff(TEXT("entities"), MoveTemp(UpdateInserts), UpdateDeletes);
+
+		const FRowEntry<FEntityRow>* Entry = Cache.Table->Entries.Find(MovedKey);
+		if (Cache.Table->Entries.Num() != RowCount || !Entry || !(*Entry->Row == Moved))
+		{
+			LOG_FAIL(TEXT("%s: moved entity missing from the cache or row count changed to %d"), Name, Cache.Table->Entries.Num());
+			bOk = false;
+		}
+		const bool bInPlace = UpdateDiff.UpdateInserts.Num() == 1 && UpdateDiff.Inserts.IsEmpty() && UpdateDiff.Deletes.IsEmpty();
+		if (bInPlace != bExpectInPlaceUpdate)
+		{
+			LOG_FAIL(TEXT("%s: move applied as %d inserts, %d deletes and %d updates"),
+				Name, UpdateDiff.Inserts.Num(), UpdateDiff.Deletes.Num(), UpdateDiff.UpdateInserts.Num());
+			bOk = false;
+		}
+		return CacheBytes;
+	};
+
+	const SIZE_T RowKeyed = Measure(TEXT("Row keyed"), TRowKeyWriter<FEntityRow>(), false);
+	const SIZE_T PrimaryKeyed = Measure(TEXT("Primary keyed"), MakeRowKeyWriter<FEntityRow, FEntityRowTable>(), true);
+	LOG_INFO(TEXT("Primary keyed cache uses %.0f%% of the row keyed cache"), 100.0 * PrimaryKeyed / RowKeyed);
+	if (PrimaryKeyed >= RowKeyed)
+	{
+		LOG_FAIL(TEXT("Primary keyed cache is not smaller (%llu vs %llu bytes)"), uint64(PrimaryKeyed), uint64(RowKeyed));
+		bOk = false;
+	}
+
+	// Two overlapping subscriptions hold entity 7, the move arrives once per subscription
+	{
+		const TRowKeyWriter<FEntityRow> WriteKey = MakeRowKeyWriter<FEntityRow, FEntityRowTable>();
+		const FBsatnRowListType Twice = MakeRowList(TArray<FEntityRow>{ Rows[7], Rows[7] }, false);
+		const FBsatnRowListType MovedTwice = MakeRowList(TArray<FEntityRow>{ Moved, Moved }, false);
+		TArray<FWithBsatn<FEntityRow>> Inserts, Deletes;
+		ParseRowListWithBsatn(Twice, Inserts, WriteKey);
+
+		UClientCache<FEntityRow> Cache;
+		Cache.GetOrAdd(TEXT("entities"));
+		Cache.ApplyDiff(TEXT("entities"), MoveTemp(Inserts), {});
+
+		Inserts.Reset();
+		ParseRowListWithBsatn(MovedTwice, Inserts, WriteKey);
+		ParseRowListWithBsatn(Twice, Deletes, WriteKey);
+		const FRowKey MovedKey(Inserts[0].GetKey());
+		const FTableAppliedDiff<FEntityRow> Diff = Cache.ApplyDiff(TEXT("entities"), MoveTemp(Inserts), Deletes);
+
+		const FRowEntry<FEntityRow>* Entry = Cache.Table->Entries.Find(MovedKey);
+		if (Diff.UpdateInserts.Num() != 1 || Diff.UpdateDeletes.Num() != 1 || !Diff.Inserts.IsEmpty() || !Diff.Deletes.IsEmpty())
+		{
+			LOG_FAIL(TEXT("Overlapping subscriptions: move applied as %d inserts, %d deletes and %d updates"),
+				Diff.Inserts.Num(), Diff.Deletes.Num(), Diff.UpdateInserts.Num());
+			bOk = false;
+		}
+		else if (!Entry || Entry->RefCount != 2 || Entry->bReplacedInDiff || !(*Entry->Row == Moved))
+		{
+			LOG_FAIL(TEXT("Overlapping subscriptions: moved entity has %d references after the update"), Entry ? Entry->RefCount : 0);
+			bOk = false;
+		}
+	}
+	return bOk;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FSpacetimeDBSharedRowInstanceTest,
+	"SpacetimeDB.Performance.SharedRowInstance",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+	bool FSpacetimeDBSharedRowInstanceTest::RunTest(const FString& /*Parameters*/)
+{
+	using namespace SpacetimeDBPerf;
+	using namespace UE::SpacetimeDB;
+
+	constexpr int32 RowCount = 10000;
+	constexpr int32 MovedCount = 1000;
+
+	LOG_Category("Row instances shared by the cache entry, its indices and the diff");
+
+	TArray<FEntityRow> Rows, Moved;
+	for (int32 i = 0; i < RowCount; ++i)
+	{
+		Rows.Add(FEntityRow{ uint32(i), i % 2 ? TEXT("npc") : TEXT("player"), FTransformArgs{ float(i), 0.0f, 0.0f, 0.0f, 0.0f, 0.0f } });
+	}
+	for (int32 i = 0; i < MovedCount; ++i)
+	{
+		Moved.Add(Rows[i]);
+		Moved.Last().Transform.Y += 1.0f;
+	}
+
+	const TRowKeyWriter<FEntityRow> WriteKey = MakeRowKeyWriter<FEntityRow, FEntityRowTable>();
+	TArray<FWithBsatn<FEntityRow>> Inserts, MoveInserts, MoveDeletes;
+	ParseRowListWithBsatn(MakeRowList(Rows, false), Inserts, WriteKey);
+	ParseRowListWithBsatn(MakeRowList(Moved, false), MoveInserts, WriteKey);
+	ParseRowListWithBsatn(MakeRowList(TArray<FEntityRow>(Rows.GetData(), MovedCount), false), MoveDeletes, WriteKey);
+
+	UClientCache<FEntityRow> Cache;
+	TSharedPtr<FTableCache<FEntityRow>> Table = Cache.GetOrAdd(TEXT("entities"));
+	Table->AddUniqueConstraint<uint32>(TEXT("entity_id"), [](const FEntityRow& Row) { return Row.EntityId; });
+	Table->AddMultiKeyBTreeIndex<FString>(TEXT("entity_type"), [](const FEntityRow& Row) { return Row.EntityType; });
+	Cache.ApplyDiff(TEXT("entities"), MoveTemp(Inserts), {});
+
+	FTableAppliedDiff<FEntityRow> Diff;
+	const int32 Allocations = GetCountingMalloc().CountAllocations([&]()
+	{
+		Diff = Cache.ApplyDiff(TEXT("entities"), MoveTemp(MoveInserts), MoveDeletes);
+	});
+	LOG_INFO(TEXT("%.2f heap allocations per updated row with one unique and one B-tree index"), double(Allocations) / MovedCount);
+
+	if (Diff.UpdateInserts.Num() != MovedCount)
+	{
+		LOG_FAIL(TEXT("Expected %d updates, got %d"), MovedCount, Diff.UpdateInserts.Num());
+		return false;
+	}
+	for (int32 i = 0; i < Diff.UpdateInserts.Num(); ++i)
+	{
+		const FEntityRow* Updated = Diff.UpdateInserts[i].Get();
+		const FEntityRow* Indexed = Table->FindByUniqueIndex<uint32>(TEXT("entity_id"), Updated->EntityId);
+		const FRowEntry<FEntityRow>* Entry = Table->Entries.Find(FRowKey(Serialize(Updated->EntityId)));
+		if (!Entry || Entry->Row.Get() != Updated || Indexed != Updated)
+		{
+			LOG_FAIL(TEXT("Entity %u is held by more than one row instance"), Updated->EntityId);
+			return false;
+		}
+	}
+
+	TArray<FEntityRow> Players;
+	Table->FindByMultiKeyBTreeIndex<FString>(Players, TEXT("entity_type"), TEXT("player"));
+	if (Players.Num() != RowCount / 2)
+	{
+		LOG_FAIL(TEXT("B-tree index returned %d of %d player rows after the update"), Players.Num(), RowCount / 2);
+		return false;
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FSpacetimeDBOrderedIndexTest,
+	"SpacetimeDB.Performance.OrderedIndex",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+	bool FSpacetimeDBOrderedIndexTest::RunTest(const FString& /*Parameters*/)
+{
+	using namespace SpacetimeDBPerf;
+	using namespace UE::SpacetimeDB;
+
+	constexpr int32 RowCount = 100000;
+	constexpr int32 ChurnCount = 1000;
+	constexpr int32 RangeSize = 1000;
+	constexpr int32 QueryCount = 100;
+	const TCHAR* Types[] = { TEXT("npc"), TEXT("player"), TEXT("item"), TEXT("vehicle") };
+
+	LOG_Category("Ordered B-tree index: key ranges, tuple prefixes and batched diff merges");
+
+	// Even ids only, so the churn below can insert new ids between existing ones
+	TArray<FEntityRow> Rows, Moved, Added;
+	for (int32 i = 0; i < RowCount; ++i)
+	{
+		Rows.Add(FEntityRow{ uint32(i * 2), Types[i % 4], FTransformArgs{ float(i), 0.0f, 0.0f, 0.0f, 0.0f, 0.0f } });
+	}
+	for (int32 i = 0; i < ChurnCount; ++i)
+	{
+		Moved.Add(Rows[i * 7]);
+		Moved.Last().Transform.Z += 1.0f;
+		Added.Add(FEntityRow{ uint32(i * 14 + 1), TEXT("player"), FTransformArgs{} });
+	}
+
+	const TRowKeyWriter<FEntityRow> WriteKey = MakeRowKeyWriter<FEntityRow, FEntityRowTable>();
+	TArray<FWithBsatn<FEntityRow>> Inserts, MoveInserts, MoveDeletes, AddInserts;
+	ParseRowListWithBsatn(MakeRowList(Rows, false), Inserts, WriteKey);
+	ParseRowListWithBsatn(MakeRowList(Moved, false), MoveInserts, WriteKey);
+	ParseRowListWithBsatn(MakeRowList(Moved, false), MoveDeletes, WriteKey);
+	ParseRowListWithBsatn(MakeRowList(Added, false), AddInserts, WriteKey);
+	for (FWithBsatn<FEntityRow>& Delete : MoveDeletes)
+	{
+		// Deletes carry the previous row values
+		Delete.Row.Transform.Z -= 1.0f;
+	}
+
+	using FIdKey = TTuple<uint32>;
+	using FTypeIdKey = TTuple<FString, uint32>;
+	UClientCache<FEntityRow> Cache;
+	TSharedPtr<FTableCache<FEntityRow>> Table = Cache.GetOrAdd(TEXT("entities"));
+	Table->AddMultiKeyBTreeIndex<FIdKey>(TEXT("entity_id"), [](const FEntityRow& Row) { return MakeTuple(Row.EntityId); });
+	Table->AddMultiKeyBTreeIndex<FTypeIdKey>(TEXT("type_id"), [](const FEntityRow& Row) { return MakeTuple(Row.EntityType, Row.EntityId); });
+
+	uint64 Start = FPlatformTime::Cycles64();
+	Cache.ApplyDiff(TEXT("entities"), MoveTemp(Inserts), {});
+	LOG_INFO(TEXT("Initial apply of %d rows with two ordered indices: %.2f ms"), RowCount, FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - Start) * 1e3);
+
+	Start = FPlatformTime::Cycles64();
+	Cache.ApplyDiff(TEXT("entities"), MoveTemp(MoveInserts), MoveDeletes);
+	LOG_INFO(TEXT("%d in place updates: %.3f ms"), ChurnCount, FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - Start) * 1e3);
+
+	Start = FPlatformTime::Cycles64();
+	Cache.ApplyDiff(TEXT("entities"), MoveTemp(AddInserts), {});
+	LOG_INFO(TEXT("%d inserts between existing keys, merged once: %.3f ms"), ChurnCount, FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - Start) * 1e3);
+
+	// Id range [Lower, Lower + RangeSize) through the index and through a scan of every entry
+	TArray<FEntityRow> Found, Scanned;
+	double IndexSeconds = 0.0, ScanSeconds = 0.0;
+	for (int32 Query = 0; Query < QueryCount; ++Query)
+	{
+		const uint32 Lower = uint32(Query) * (RowCount * 2 / QueryCount);
+		const uint32 Upper = Lower + RangeSize;
+
+		Start = FPlatformTime::Cycles64();
+		Table->FindRangeByMultiKeyBTreeIndex<FIdKey>(Found, TEXT("entity_id"), MakeTuple(Lower), MakeTuple(Upper));
+		IndexSeconds += FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - Start);
+
+		Start = FPlatformTime::Cycles64();
+		Scanned.Reset();
+		for (const TPair<FRowKey, FRowEntry<FEntityRow>>& Pair : Table->Entries)
+		{
+			if (Pair.Value.Row->EntityId >= Lower && Pair.Value.Row->EntityId < Upper)
+			{
+				Scanned.Add(*Pair.Value.Row);
+			}
+		}
+		Scanned.Sort([](const FEntityRow& A, const FEntityRow& B) { return A.EntityId < B.EntityId; });
+		ScanSeconds += FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - Start);
+
+		if (Found.Num() != Scanned.Num())
+		{
+			LOG_FAIL(TEXT("Range [%u, %u) returned %d rows, the scan found %d"), Lower, Upper, Found.Num(), Scanned.Num());
+			return false;
+		}
+		for (int32 i = 0; i < Found.Num(); ++i)
+		{
+			if (!(Found[i] == Scanned[i]))
+			{
+				LOG_FAIL(TEXT("Range [%u, %u) differs from the scan at row %d (entity %u)"), Lower, Upper, i, Found[i].EntityId);
+				return false;
+			}
+		}
+	}
+	LOG_INFO(TEXT("Id range of %d keys: index %.3f us, scan %.3f us per query (%.0fx)"),
+		RangeSize, IndexSeconds * 1e6 / QueryCount, ScanSeconds * 1e6 / QueryCount, ScanSeconds / FMath::Max(IndexSeconds, 1e-9));
+
+	// Every player ordered by id, through the leading element of the composite key
+	Start = FPlatformTime::Cycles64();
+	Table->FindPrefixByMultiKeyBTreeIndex<FTypeIdKey>(Found, TEXT("type_id"), MakeTuple(FString(TEXT("player"))));
+	LOG_INFO(TEXT("Prefix query returned %d players in %.3f ms"), Found.Num(), FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - Start) * 1e3);
+
+	const int32 ExpectedPlayers = RowCount / 4 + ChurnCount;
+	if (Found.Num() != ExpectedPlayers)
+	{
+		LOG_FAIL(TEXT("Prefix query returned %d of %d players"), Found.Num(), ExpectedPlayers);
+		return false;
+	}
+	for (int32 i = 0; i < Found.Num(); ++i)
+	{
+		if (Found[i].EntityType != TEXT("player") || (i > 0 && Found[i - 1].EntityId >= Found[i].EntityId))
+		{
+			LOG_FAIL(TEXT("Prefix query row %d (entity %u) is not a player in id order"), i, Found[i].EntityId);
+			return false;
+		}
+	}
+
+	// The index holds the cached instances of the updated rows
+	const FMultiKeyBTreeIndex<FEntityRow, FIdKey>* IdIndex = Table->FindBTreeIndex<FIdKey>(TEXT("entity_id"));
+	for (const FEntityRow& Row : Moved)
+	{
+		const TArrayView<const FMultiKeyBTreeIndex<FEntityRow, FIdKey>::FEntry> Match = IdIndex->EqualRange(MakeTuple(Row.EntityId));
+		const FRowEntry<FEntityRow>* Entry = Table->Entries.Find(FRowKey(Serialize(Row.EntityId)));
+		if (Match.Num() != 1 || !Entry || Match[0].Row != Entry->Row || !(*Match[0].Row == Row))
+		{
+			LOG_FAIL(TEXT("Index entry of updated entity %u does not hold the cached row"), Row.EntityId);
+			return false;
+		}
+	}
+	if (IdIndex->SortedEntries.Num() != RowCount + ChurnCount)
+	{
+		LOG_FAIL(TEXT("Id index holds %d entries for %d rows"), IdIndex->SortedEntries.Num(), RowCount + ChurnCount);
+		return false;
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FSpacetimeDBConcurrentIndexLookupTest,
+	"SpacetimeDB.Performance.ConcurrentIndexLookup",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+	bool FSpacetimeDBConcurrentIndexLookupTest::RunTest(const FString& /*Parameters*/)
+{
+	using namespace SpacetimeDBPerf;
+	using namespace UE::SpacetimeDB;
+
+	constexpr int32 RowCount = 100000;
+	constexpr int32 TypeCount = 1000;
+	constexpr int32 Threads = 8;
+	constexpr int32 LookupsPerThread = 20000;
+
+	LOG_Category("B-tree lookups returning row handle ranges, queried from several threads");
+
+	TArray<FString> Types;
+	for (int32 i = 0; i < TypeCount; ++i)
+	{
+		Types.Add(FString::Printf(TEXT("type_%d"), i));
+	}
+	TArray<FEntityRow> Rows;
+	TArray<double> ExpectedSums;
+	ExpectedSums.SetNumZeroed(TypeCount);
+	for (int32 i = 0; i < RowCount; ++i)
+	{
+		Rows.Add(FEntityRow{ uint32(i), Types[i % TypeCount], FTransformArgs{ float(i), 0.0f, 0.0f, 0.0f, 0.0f, 0.0f } });
+		ExpectedSums[i % TypeCount] += float(i);
+	}
+
+	TArray<FWithBsatn<FEntityRow>> Inserts;
+	ParseRowListWithBsatn(MakeRowList(Rows, false), Inserts, MakeRowKeyWriter<FEntityRow, FEntityRowTable>());
+	UClientCache<FEntityRow> Cache;
+	TSharedPtr<FTableCache<FEntityRow>> Table = Cache.GetOrAdd(TEXT("entities"));
+	Table->AddMultiKeyBTreeIndex<FString>(TEXT("entity_type"), [](const FEntityRow& Row) { return Row.EntityType; });
+	Cache.ApplyDiff(TEXT("entities"), MoveTemp(Inserts), {});
+
+	// Allocations of one lookup, returning handles in place against copying the rows out.
+	// The index name is built once, a TEXT literal would allocate a temporary FString per call
+	const FString IndexName(TEXT("entity_type"));
+	TArray<FEntityRow> Copied;
+	const int32 CopyAllocations = GetCountingMalloc().CountAllocations([&]()
+	{
+		Table->FindByMultiKeyBTreeIndex<FString>(Copied, IndexName, Types[0]);
+	});
+	int32 RangeRows = 0;
+	const int32 RangeAllocations = GetCountingMalloc().CountAllocations([&]()
+	{
+		RangeRows = Table->FindRowsByMultiKeyBTreeIndex<FString>(IndexName, Types[0]).Len();
+	});
+	LOG_INFO(TEXT("Lookup of %d rows: %d heap allocations copying, %d returning a range"), RangeRows, CopyAllocations, RangeAllocations);
+	if (RangeAllocations != 0 || RangeRows != Copied.Num())
+	{
+		LOG_FAIL(TEXT("Range lookup made %d allocations and returned %d of %d rows"), RangeAllocations, RangeRows, Copied.Num());
+		return false;
+	}
+
+	// Every thread sums the rows of its lookups and compares with the expected sums
+	const FTableCache<FEntityRow>& ReadOnly = *Table;
+	std::atomic<int32> Mismatches{ 0 };
+	const auto Query = [&](int32 ThreadIndex)
+	{
+		for (int32 Lookup = 0; Lookup < LookupsPerThread; ++Lookup)
+		{
+			const int32 Type = (Lookup * 31 + ThreadIndex * 7) % TypeCount;
+			double Sum = 0.0;
+			for (const TSharedPtr<FEntityRow>& Row : ReadOnly.FindRowsByMultiKeyBTreeIndex<FString>(IndexName, Types[Type]))
+			{
+				Sum += Row->Transform.X;
+			}
+			if (Sum != ExpectedSums[Type])
+			{
+				Mismatches.fetch_add(1);
+			}
+		}
+	};
+
+	uint64 Start = FPlatformTime::Cycles64();
+	Query(0);
+	const double SingleSeconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - Start);
+
+	Start = FPlatformTime::Cycles64();
+	TArray<TFuture<void>> Workers;
+	for (int32 ThreadIndex = 0; ThreadIndex < Threads; ++ThreadIndex)
+	{
+		Workers.Add(Async(EAsyncExecution::Thread, [&Query, ThreadIndex]() { Query(ThreadIndex); }));
+	}
+	for (TFuture<void>& Worker : Workers)
+	{
+		Worker.Wait();
+	}
+	const double ParallelSeconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - Start);
+
+	LOG_INFO(TEXT("%d lookups of %d rows: %.2f ms on one thread, %d threads x %d lookups in %.2f ms (%.1fx throughput)"),
+		LookupsPerThread, RowCount / TypeCount, SingleSeconds * 1e3, Threads, LookupsPerThread, ParallelSeconds * 1e3,
+		SingleSeconds * Threads / FMath::Max(ParallelSeconds, 1e-9));
+
+	if (Mismatches.load() != 0)
+	{
+		LOG_FAIL(TEXT("%d lookups returned the wrong rows"), Mismatches.load());
+		return false;
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FSpacetimeDBTableIterationTest,
+	"SpacetimeDB.Performance.TableIteration",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+	bool FSpacetimeDBTableIterationTest::RunTest(const FString& /*Parameters*/)
+{
+	using namespace SpacetimeDBPerf;
+	using namespace UE::SpacetimeDB;
+
+	constexpr int32 RowCount = 5000;
+	constexpr int32 Frames = 100;
+	constexpr int32 PageSize = 500;
+
+	LOG_Category("Walking every cached entity once per frame: Iter() copies against in place iteration");
+
+	TArray<FEntityRow> Rows;
+	double ExpectedSum = 0.0;
+	for (int32 i = 0; i < RowCount; ++i)
+	{
+		Rows.Add(FEntityRow{ uint32(i), FString::Printf(TEXT("entity_type_%d"), i % 16), FTransformArgs{ float(i), 0.0f, 0.0f, 0.0f, 0.0f, 0.0f } });
+		ExpectedSum += float(i);
+	}
+
+	const FString TableName(TEXT("entities"));
+	TArray<FWithBsatn<FEntityRow>> Inserts;
+	ParseRowListWithBsatn(MakeRowList(Rows, false), Inserts, MakeRowKeyWriter<FEntityRow, FEntityRowTable>());
+	TSharedPtr<UClientCache<FEntityRow>> Cache = MakeShared<UClientCache<FEntityRow>>();
+	const FTableCache<FEntityRow>& Table = *Cache->GetOrAdd(TableName);
+	Cache->ApplyDiff(TableName, MoveTemp(Inserts), {});
+
+	bool bOk = true;
+	const auto Measure = [&](const TCHAR* Name, TFunctionRef<double()> Frame)
+	{
+		const int32 Allocations = GetCountingMalloc().CountAllocations([&]() { Frame(); });
+		double Sum = 0.0;
+		const uint64 Start = FPlatformTime::Cycles64();
+		for (int32 i = 0; i < Frames; ++i)
+		{
+			Sum = Frame();
+		}
+		const double Seconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - Start);
+		LOG_INFO(TEXT("%-10s %.3f ms per frame, %d heap allocations per frame"), Name, Seconds * 1e3 / Frames, Allocations);
+		if (Sum != ExpectedSum)
+		{
+			LOG_FAIL(TEXT("%s visited rows summing to %f instead of %f"), Name, Sum, ExpectedSum);
+			bOk = false;
+		}
+		return Seconds;
+	};
+
+	const double IterSeconds = Measure(TEXT("Iter()"), [&]()
+	{
+		double Sum = 0.0;
+		for (const FEntityRow& Row : GetAllRowsFromTable<FEntityRow>(Cache, TableName))
+		{
+			Sum += Row.Transform.X;
+		}
+		return Sum;
+	});
+	const double ForEachSeconds = Measure(TEXT("ForEach"), [&]()
+	{
+		double Sum = 0.0;
+		ForEachRowInTable<FEntityRow>(Cache, TableName, [&Sum](const FEntityRow& Row) { Sum += Row.Transform.X; });
+		return Sum;
+	});
+	Measure(TEXT("Range for"), [&]()
+	{
+		double Sum = 0.0;
+		for (const FEntityRow& Row : Table)
+		{
+			Sum += Row.Transform.X;
+		}
+		return Sum;
+	});
+	Measure(TEXT("Paged"), [&]()
+	{
+		double Sum = 0.0;
+		bool bHasMore = true;
+		for (int32 Cursor = 0; bHasMore;)
+		{
+			int32 NextCursor = 0;
+			for (const FEntityRow& Row : GetRowPageFromTable<FEntityRow>(Cache, TableName, Cursor, PageSize, NextCursor, bHasMore))
+			{
+				Sum += Row.Transform.X;
+			}
+			Cursor = NextCursor;
+		}
+		return Sum;
+	});
+
+	LOG_INFO(TEXT("ForEach is %.1fx faster than Iter() over %d rows"), IterSeconds / FMath::Max(ForEachSeconds, 1e-9), RowCount);
+	return bOk;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FSpacetimeDBSpatialIndexTest,
+	"SpacetimeDB.Performance.SpatialIndex",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+	bool FSpacetimeDBSpatialIndexTest::RunTest(const FString& /*Parameters*/)
+{
+	using namespace SpacetimeDBPerf;
+	using namespace UE::SpacetimeDB;
+
+	constexpr int32 QueryCount = 1000;
+	constexpr int32 CheckedQueries = 20;
+	constexpr int32 NearestCount = 16;
+	constexpr float Spacing = 250.0f;
+	constexpr float Radius = 2500.0f;
+
+	LOG_Category("Spatial hash grid over entity transforms: radius, box and nearest queries against a scan");
+
+	const TRowKeyWriter<FEntityRow> WriteKey = MakeRowKeyWriter<FEntityRow, FEntityRowTable>();
+	const auto Location = [](const FEntityRow& Row) { return GetTransformLocation(Row.Transform); };
+
+	bool bOk = true;
+	for (const int32 RowCount : { 10000, 50000, 200000 })
+	{
+		// Same density at every size: one entity per Spacing x Spacing square
+		const float WorldSize = FMath::Sqrt(float(RowCount)) * Spacing;
+		FRandomStream Random(RowCount);
+		TArray<FEntityRow> Rows, Moved;
+		for (int32 i = 0; i < RowCount; ++i)
+		{
+			Rows.Add(FEntityRow{ uint32(i), TEXT("npc"), FTransformArgs{ Random.FRandRange(0.0f, WorldSize), Random.FRandRange(0.0f, WorldSize), Random.FRandRange(0.0f, 500.0f), 0.0f, 0.0f, 0.0f } });
+		}
+		for (int32 i = 0; i < RowCount / 100; ++i)
+		{
+			Moved.Add(Rows[i * 100]);
+			Moved.Last().Transform.X += Random.FRandRange(-300.0f, 300.0f);
+			Moved.Last().Transform.Y += Random.FRandRange(-300.0f, 300.0f);
+		}
+		TArray<FVector> Centers;
+		for (int32 i = 0; i < QueryCount; ++i)
+		{
+			Centers.Add(FVector(Random.FRandRange(0.0f, WorldSize), Random.FRandRange(0.0f, WorldSize), 250.0f));
+		}
+
+		// Initial apply and a diff moving 1% of the entities, with and without the grid
+		double ApplySeconds[2], MoveSeconds[2];
+		UClientCache<FEntityRow> Caches[2];
+		for (int32 WithGrid = 0; WithGrid < 2; ++WithGrid)
+		{
+			TArray<FWithBsatn<FEntityRow>> Inserts, MoveInserts, MoveDeletes;
+			ParseRowListWithBsatn(MakeRowList(Rows, false), Inserts, WriteKey);
+			ParseRowListWithBsatn(MakeRowList(Moved, false), MoveInserts, WriteKey);
+			ParseRowListWithBsatn(MakeRowList(Moved, false), MoveDeletes, WriteKey);
+
+			TSharedPtr<FTableCache<FEntityRow>> Table = Caches[WithGrid].GetOrAdd(TEXT("entities"));
+			if (WithGrid)
+			{
+				Table->AddSpatialIndex(TEXT("transform"), Radius, Location);
+			}
+			uint64 Start = FPlatformTime::Cycles64();
+			Caches[WithGrid].ApplyDiff(TEXT("entities"), MoveTemp(Inserts), {});
+			ApplySeconds[WithGrid] = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - Start);
+			Start = FPlatformTime::Cycles64();
+			Caches[WithGrid].ApplyDiff(TEXT("entities"), MoveTemp(MoveInserts), MoveDeletes);
+			MoveSeconds[WithGrid] = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - Start);
+		}
+		const FTableCache<FEntityRow>& Table = *Caches[1].Table;
+		const FSpatialHashGrid<FEntityRow>& Grid = *Table.FindSpatialIndex(TEXT("transform"));
+		LOG_INFO(TEXT("%d entities: initial apply %.2f ms (%.2f ms without grid), moving %d entities %.3f ms (%.3f ms without grid)"),
+			RowCount, ApplySeconds[1] * 1e3, ApplySeconds[0] * 1e3, Moved.Num(), MoveSeconds[1] * 1e3, MoveSeconds[0] * 1e3);
+		if (Grid.NumRows() != RowCount)
+		{
+			LOG_FAIL(TEXT("Grid holds %d of %d entities after the move"), Grid.NumRows(), RowCount);
+			bOk = false;
+		}
+
+		// Radius queries through the grid and through a scan of every row
+		TArray<TSharedPtr<FEntityRow>> Found;
+		int64 FoundTotal = 0;
+		uint64 Start = FPlatformTime::Cycles64();
+		for (const FVector& Center : Centers)
+		{
+			Grid.FindInRadius(Center, Radius, Found);
+			FoundTotal += Found.Num();
+		}
+		const double GridSeconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - Start);
+
+		int64 ScannedTotal = 0;
+		Start = FPlatformTime::Cycles64();
+		for (const FVector& Center : Centers)
+		{
+			for (const FEntityRow& Row : Table)
+			{
+				ScannedTotal += FVector::DistSquared(Location(Row), Center) <= double(Radius) * Radius;
+			}
+		}
+		const double ScanSeconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - Start);
+		LOG_INFO(TEXT("%d entities: radius %.0f query %.2f us (%.1f rows), scan %.2f us (%.0fx)"),
+			RowCount, Radius, GridSeconds * 1e6 / QueryCount, double(FoundTotal) / QueryCount, ScanSeconds * 1e6 / QueryCount,
+			ScanSeconds / FMath::Max(GridSeconds, 1e-9));
+		if (FoundTotal != ScannedTotal)
+		{
+			LOG_FAIL(TEXT("%d entities: radius queries found %lld rows, the scan %lld"), RowCount, FoundTotal, ScannedTotal);
+			bOk = false;
+		}
+
+		// Box queries
+		Start = FPlatformTime::Cycles64();
+		FoundTotal = 0;
+		for (const FVector& Center : Centers)
+		{
+			Grid.FindInBox(FBox(Center - FVector(Radius), Center + FVector(Radius)), Found);
+			FoundTotal += Found.Num();
+		}
+		LOG_INFO(TEXT("%d entities: box query %.2f us (%.1f rows)"),
+			RowCount, FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - Start) * 1e6 / QueryCount, double(FoundTotal) / QueryCount);
+
+		// Nearest queries, the first ones checked against sorting every distance
+		Start = FPlatformTime::Cycles64();
+		for (const FVector& Center : Centers)
+		{
+			Grid.FindNearest(Center, NearestCount, Found);
+		}
+		LOG_INFO(TEXT("%d entities: %d nearest query %.2f us"),
+			RowCount, NearestCount, FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - Start) * 1e6 / QueryCount);
+
+		TArray<double> Distances;
+		for (int32 Query = 0; Query < CheckedQueries; ++Query)
+		{
+			const FVector& Center = Centers[Query];
+			Grid.FindNearest(Center, NearestCount, Found);
+			Distances.Reset();
+			for (const FEntityRow& Row : Table)
+			{
+				Distances.Add(FVector::DistSquared(Location(Row), Center));
+			}
+			Distances.Sort();
+			const bool bMatches = Found.Num() == NearestCount
+				&& FVector::DistSquared(Location(*Found.Last()), Center) == Distances[NearestCount - 1]
+				&& FVector::DistSquared(Location(*Found[0]), Center) == Distances[0];
+			if (!bMatches)
+			{
+				LOG_FAIL(TEXT("%d entities: nearest query %d does not match the sorted distances"), RowCount, Query);
+				bOk = false;
+				break;
+			}
+		}
+	}
+
+	// A row passing through a far cell must not leave the cell or the widened bounds behind
+	{
+		FSpatialHashGrid<FEntityRow> Grid(Radius, Location);
+		const TSharedPtr<FEntityRow> Near = MakeShared<FEntityRow>(FEntityRow{ 0, TEXT("npc"), FTransformArgs{ 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f } });
+		const TSharedPtr<FEntityRow> Far = MakeShared<FEntityRow>(FEntityRow{ 1, TEXT("npc"), FTransformArgs{ 1e9f, 1e9f, 0.0f, 0.0f, 0.0f, 0.0f } });
+		Grid.AddRow(Near);
+		Grid.AddRow(Far);
+		Grid.RemoveRow(Far);
+		TArray<TSharedPtr<FEntityRow>> Found;
+		Grid.FindNearest(FVector::ZeroVector, 2, Found);
+		if (Grid.Cells.Num() != 1 || Found.Num() != 1 || Found[0] != Near)
+		{
+			LOG_FAIL(TEXT("Grid keeps %d cells and finds %d rows after the far row left"), Grid.Cells.Num(), Found.Num());
+			bOk = false;
+		}
+		Grid.RemoveRow(Near);
+		if (!Grid.Cells.IsEmpty() || Grid.NumRows() != 0)
+		{
+			LOG_FAIL(TEXT("Grid keeps %d cells after its last row left"), Grid.Cells.Num());
+			bOk = false;
+		}
+	}
+	return bOk;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FSpacetimeDBSnapshotReadersTest,
+	"SpacetimeDB.Performance.SnapshotReaders",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+	bool FSpacetimeDBSnapshotReadersTest::RunTest(const FString& /*Parameters*/)
+{
+	using namespace SpacetimeDBPerf;
+	using namespace UE::SpacetimeDB;
+
+	constexpr int32 RowCount = 50000;
+	constexpr int32 Groups = 50;
+	constexpr int32 DiffCount = 300;
+	constexpr int32 Readers = 8;
+
+	LOG_Category("Epoch versioned table snapshots read by worker threads while diffs are applied");
+
+	// Diff k moves every row of group k % Groups to Z = k, so the state of any version is known from its epoch alone
+	const TRowKeyWriter<FEntityRow> WriteKey = MakeRowKeyWriter<FEntityRow, FEntityRowTable>();
+	TArray<FEntityRow> Rows;
+	for (int32 i = 0; i < RowCount; ++i)
+	{
+		Rows.Add(FEntityRow{ uint32(i), TEXT("npc"), FTransformArgs{ float(i), 0.0f, 0.0f, 0.0f, 0.0f, 0.0f } });
+	}
+	const auto MakeDiff = [&Rows, &WriteKey](int32 Diff, TArray<FWithBsatn<FEntityRow>>& OutInserts, TArray<FWithBsatn<FEntityRow>>& OutDeletes)
+	{
+		TArray<FEntityRow> Deleted, Inserted;
+		for (int32 i = Diff % Groups; i < RowCount; i += Groups)
+		{
+			Deleted.Add(Rows[i]);
+			Rows[i].Transform.Z = float(Diff);
+			Inserted.Add(Rows[i]);
+		}
+		ParseRowListWithBsatn(MakeRowList(Inserted, false), OutInserts, WriteKey);
+		ParseRowListWithBsatn(MakeRowList(Deleted, false), OutDeletes, WriteKey);
+	};
+	// Z of the rows of Group once Applied diffs are applied
+	const auto ExpectedZ = [](int64 Applied, int32 Group)
+	{
+		const int64 Last = Applied - ((Applied - Group) % Groups + Groups) % Groups;
+		return Last >= 1 ? float(Last) : 0.0f;
+	};
+
+	// Baseline: the same diffs applied without snapshots
+	double PlainSeconds = 0.0;
+	{
+		UClientCache<FEntityRow> Cache;
+		Cache.GetOrAdd(TEXT("entities"));
+		TArray<FWithBsatn<FEntityRow>> Inserts, Deletes;
+		ParseRowListWithBsatn(MakeRowList(Rows, false), Inserts, WriteKey);
+		Cache.ApplyDiff(TEXT("entities"), MoveTemp(Inserts), {});
+		const TArray<FEntityRow> InitialRows = Rows;
+		for (int32 Diff = 1; Diff <= DiffCount; ++Diff)
+		{
+			Inserts.Reset();
+			Deletes.Reset();
+			MakeDiff(Diff, Inserts, Deletes);
+			const uint64 Start = FPlatformTime::Cycles64();
+			Cache.ApplyDiff(TEXT("entities"), MoveTemp(Inserts), Deletes);
+			PlainSeconds += FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - Start);
+		}
+		Rows = InitialRows;
+	}
+
+	// Snapshots enabled before the initial apply, which publishes epoch 1, diff k publishes epoch k + 1
+	UClientCache<FEntityRow> Cache;
+	TSharedPtr<FTableCache<FEntityRow>> Table = Cache.GetOrAdd(TEXT("entities"));
+	Table->EnableSnapshots();
+	{
+		TArray<FWithBsatn<FEntityRow>> Inserts;
+		ParseRowListWithBsatn(MakeRowList(Rows, false), Inserts, WriteKey);
+		Cache.ApplyDiff(TEXT("entities"), MoveTemp(Inserts), {});
+	}
+	const TSharedPtr<const FTableSnapshot<FEntityRow>> FirstVersion = Table->PinSnapshot();
+
+	std::atomic<bool> bDone{ false };
+	std::atomic<int32> Failures{ 0 };
+	std::atomic<int64> Scans{ 0 };
+	std::atomic<int64> Lookups{ 0 };
+	std::atomic<int64> PinCycles{ 0 };
+	std::atomic<int64> Pins{ 0 };
+	const FTableCache<FEntityRow>& ReadOnly = *Table;
+	const auto Read = [&](int32 ReaderIndex)
+	{
+		uint64 LastEpoch = 0;
+		uint32 NextId = uint32(ReaderIndex) * 7919;
+		while (!bDone.load())
+		{
+			const uint64 PinStart = FPlatformTime::Cycles64();
+			const TSharedPtr<const FTableSnapshot<FEntityRow>> Snapshot = ReadOnly.PinSnapshot();
+			PinCycles.fetch_add(int64(FPlatformTime::Cycles64() - PinStart));
+			Pins.fetch_add(1);
+
+			// Versions only move forward and always hold the whole table
+			const uint64 Epoch = Snapshot->GetEpoch();
+			if (Epoch < LastEpoch || Snapshot->Num() != RowCount)
+			{
+				Failures.fetch_add(1);
+			}
+			LastEpoch = Epoch;
+
+			// Every row matches the version's epoch, a version mixing two diffs would not
+			float Expected[Groups];
+			for (int32 Group = 0; Group < Groups; ++Group)
+			{
+				Expected[Group] = ExpectedZ(int64(Epoch) - 1, Group);
+			}
+			int32 Seen = 0;
+			bool bTorn = false;
+			Snapshot->ForEach([&](const FEntityRow& Row)
+			{
+				bTorn |= Row.Transform.Z != Expected[Row.EntityId % Groups];
+				++Seen;
+			});
+			if (bTorn || Seen != RowCount)
+			{
+				Failures.fetch_add(1);
+			}
+			Scans.fetch_add(1);
+
+			for (int32 Lookup = 0; Lookup < 1000; ++Lookup)
+			{
+				NextId = (NextId + 104729) % RowCount;
+				const FEntityRow* Row = Snapshot->FindByPrimaryKey<FEntityRowTable>(NextId);
+				if (!Row || Row->EntityId != NextId || Row->Transform.Z != Expected[NextId % Groups])
+				{
+					Failures.fetch_add(1);
+				}
+			}
+			Lookups.fetch_add(1000);
+		}
+	};
+
+	TArray<TFuture<void>> Workers;
+	for (int32 ReaderIndex = 0; ReaderIndex < Readers; ++ReaderIndex)
+	{
+		Workers.Add(Async(EAsyncExecution::Thread, [&Read, ReaderIndex]() { Read(ReaderIndex); }));
+	}
+
+	double SnapshotSeconds = 0.0;
+	const uint64 RunStart = FPlatformTime::Cycles64();
+	TArray<FWithBsatn<FEntityRow>> Inserts, Deletes;
+	for (int32 Diff = 1; Diff <= DiffCount; ++Diff)
+	{
+		Inserts.Reset();
+		Deletes.Reset();
+		MakeDiff(Diff, Inserts, Deletes);
+		const uint64 Start = FPlatformTime::Cycles64();
+		Cache.ApplyDiff(TEXT("entities"), MoveTemp(Inserts), Deletes);
+		SnapshotSeconds += FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - Start);
+	}
+	bDone.store(true);
+	for (TFuture<void>& Worker : Workers)
+	{
+		Worker.Wait();
+	}
+	const double RunSeconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - RunStart);
+
+	LOG_INFO(TEXT("%d diffs of %d rows over %d rows: apply %.3f ms with snapshots and %d readers, %.3f ms without"),
+		DiffCount, RowCount / Groups, RowCount, SnapshotSeconds * 1e3 / DiffCount, Readers, PlainSeconds * 1e3 / DiffCount);
+	LOG_INFO(TEXT("%d readers: %lld full scans and %lld key lookups in %.2f ms, pin %.3f us on average"),
+		Readers, Scans.load(), Lookups.load(), RunSeconds * 1e3,
+		FPlatformTime::ToSeconds64(uint64(PinCycles.load())) * 1e6 / FMath::Max<int64>(Pins.load(), 1));
+
+	if (Failures.load() != 0)
+	{
+		LOG_FAIL(TEXT("Readers saw %d inconsistent snapshots or lookups"), Failures.load());
+		return false;
+	}
+	const TSharedPtr<const FTableSnapshot<FEntityRow>> LastVersion = Table->PinSnapshot();
+	if (LastVersion->GetEpoch() != uint64(DiffCount) + 1 || Scans.load() == 0)
+	{
+		LOG_FAIL(TEXT("Last epoch %llu after %d diffs, %lld scans"), LastVersion->GetEpoch(), DiffCount, Scans.load());
+		return false;
+	}
+
+	// The version pinned before the diffs still shows the initial rows
+	bool bFirstUnchanged = FirstVersion->GetEpoch() == 1 && FirstVersion->Num() == RowCount;
+	FirstVersion->ForEach([&bFirstUnchanged](const FEntityRow& Row) { bFirstUnchanged &= Row.Transform.Z == 0.0f; });
+	if (!bFirstUnchanged)
+	{
+		LOG_FAIL(TEXT("The first pinned snapshot changed while later versions were published"));
+		return false;
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FSpacetimeDBParallelTableApplyTest,
+	"SpacetimeDB.Performance.ParallelTableApply",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+	bool FSpacetimeDBParallelTableApplyTest::RunTest(const FString& /*Parameters*/)
+{
+	using namespace SpacetimeDBPerf;
+	using namespace UE::SpacetimeDB;
+
+	constexpr int32 Runs = 3;
+	const int32 TableRows[] = { 200000, 100000, 50000, 50000, 20000, 5000 };
+	constexpr int32 TableCount = UE_ARRAY_COUNT(TableRows);
+
+	LOG_Category("SubscribeMultiApplied over several tables, caches applied one table at a time -> in parallel");
+
+	// One table per entry of TableRows, each with a B-tree and a spatial index like the game's entity tables
+	const TRowKeyWriter<FEntityRow> WriteKey = MakeRowKeyWriter<FEntityRow, FEntityRowTable>();
+	TArray<FBsatnRowListType> RowLists;
+	TArray<int64> RowCounts;
+	int64 TotalRows = 0;
+	for (int32 Table = 0; Table < TableCount; ++Table)
+	{
+		FRandomStream Random(Table);
+		TArray<FEntityRow> Rows;
+		for (int32 i = 0; i < TableRows[Table]; ++i)
+		{
+			Rows.Add(FEntityRow{ uint32(i), FString::Printf(TEXT("type_%d"), i % 100),
+				FTransformArgs{ Random.FRandRange(0.0f, 100000.0f), Random.FRandRange(0.0f, 100000.0f), 0.0f, 0.0f, 0.0f, 0.0f } });
+		}
+		RowLists.Add(MakeRowList(Rows, false));
+		RowCounts.Add(TableRows[Table]);
+		TotalRows += TableRows[Table];
+	}
+
+	// Best of Runs for each mode, the rows are decoded before the clock starts as the decode workers would have done
+	double BestSeconds[2] = { TNumericLimits<double>::Max(), TNumericLimits<double>::Max() };
+	bool bOk = true;
+	for (int32 Run = 0; Run < Runs; ++Run)
+	{
+		for (int32 Parallel = 0; Parallel < 2; ++Parallel)
+		{
+			TArray<UClientCache<FEntityRow>> Caches;
+			Caches.SetNum(TableCount);
+			TArray<TArray<FWithBsatn<FEntityRow>>> Inserts;
+			Inserts.SetNum(TableCount);
+			for (int32 Table = 0; Table < TableCount; ++Table)
+			{
+				TSharedPtr<FTableCache<FEntityRow>> Cache = Caches[Table].GetOrAdd(TEXT("entities"));
+				Cache->AddMultiKeyBTreeIndex<FString>(TEXT("entity_type"), [](const FEntityRow& Row) { return Row.EntityType; });
+				Cache->AddSpatialIndex(TEXT("transform"), 2000.0f, [](const FEntityRow& Row) { return GetTransformLocation(Row.Transform); });
+				ParseRowListWithBsatn(RowLists[Table], Inserts[Table], WriteKey);
+			}
+
+			const uint64 Start = FPlatformTime::Cycles64();
+			const bool bRanParallel = ApplyTableUpdates(RowCounts, Parallel ? DefaultParallelApplyMinRows : 0, [&](int32 Table)
+			{
+				Caches[Table].ApplyDiff(TEXT("entities"), MoveTemp(Inserts[Table]), {});
+			});
+			BestSeconds[Parallel] = FMath::Min(BestSeconds[Parallel], FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - Start));
+
+			if (bRanParallel != (Parallel != 0))
+			{
+				LOG_FAIL(TEXT("Update of %lld rows applied %s"), TotalRows, bRanParallel ? TEXT("in parallel with the threshold disabled") : TEXT("serially above the threshold"));
+				bOk = false;
+			}
+			for (int32 Table = 0; Table < TableCount; ++Table)
+			{
+				if (Caches[Table].Table->Entries.Num() != TableRows[Table])
+				{
+					LOG_FAIL(TEXT("Table %d holds %d of %d rows"), Table, Caches[Table].Table->Entries.Num(), TableRows[Table]);
+					bOk = false;
+				}
+			}
+		}
+	}
+	LOG_INFO(TEXT("%d tables, %lld rows: %.2f ms one table at a time, %.2f ms in parallel (%.1fx)"),
+		TableCount, TotalRows, BestSeconds[0] * 1e3, BestSeconds[1] * 1e3, BestSeconds[0] / FMath::Max(BestSeconds[1], 1e-9));
+
+	// Updates below the threshold stay on the calling thread, in table order
+	const int64 SmallCounts[] = { 100, 50, 10 };
+	TArray<int32> Applied;
+	const uint32 CallingThread = FPlatformTLS::GetCurrentThreadId();
+	bool bSameThread = true;
+	const bool bSmallParallel = ApplyTableUpdates(SmallCounts, DefaultParallelApplyMinRows, [&](int32 Table)
+	{
+		bSameThread &= FPlatformTLS::GetCurrentThreadId() == CallingThread;
+		Applied.Add(Table);
+	});
+	if (bSmallParallel || !bSameThread || Applied != TArray<int32>{ 0, 1, 2 })
+	{
+		LOG_FAIL(TEXT("An update of 160 rows was not applied in order on the calling thread"));
+		bOk = false;
+	}
+	return bOk;
+}
+
+namespace SpacetimeDBPerf
+{
+	/** One decoded entities update on its way to the game thread, and what applying it produced. */
+	struct FEntityFrameUpdate
+	{
+		int32 Frame = 0;
+		TArray<FWithBsatn<FEntityRow>> Inserts;
+		TArray<FWithBsatn<FEntityRow>> Deletes;
+		FTableAppliedDiff<FEntityRow> Diff;
+		TSharedPtr<const FTableSnapshot<FEntityRow>> Snapshot;
+	};
+
+	/** Work a game does per applied diff: one delegate call per changed row, reading the row. */
+	double WalkEntityDiff(const FTableAppliedDiff<FEntityRow>& Diff)
+	{
+		double Sum = 0.0;
+		for (const TPair<FRowKey, TSharedPtr<const FEntityRow>>& Pair : Diff.Inserts)
+		{
+			Sum += Pair.Value->Transform.X;
+		}
+		for (int32 Index = 0; Index < Diff.UpdateInserts.Num(); ++Index)
+		{
+			Sum += Diff.UpdateInserts[Index]->Transform.Z - Diff.UpdateDeletes[Index]->Transform.Z;
+		}
+		return Sum;
+	}
+
+	/** Average, 95th percentile and worst of a set of frame times in milliseconds. */
+	FString DescribeFrameTimes(TArray<double> Milliseconds)
+	{
+		Milliseconds.Sort();
+		double Total = 0.0;
+		for (const double Value : Milliseconds)
+		{
+			Total += Value;
+		}
+		return FString::Printf(TEXT("avg %.3f ms, p95 %.3f ms, max %.3f ms"),
+			Total / FMath::Max(Milliseconds.Num(), 1),
+			Milliseconds.IsEmpty() ? 0.0 : Milliseconds[FMath::Min(Milliseconds.Num() - 1, Milliseconds.Num() * 95 / 100)],
+			Milliseconds.IsEmpty() ? 0.0 : Milliseconds.Last());
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FSpacetimeDBApplyThreadFrameTimeTest,
+	"SpacetimeDB.Performance.ApplyThreadFrameTime",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+	bool FSpacetimeDBApplyThreadFrameTimeTest::RunTest(const FString& /*Parameters*/)
+{
+	using namespace SpacetimeDBPerf;
+	using namespace UE::SpacetimeDB;
+
+	constexpr int32 RowCount = 100000;
+	constexpr int32 Groups = 20;
+	constexpr int32 Frames = 240;
+
+	LOG_Category("Game thread time per entities update, cache applied in FrameTick -> on the apply thread");
+
+	// Frame k moves every row of group k % Groups to Z = k, encoded up front so both modes get the same bytes
+	const TRowKeyWriter<FEntityRow> WriteKey = MakeRowKeyWriter<FEntityRow, FEntityRowTable>();
+	TArray<FEntityRow> Rows;
+	for (int32 i = 0; i < RowCount; ++i)
+	{
+		Rows.Add(FEntityRow{ uint32(i), TEXT("npc"), FTransformArgs{ float(i), 0.0f, 0.0f, 0.0f, 0.0f, 0.0f } });
+	}
+	const FBsatnRowListType InitialList = MakeRowList(Rows, false);
+	TArray<FBsatnRowListType> InsertLists, DeleteLists;
+	for (int32 Frame = 1; Frame <= Frames; ++Frame)
+	{
+		TArray<FEntityRow> Deleted, Inserted;
+		for (int32 i = Frame % Groups; i < RowCount; i += Groups)
+		{
+			Deleted.Add(Rows[i]);
+			Rows[i].Transform.Z = float(Frame);
+			Inserted.Add(Rows[i]);
+		}
+		InsertLists.Add(MakeRowList(Inserted, false));
+		DeleteLists.Add(MakeRowList(Deleted, false));
+	}
+
+	// What the generated table's Update does with every diff
+	const auto ApplyFrame = [](UClientCache<FEntityRow>& Cache, FEntityFrameUpdate& Update)
+	{
+		Update.Diff = Cache.ApplyDiff(TEXT("entities"), MoveTemp(Update.Inserts), Update.Deletes);
+		Update.Diff.DeriveUpdatesByPrimaryKey<uint32>([](const FEntityRow& Row) { return Row.EntityId; });
+		Update.Deletes.Reset();
+	};
+	const auto LoadInitialRows = [&](UClientCache<FEntityRow>& Cache)
+	{
+		TArray<FWithBsatn<FEntityRow>> Inserts;
+		ParseRowListWithBsatn(InitialList, Inserts, WriteKey);
+		Cache.ApplyDiff(TEXT("entities"), MoveTemp(Inserts), {});
+	};
+
+	// Inline: FrameTick applies each update then broadcasts it, the rows were decoded beforehand as the decode workers would have
+	TArray<double> InlineMs;
+	double Checksum[2] = { 0.0, 0.0 };
+	{
+		UClientCache<FEntityRow> Cache;
+		Cache.GetOrAdd(TEXT("entities"));
+		LoadInitialRows(Cache);
+		for (int32 Frame = 1; Frame <= Frames; ++Frame)
+		{
+			FEntityFrameUpdate Update;
+			ParseRowListWithBsatn(InsertLists[Frame - 1], Update.Inserts, WriteKey);
+			ParseRowListWithBsatn(DeleteLists[Frame - 1], Update.Deletes, WriteKey);
+
+			const uint64 Start = FPlatformTime::Cycles64();
+			ApplyFrame(Cache, Update);
+			Checksum[0] += WalkEntityDiff(Update.Diff) + Cache.Table->Entries.Num();
+			InlineMs.Add(FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - Start) * 1e3);
+		}
+	}
+
+	// Apply thread: a decode thread publishes the updates, the apply thread applies them and FrameTick only shows and broadcasts them
+	TArray<double> ThreadedMs;
+	double ApplyBusySeconds = 0.0;
+	bool bOk = true;
+	{
+		UClientCache<FEntityRow> Cache;
+		TSharedPtr<FTableCache<FEntityRow>> Table = Cache.GetOrAdd(TEXT("entities"));
+		Table->EnableSnapshots();
+		LoadInitialRows(Cache);
+		Table->SnapshotPublisher->DeferVisibility();
+
+		TSequencedMessageRing<FEntityFrameUpdate> Ring(64);
+		TCacheApplyThread<FEntityFrameUpdate> ApplyThread(Ring, [&Cache, &Table, &ApplyFrame](FEntityFrameUpdate& Update)
+		{
+			ApplyFrame(Cache, Update);
+			Update.Snapshot = Table->SnapshotPublisher->Pin();
+		}, 8);
+
+		TFuture<void> Decoder = Async(EAsyncExecution::Thread, [&]()
+		{
+			for (int32 Frame = 1; Frame <= Frames; ++Frame)
+			{
+				FEntityFrameUpdate Update;
+				Update.Frame = Frame;
+				ParseRowListWithBsatn(InsertLists[Frame - 1], Update.Inserts, WriteKey);
+				ParseRowListWithBsatn(DeleteLists[Frame - 1], Update.Deletes, WriteKey);
+				while (!Ring.Publish(uint64(Frame - 1), MoveTemp(Update)) && !Ring.IsClosed())
+				{
+					FPlatformProcess::Yield();
+				}
+				ApplyThread.Notify();
+			}
+		});
+
+		FEntityFrameUpdate Update;
+		for (int32 Frame = 1; Frame <= Frames; ++Frame)
+		{
+			// Waiting on the decoder is not game thread work, a real frame would find nothing to do instead
+			while (!ApplyThread.TryDequeue(Update))
+			{
+				FPlatformProcess::Yield();
+			}
+
+			const uint64 Start = FPlatformTime::Cycles64();
+			Table->SnapshotPublisher->MakeVisible(Update.Snapshot);
+			Checksum[1] += WalkEntityDiff(Update.Diff) + Table->PinSnapshot()->Num();
+			ThreadedMs.Add(FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - Start) * 1e3);
+
+			// Reads see the state of the diff being broadcast, never a later one the apply thread already made
+			const TSharedPtr<const FTableSnapshot<FEntityRow>> Visible = Table->PinSnapshot();
+			const uint32 MovedId = uint32(Frame % Groups);
+			const FEntityRow* Moved = Visible->FindByPrimaryKey<FEntityRowTable>(MovedId);
+			if (Update.Frame != Frame || Visible->GetEpoch() != uint64(Frame) + 1 || !Moved || Moved->Transform.Z != float(Frame))
+			{
+				LOG_FAIL(TEXT("Frame %d broadcast update %d with visible epoch %llu"), Frame, Update.Frame, Visible->GetEpoch());
+				bOk = false;
+				break;
+			}
+		}
+		// Releases the decoder if a failure left updates nobody will take
+		Ring.Close();
+		Decoder.Wait();
+		ApplyBusySeconds = ApplyThread.GetBusySeconds();
+		ApplyThread.Shutdown();
+	}
+
+	LOG_INFO(TEXT("%d updates of %d rows over %d rows"), Frames, RowCount / Groups, RowCount);
+	LOG_INFO(TEXT("FrameTick applying the cache: %s"), *DescribeFrameTimes(InlineMs));
+	LOG_INFO(TEXT("FrameTick broadcasting only:  %s, apply thread busy %.3f ms per update"),
+		*DescribeFrameTimes(ThreadedMs), ApplyBusySeconds * 1e3 / Frames);
+
+	if (bOk && Checksum[0] != Checksum[1])
+	{
+		LOG_FAIL(TEXT("Both modes broadcast different diffs (%f, %f)"), Checksum[0], Checksum[1]);
+		bOk = false;
+	}
+	return bOk;
+}
+
+namespace SpacetimeDBPerf
+{
+	/** Uncompressed frame carrying Message, as the server sends it. */
+	FWebsocketFrameBuffer MakeServerFrame(const FServerMessageType& Message)
+	{
+		FWebsocketFrameBuffer Frame = MakeShared<TArray<uint8>, ESPMode::ThreadSafe>();
+		Frame->Add(static_cast<uint8>(ECompressableQueryUpdateTag::Uncompressed));
+		Frame->Append(UE::SpacetimeDB::Serialize(Message));
+		return Frame;
+	}
+
+	/** Update of one table carrying a single uncompressed query update. */
+	FTableUpdateType MakeTableUpdate(uint32 TableId, const FString& TableName, const FQueryUpdateType& Query, uint64 NumRows)
+	{
+		FTableUpdateType Table;
+		Table.TableId = TableId;
+		Table.TableName = TableName;
+		Table.NumRows = NumRows;
+		Table.Updates.Add(FCompressableQueryUpdateType::Uncompressed(Query));
+		return Table;
+	}
+}
+
+/** Drives the protected message pipeline of a connection the way the socket and FrameTick do. */
+class FDbConnectionBaseTestAccess
+{
+public:
+	static FParsedServerMessage PreProcessMessage(UDbConnectionBase& Connection, const FWebsocketFrameBuffer& Frame)
+	{
+		return Connection.PreProcessMessage(Frame);
+	}
+
+	static void ProcessServerMessage(UDbConnectionBase& Connection, const FParsedServerMessage& Parsed)
+	{
+		Connection.ProcessServerMessage(Parsed);
+	}
+
+	/** Decode Frame on this thread and queue it for FrameTick, as the socket callback and a decode worker do. */
+	static void ReceiveDecodedFrame(UDbConnectionBase& Connection, const FWebsocketFrameBuffer& Frame)
+	{
+		Connection.PendingReceiveTimes.Enqueue(FPlatformTime::Seconds());
+		Connection.ReleaseRing.Publish(Connection.NextPreprocessId++, Connection.PreProcessMessage(Frame));
+	}
+
+	/** Apply Update, carried by Parsed, to the registered tables and broadcast it, as the generated DbUpdate does. */
+	static void ApplyRegisteredTableUpdates(UDbConnectionBase& Connection, const FParsedServerMessage& Parsed, const FDatabaseUpdateType& Update, void* Context)
+	{
+		TGuardValue<const FParsedServerMessage*> ApplyingGuard(Connection.ApplyingMessage, &Parsed);
+		Connection.ApplyRegisteredTableUpdates(Update, Context);
+	}
+
+	/** Number of registered tables in Update, OutDistinct is false when one of them is listed twice. */
+	static int32 ResolveTableUpdates(UDbConnectionBase& Connection, const FDatabaseUpdateType& Update, bool& OutDistinct)
+	{
+		UDbConnectionBase::FResolvedTableUpdates Resolved;
+		Connection.ResolveTableUpdates(Update, nullptr, Resolved);
+		OutDistinct = Resolved.bDistinctTables;
+		return Resolved.Handlers.Num();
+	}
+};
+
+namespace SpacetimeDBPerf
+{
+	/** Event context handed through ApplyRegisteredTableUpdates to the table delegates. */
+	struct FEntityEventContext
+	{
+		int32 MessageId = 0;
+	};
+
+	/** Minimal table for the connection's update handlers, shaped like the generated ones. */
+	struct FEntityHandlerTable : FEntityRowTable
+	{
+		explicit FEntityHandlerTable(const FString& InTableName)
+			: TableName(InTableName)
+			, Data(MakeShared<UClientCache<FEntityRow>>())
+		{
+			// As the generated tables do once initialized, ApplyDiff only updates an existing cache
+			Data->GetOrAdd(TableName);
+		}
+
+		FString TableName;
+		TSharedPtr<UClientCache<FEntityRow>> Data;
+		std::atomic<int32> NumUpdates{ 0 };
+
+		TMulticastDelegate<void(const FEntityEventContext&, const FEntityRow&)> OnInsert;
+		TMulticastDelegate<void(const FEntityEventContext&, const FEntityRow&)> OnDelete;
+		TMulticastDelegate<void(const FEntityEventContext&, const FEntityRow&, const FEntityRow&)> OnUpdate;
+
+		FTableAppliedDiff<FEntityRow> Update(TArray<FWithBsatn<FEntityRow>> Inserts, TArray<FWithBsatn<FEntityRow>> Deletes)
+		{
+			NumUpdates.fetch_add(1, std::memory_order_relaxed);
+			FTableAppliedDiff<FEntityRow> Diff = Data->ApplyDiff(TableName, MoveTemp(Inserts), Deletes);
+			Diff.DeriveUpdatesByPrimaryKey<uint32>([](const FEntityRow& Row) { return Row.EntityId; });
+			return Diff;
+		}
+
+		void EnableSnapshots()
+		{
+			Data->GetOrAdd(TableName)->EnableSnapshots();
+		}
+
+		TSharedPtr<FTableSnapshotPublisher<FEntityRow>> GetSnapshotPublisher() const
+		{
+			TSharedPtr<const FTableCache<FEntityRow>> Table = Data->GetTable(TableName);
+			return Table.IsValid() ? Table->SnapshotPublisher : nullptr;
+		}
+
+		/** Cached row of the entity, null if absent. */
+		const FEntityRow* Find(uint32 EntityId) const
+		{
+			TSharedPtr<const FTableCache<FEntityRow>> Table = Data->GetTable(TableName);
+			const FRowEntry<FEntityRow>* Entry = Table.IsValid() ? Table->Entries.Find(FRowKey(UE::SpacetimeDB::Serialize(EntityId))) : nullptr;
+			return Entry ? Entry->Row.Get() : nullptr;
+		}
+
+		int32 Num() const
+		{
+			TSharedPtr<const FTableCache<FEntityRow>> Table = Data->GetTable(TableName);
+			return Table.IsValid() ? Table->Entries.Num() : 0;
+		}
+	};
+
+	FEntityRow MakeEntity(uint32 EntityId, float X)
+	{
+		return FEntityRow{ EntityId, TEXT("npc"), FTransformArgs{ X, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f } };
+	}
+
+	FQueryUpdateType MakeQuery(const TArray<FEntityRow>& Inserts, const TArray<FEntityRow>& Deletes)
+	{
+		FQueryUpdateType Query;
+		Query.Inserts = MakeRowList(Inserts, false);
+		Query.Deletes = MakeRowList(Deletes, false);
+		return Query;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FSpacetimeDBTransactionUpdateCopyTest,
+	"SpacetimeDB.Performance.TransactionUpdateCopies",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+	bool FSpacetimeDBTransactionUpdateCopyTest::RunTest(const FString& /*Parameters*/)
+{
+	using namespace SpacetimeDBPerf;
+	using namespace UE::SpacetimeDB;
+
+	constexpr int32 TableCount = 4;
+	constexpr int32 RowCount = 2000;
+	constexpr int32 Iterations = 50;
+
+	LOG_Category("Row list bytes copied per TransactionUpdate, decoded and applied to the registered tables");
+
+	// Long rows make every row list larger than the per-row arrays and maps of the cache, so only copies of
+	// whole lists or their row arenas allocate buffers at least that large
+	const TRowKeyWriter<FEntityRow> WriteKey = MakeRowKeyWriter<FEntityRow, FEntityRowTable>();
+	TArray<FEntityRow> Rows;
+	for (int32 i = 0; i < RowCount; ++i)
+	{
+		Rows.Add(FEntityRow{ uint32(i), FString::ChrN(256, TEXT('n')), FTransformArgs{ float(i), 0.0f, 0.0f, 0.0f, 0.0f, 0.0f } });
+	}
+	const FQueryUpdateType Query = MakeQuery(Rows, Rows);
+	const SIZE_T ListBytes = Query.Inserts.RowsData.Num();
+
+	UTestDbConnection* Connection = NewObject<UTestDbConnection>();
+	// Applied on this thread, where the allocations are counted
+	Connection->SetParallelApplyMinRows(0);
+	FEntityEventContext Context;
+	Connection->TableEventContext = &Context;
+	TArray<TUniquePtr<FEntityHandlerTable>> Tables;
+	int32 UpdateEvents = 0;
+	FDatabaseUpdateType Database;
+	for (int32 Table = 0; Table < TableCount; ++Table)
+	{
+		FEntityHandlerTable& Handler = *Tables.Add_GetRef(MakeUnique<FEntityHandlerTable>(FString::Printf(TEXT("entities_%d"), Table)));
+		Handler.OnUpdate.AddLambda([&UpdateEvents](const FEntityEventContext&, const FEntityRow&, const FEntityRow&) { ++UpdateEvents; });
+		Connection->RegisterTable<FEntityRow, FEntityHandlerTable, FEntityEventContext>(Handler.TableName, &Handler);
+		Database.Tables.Add(MakeTableUpdate(Table + 1, Handler.TableName, Query, RowCount * 2));
+	}
+	FTransactionUpdateType Transaction;
+	Transaction.Status = FUpdateStatusType::Committed(Database);
+	const FServerMessageType Message = FServerMessageType::TransactionUpdate(Transaction);
+	const FWebsocketFrameBuffer Frame = MakeServerFrame(Message);
+
+	FCountingMalloc& Counter = GetCountingMalloc();
+	const TArrayView<const uint8> Payload(Frame->GetData() + 1, Frame->Num() - 1);
+	const auto ParseRows = [&WriteKey](const FQueryUpdateType& TableQuery)
+	{
+		TArray<FWithBsatn<FEntityRow>> Inserts, Deletes;
+		ParseQueryUpdateWithBsatn<FEntityRow>(TableQuery, Inserts, Deletes, WriteKey);
+	};
+
+	// Baseline: the pipeline before the by-reference accessors, where every GetAs* returned a copy of its payload
+	Counter.CountAllocations([&]()
+	{
+		const FServerMessageType Decoded = Deserialize<FServerMessageType>(Payload);
+		const FTransactionUpdateType PreProcessPayload = FTransactionUpdateType(Decoded.GetAsTransactionUpdate());
+		const FDatabaseUpdateType Committed = FDatabaseUpdateType(PreProcessPayload.Status.GetAsCommitted());
+		for (const FTableUpdateType& Table : Committed.Tables)
+		{
+			const FQueryUpdateType Uncompressed = FQueryUpdateType(Table.Updates[0].GetAsUncompressed());
+			const FCompressableQueryUpdateType Rewrapped = FCompressableQueryUpdateType::Uncompressed(Uncompressed);
+			ParseRows(FQueryUpdateType(Rewrapped.GetAsUncompressed()));
+		}
+		const FTransactionUpdateType ProcessPayload = FTransactionUpdateType(Decoded.GetAsTransactionUpdate());
+		const FDatabaseUpdateType DbUpdateArg = FDatabaseUpdateType(ProcessPayload.Status.GetAsCommitted());
+	}, ListBytes);
+	const SIZE_T BaselineBytes = Counter.GetCountedBytes();
+
+	// Reference: the message decoded and its rows parsed on their own, which the pipeline cannot do with less
+	Counter.CountAllocations([&]()
+	{
+		const FServerMessageType Decoded = Deserialize<FServerMessageType>(Payload);
+		for (const FTableUpdateType& Table : Decoded.GetAsTransactionUpdate().Status.GetAsCommitted().Tables)
+		{
+			ParseRows(Table.Updates[0].GetAsUncompressed());
+		}
+	}, ListBytes);
+	const SIZE_T DecodeBytes = Counter.GetCountedBytes();
+
+	// The first message resolves the table ids and fills the caches, count the ones after it
+	FDbConnectionBaseTestAccess::ProcessServerMessage(*Connection, FDbConnectionBaseTestAccess::PreProcessMessage(*Connection, Frame));
+	const int32 UpdatesBefore = Tables[0]->NumUpdates.load();
+	UpdateEvents = 0;
+
+	FParsedServerMessage Parsed;
+	Counter.CountAllocations([&]()
+	{
+		Parsed = FDbConnectionBaseTestAccess::PreProcessMessage(*Connection, Frame);
+	}, ListBytes);
+	const SIZE_T PreProcessBytes = Counter.GetCountedBytes();
+	const int32 ProcessListAllocations = Counter.CountAllocations([&]() { FDbConnectionBaseTestAccess::ProcessServerMessage(*Connection, Parsed); }, ListBytes);
+	const SIZE_T ProcessBytes = Counter.GetCountedBytes();
+
+	const int64 RowBytes = int64(ListBytes) * 2 * TableCount;
+	LOG_INFO(TEXT("%lld row bytes received in %d row lists of %llu bytes"), RowBytes, TableCount * 2, uint64(ListBytes));
+	LOG_INFO(TEXT("Baseline, by-value accessors: %llu bytes in row list sized buffers per TransactionUpdate (%.1fx the rows)"),
+		uint64(BaselineBytes), double(BaselineBytes) / RowBytes);
+	LOG_INFO(TEXT("Pipeline: PreProcessMessage %llu bytes, ProcessServerMessage with the cache update %llu bytes (%.1fx the rows, decoding on its own %.1fx)"),
+		uint64(PreProcessBytes), uint64(ProcessBytes), double(PreProcessBytes + ProcessBytes) / RowBytes, double(DecodeBytes) / RowBytes);
+
+	bool bOk = true;
+	for (const TUniquePtr<FEntityHandlerTable>& Table : Tables)
+	{
+		if (Table->NumUpdates.load() != UpdatesBefore + 1 || Table->Num() != RowCount)
+		{
+			LOG_FAIL(TEXT("%s was updated %d times and caches %d rows, DbUpdate did not apply the message"), *Table->TableName, Table->NumUpdates.load() - UpdatesBefore, Table->Num());
+			bOk = false;
+		}
+	}
+	if (UpdateEvents != TableCount * RowCount)
+	{
+		LOG_FAIL(TEXT("Broadcast %d update events, expected %d"), UpdateEvents, TableCount * RowCount);
+		bOk = false;
+	}
+	if (PreProcessBytes > DecodeBytes)
+	{
+		LOG_FAIL(TEXT("PreProcessMessage copied %llu row bytes beyond decoding them"), uint64(PreProcessBytes - DecodeBytes));
+		bOk = false;
+	}
+	if (ProcessListAllocations != 0)
+	{
+		LOG_FAIL(TEXT("ProcessServerMessage copied %d row lists while applying them"), ProcessListAllocations);
+		bOk = false;
+	}
+
+	const uint64 Start = FPlatformTime::Cycles64();
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		FDbConnectionBaseTestAccess::ProcessServerMessage(*Connection, FDbConnectionBaseTestAccess::PreProcessMessage(*Connection, Frame));
+	}
+	LOG_INFO(TEXT("%.2f us per message of %d rows, decoded and applied"), FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - Start) * 1e6 / Iterations, TableCount * RowCount * 2);
+
+	// Rvalue access moves the payload out instead of copying it
+	FServerMessageType Owned = Message;
+	const uint8* RowsBefore = Owned.GetAsTransactionUpdate().Status.GetAsCommitted().Tables[0].Updates[0].GetAsUncompressed().Inserts.RowsData.GetData();
+	const FTransactionUpdateType Moved = MoveTemp(Owned).GetAsTransactionUpdate();
+	if (Moved.Status.GetAsCommitted().Tables[0].Updates[0].GetAsUncompressed().Inserts.RowsData.GetData() != RowsBefore)
+	{
+		LOG_FAIL(TEXT("Moving a payload out of FServerMessageType copied its rows"));
+		bOk = false;
+	}
+	return bOk;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FSpacetimeDBRegisteredTableDispatchTest,
+	"SpacetimeDB.Performance.RegisteredTableDispatch",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+	bool FSpacetimeDBRegisteredTableDispatchTest::RunTest(const FString& /*Parameters*/)
+{
+	using namespace SpacetimeDBPerf;
+	using namespace UE::SpacetimeDB;
+
+	constexpr int32 RowCount = 1000;
+
+	LOG_Category("Multi-table SubscribeMultiApplied through ApplyRegisteredTableUpdates");
+
+	UDbConnectionBase* Connection = NewObject<UDbConnectionBase>();
+	// Any row count applies distinct tables in parallel
+	Connection->SetParallelApplyMinRows(1);
+	FEntityHandlerTable Entities(TEXT("entities"));
+	FEntityHandlerTable Players(TEXT("players"));
+	Connection->RegisterTable<FEntityRow, FEntityHandlerTable, FEntityEventContext>(Entities.TableName, &Entities);
+	Connection->RegisterTable<FEntityRow, FEntityHandlerTable, FEntityEventContext>(Players.TableName, &Players);
+
+	int32 EntityInserts = 0, PlayerInserts = 0, EntityUpdates = 0, WrongContext = 0;
+	float LastUpdatedX = 0.0f;
+	FEntityEventContext Context;
+	Entities.OnInsert.AddLambda([&](const FEntityEventContext& InContext, const FEntityRow&) { ++EntityInserts; WrongContext += InContext.MessageId != Context.MessageId; });
+	Players.OnInsert.AddLambda([&](const FEntityEventContext& InContext, const FEntityRow&) { ++PlayerInserts; WrongContext += InContext.MessageId != Context.MessageId; });
+	Entities.OnUpdate.AddLambda([&](const FEntityEventContext& InContext, const FEntityRow&, const FEntityRow& NewRow)
+	{
+		++EntityUpdates;
+		LastUpdatedX = NewRow.Transform.X;
+		WrongContext += InContext.MessageId != Context.MessageId;
+	});
+
+	const auto Apply = [&](const TArray<FTableUpdateType>& Tables, int32 MessageId, bool& OutDistinct) -> int32
+	{
+		FSubscribeMultiAppliedType Applied;
+		Applied.Update.Tables = Tables;
+		const FParsedServerMessage Parsed = FDbConnectionBaseTestAccess::PreProcessMessage(*Connection, MakeServerFrame(FServerMessageType::SubscribeMultiApplied(Applied)));
+		const FDatabaseUpdateType& Update = Parsed.Message.GetAsSubscribeMultiApplied().Update;
+		const int32 NumResolved = FDbConnectionBaseTestAccess::ResolveTableUpdates(*Connection, Update, OutDistinct);
+		Context.MessageId = MessageId;
+		FDbConnectionBaseTestAccess::ApplyRegisteredTableUpdates(*Connection, Parsed, Update, &Context);
+		return NumResolved;
+	};
+
+	bool bOk = true;
+
+	// Two distinct tables and one without a handler, applied in parallel
+	TArray<FEntityRow> Rows;
+	for (int32 i = 0; i < RowCount; ++i)
+	{
+		Rows.Add(MakeEntity(i, float(i)));
+	}
+	bool bDistinct = false;
+	AddExpectedError(TEXT("No deserializer found for table unregistered"), EAutomationExpectedErrorFlags::Contains, 1);
+	AddExpectedError(TEXT("Skipping table unregistered updates due to missing deserializer"), EAutomationExpectedErrorFlags::Contains, 1);
+	const int32 NumResolved = Apply({
+		MakeTableUpdate(1, Entities.TableName, MakeQuery(Rows, {}), RowCount),
+		MakeTableUpdate(2, Players.TableName, MakeQuery(Rows, {}), RowCount),
+		MakeTableUpdate(3, TEXT("unregistered"), MakeQuery(Rows, {}), RowCount) }, 1, bDistinct);
+	if (NumResolved != 2 || !bDistinct)
+	{
+		LOG_FAIL(TEXT("Resolved %d handlers (distinct %d), expected the 2 registered tables as distinct"), NumResolved, int32(bDistinct));
+		bOk = false;
+	}
+	if (Entities.Num() != RowCount || Players.Num() != RowCount || EntityInserts != RowCount || PlayerInserts != RowCount)
+	{
+		LOG_FAIL(TEXT("Parallel apply cached %d/%d rows and broadcast %d/%d inserts, expected %d each"), Entities.Num(), Players.Num(), EntityInserts, PlayerInserts, RowCount);
+		bOk = false;
+	}
+
+	// The same table listed twice falls back to applying in order, the second update moves the row the first one moved
+	PlayerInserts = 0;
+	const int32 UpdatesBefore = Entities.NumUpdates.load();
+	const int32 DuplicateResolved = Apply({
+		MakeTableUpdate(1, Entities.TableName, MakeQuery({ MakeEntity(0, 100.0f) }, { MakeEntity(0, 0.0f) }), 2),
+		MakeTableUpdate(2, Players.TableName, MakeQuery({ MakeEntity(RowCount, 0.0f) }, {}), 1),
+		MakeTableUpdate(1, Entities.TableName, MakeQuery({ MakeEntity(0, 200.0f) }, { MakeEntity(0, 100.0f) }), 2) }, 2, bDistinct);
+	if (DuplicateResolved != 3 || bDistinct)
+	{
+		LOG_FAIL(TEXT("Resolved %d handlers (distinct %d), expected 3 with a table listed twice"), DuplicateResolved, int32(bDistinct));
+		bOk = false;
+	}
+	const FEntityRow* Moved = Entities.Find(0);
+	if (Entities.NumUpdates.load() - UpdatesBefore != 2 || !Moved || Moved->Transform.X != 200.0f || Entities.Num() != RowCount)
+	{
+		LOG_FAIL(TEXT("Duplicate table updates were not applied in order, entity 0 is at %.1f"), Moved ? Moved->Transform.X : -1.0f);
+		bOk = false;
+	}
+	if (Players.Num() != RowCount + 1 || PlayerInserts != 1)
+	{
+		LOG_FAIL(TEXT("Table between the duplicates cached %d rows and broadcast %d inserts"), Players.Num(), PlayerInserts);
+		bOk = false;
+	}
+	if (EntityUpdates == 0 || LastUpdatedX != 200.0f || EntityInserts != RowCount)
+	{
+		LOG_FAIL(TEXT("Duplicate table broadcast %d updates ending at %.1f and %d inserts"), EntityUpdates, LastUpdatedX, EntityInserts);
+		bOk = false;
+	}
+	if (WrongContext != 0)
+	{
+		LOG_FAIL(TEXT("%d events were broadcast with another message's context"), WrongContext);
+		bOk = false;
+	}
+
+	LOG_INFO(TEXT("%d updates of the duplicated table applied in order, %d update events"), Entities.NumUpdates.load() - UpdatesBefore, EntityUpdates);
+	return bOk;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FSpacetimeDBFramePoolRetentionTest,
+	"SpacetimeDB.Performance.FramePoolRetention",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+	bool FSpacetimeDBFramePoolRetentionTest::RunTest(const FString& /*Parameters*/)
+{
+	LOG_Category("Frame pool frees oversized buffers on release");
+
+	const TSharedRef<FWebsocketFramePool, ESPMode::ThreadSafe> Pool = MakeShared<FWebsocketFramePool, ESPMode::ThreadSafe>();
+	{
+		FWebsocketFrameBuffer Large = Pool->Acquire(16 * 1024 * 1024);
+		Large->SetNumUninitialized(16 * 1024 * 1024);
+	}
+	const int32 FreeAfterLarge = Pool->NumFree();
+	{
+		FWebsocketFrameBuffer Small = Pool->Acquire(4 * 1024);
+	}
+	const int32 FreeAfterSmall = Pool->NumFree();
+
+	LOG_INFO(TEXT("Idle buffers after a 16 MB frame %d, after a 4 KB frame %d"), FreeAfterLarge, FreeAfterSmall);
+	if (FreeAfterLarge != 0 || FreeAfterSmall != 1)
+	{
+		LOG_FAIL(TEXT("Expected the 16 MB buffer to be freed and the 4 KB one pooled"));
+		return false;
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FSpacetimeDBBrotliDecodeTest,
+	"SpacetimeDB.Performance.BrotliDecode",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+	bool FSpacetimeDBBrotliDecodeTest::RunTest(const FString& /*Parameters*/)
+{
+	using namespace UE::SpacetimeDB::Compression;
+
+	LOG_Category("Built-in Brotli decoder");
+
+	// Quality 11, 64 KB window: dictionary references, repeated distances and a complex prefix code
+	static const uint8 Compressed[] =
+	{
+		0xE2, 0x2C, 0x00, 0x8C, 0x23, 0xC1, 0x8E, 0x85, 0xFC, 0xC6, 0x11, 0xD5, 0x90, 0xD2, 0x0D, 0x8D,
+		0x2A, 0xCB, 0xC2, 0xD2, 0x1A, 0x24, 0x8F, 0x2E, 0xAD, 0x53, 0x0E, 0x38, 0x40, 0xAD, 0xB6, 0x16,
+		0xF8, 0xF1, 0x40, 0x27, 0xD0, 0x83, 0xC7, 0xF0, 0x79, 0x65, 0xB7, 0x94, 0xC3, 0x36, 0x46, 0x45,
+		0x8D, 0x90, 0x35, 0x0F, 0x64, 0xEB, 0x69, 0x38, 0xB3, 0xD7, 0xC4, 0x8B, 0x90, 0x12, 0x90, 0xB3,
+		0x67, 0xAF, 0x83, 0x1E, 0x89, 0x06
+	};
+	const char* Sentence = "The player moved over the world, then the server sent an update for every entity in view. ";
+	TArray<uint8> Expected;
+	for (int32 Repeat = 0; Repeat < 4; ++Repeat)
+	{
+		Expected.Append(reinterpret_cast<const uint8*>(Sentence), FCStringAnsi::Strlen(Sentence));
+	}
+
+	bool bOk = true;
+	TArray<uint8> Decoded;
+	const TCHAR* Error = nullptr;
+	const TArrayView<const uint8> Stream(Compressed, UE_ARRAY_COUNT(Compressed));
+	if (!DecodeBrotli(Stream, Decoded, Error) || Decoded != Expected)
+	{
+		LOG_FAIL(TEXT("Sample stream decoded to %d bytes, expected %d (%s)"), Decoded.Num(), Expected.Num(), Error ? Error : TEXT("mismatch"));
+		bOk = false;
+	}
+
+	// Truncated streams must fail, bit flips must either fail or decode without touching memory out of bounds
+	int32 TruncatedAccepted = 0;
+	for (int32 Length = 0; Length < Stream.Num(); ++Length)
+	{
+		TruncatedAccepted += DecodeBrotli(Stream.Left(Length), Decoded, Error) ? 1 : 0;
+	}
+	int32 CorruptedAccepted = 0;
+	TArray<uint8> Corrupted(Stream.GetData(), Stream.Num());
+	for (int32 Bit = 0; Bit < Corrupted.Num() * 8; ++Bit)
+	{
+		Corrupted[Bit / 8] ^= 1 << (Bit % 8);
+		CorruptedAccepted += DecodeBrotli(Corrupted, Decoded, Error) ? 1 : 0;
+		Corrupted[Bit / 8] ^= 1 << (Bit % 8);
+	}
+	LOG_INFO(TEXT("Truncations accepted %d of %d, single bit flips accepted %d of %d"), TruncatedAccepted, Stream.Num(), CorruptedAccepted, Stream.Num() * 8);
+	if (TruncatedAccepted > 0)
+	{
+		LOG_FAIL(TEXT("Truncated streams decoded successfully"));
+		bOk = false;
+	}
+
+	const int32 Iterations = 2000;
+	const double Start = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		DecodeBrotli(Stream, Decoded, Error);
+	}
+	const double Seconds = FPlatformTime::Seconds() - Start;
+	LOG_INFO(TEXT("%.1f MB/s decoded"), Seconds > 0.0 ? Expected.Num() * static_cast<double>(Iterations) / Seconds / (1024.0 * 1024.0) : 0.0);
+
+	return bOk;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FSpacetimeDBApplyThreadIndexLookupTest,
+	"SpacetimeDB.Performance.ApplyThreadIndexLookups",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+	bool FSpacetimeDBApplyThreadIndexLookupTest::RunTest(const FString& /*Parameters*/)
+{
+	using namespace SpacetimeDBPerf;
+	using namespace UE::SpacetimeDB;
+
+	constexpr int32 RowCount = 10000;
+	constexpr int32 Versions = 4;
+
+	LOG_Category("Index lookups with diffs applied ahead of the game thread");
+
+	// Version v moves the first v * 100 rows to Y = v and turns them into players
+	const TRowKeyWriter<FEntityRow> WriteKey = MakeRowKeyWriter<FEntityRow, FEntityRowTable>();
+	TArray<FEntityRow> Rows;
+	for (int32 i = 0; i < RowCount; ++i)
+	{
+		Rows.Add(FEntityRow{ uint32(i), TEXT("npc"), FTransformArgs{ float(i), 0.0f, 0.0f, 0.0f, 0.0f, 0.0f } });
+	}
+
+	UClientCache<FEntityRow> Cache;
+	TSharedPtr<FTableCache<FEntityRow>> Table = Cache.GetOrAdd(TEXT("entities"));
+	Table->AddUniqueConstraint<uint32>(TEXT("entity_id"), [](const FEntityRow& Row) { return Row.EntityId; });
+	Table->AddMultiKeyBTreeIndex<FString>(TEXT("entity_type"), [](const FEntityRow& Row) { return Row.EntityType; });
+	Table->EnableSnapshots();
+	{
+		TArray<FWithBsatn<FEntityRow>> Inserts;
+		ParseRowListWithBsatn(MakeRowList(Rows, false), Inserts, WriteKey);
+		Cache.ApplyDiff(TEXT("entities"), MoveTemp(Inserts), {});
+	}
+	Table->SnapshotPublisher->DeferVisibility();
+
+	// The apply thread runs every version before the game thread broadcasts the first one
+	TArray<TSharedPtr<const FTableSnapshot<FEntityRow>>> Applied;
+	int32 ChangedRows = 0;
+	for (int32 Version = 1; Version <= Versions; ++Version)
+	{
+		TArray<FEntityRow> Deleted, Inserted;
+		for (int32 i = 0; i < Version * 100; ++i)
+		{
+			Deleted.Add(Rows[i]);
+			Rows[i].EntityType = TEXT("player");
+			Rows[i].Transform.Y = float(Version);
+			Inserted.Add(Rows[i]);
+		}
+		TArray<FWithBsatn<FEntityRow>> Inserts, Deletes;
+		ParseRowListWithBsatn(MakeRowList(Inserted, false), Inserts, WriteKey);
+		ParseRowListWithBsatn(MakeRowList(Deleted, false), Deletes, WriteKey);
+		Cache.ApplyDiff(TEXT("entities"), MoveTemp(Inserts), Deletes);
+		Applied.Add(Table->SnapshotPublisher->Pin());
+		ChangedRows += Version * 100;
+	}
+
+	// Added while versions are pending, it starts from the visible rows like the other indices
+	Table->AddSpatialIndex(TEXT("transform"), 2000.0f, [](const FEntityRow& Row) { return GetTransformLocation(Row.Transform); });
+
+	// Lookups on the game thread must match the version it broadcast last, never one the apply thread is ahead with
+	const auto CheckVisibleVersion = [&](int32 Version) -> bool
+	{
+		const FEntityRow* First = Table->FindByUniqueIndex<uint32>(TEXT("entity_id"), 0u);
+		TArray<FEntityRow> Players;
+		Table->FindByMultiKeyBTreeIndex<FString>(Players, TEXT("entity_type"), TEXT("player"));
+		TArray<TSharedPtr<FEntityRow>> Near;
+		Table->FindSpatialIndex(TEXT("transform"))->FindInRadius(FVector(0.0, double(Version), 0.0), 0.5f, Near);
+		const bool bNearFirst = Near.Num() == 1 && Near[0]->EntityId == 0;
+		if (!First || First->Transform.Y != float(Version) || Players.Num() != Version * 100 || !bNearFirst)
+		{
+			LOG_FAIL(TEXT("Visible version %d: entity 0 at Y %f, %d players, %d rows near it"),
+				Version, First ? First->Transform.Y : -1.0f, Players.Num(), Near.Num());
+			return false;
+		}
+		return true;
+	};
+
+	bool bOk = CheckVisibleVersion(0);
+	double ReplaySeconds = 0.0;
+	for (int32 Version = 1; Version <= Versions && bOk; ++Version)
+	{
+		const double Start = FPlatformTime::Seconds();
+		Table->SnapshotPublisher->MakeVisible(Applied[Version - 1]);
+		ReplaySeconds += FPlatformTime::Seconds() - Start;
+		bOk = CheckVisibleVersion(Version);
+	}
+	LOG_INFO(TEXT("%d versions of up to %d changed rows, %.3f us per row to bring the indices up to date"),
+		Versions, Versions * 100, ReplaySeconds * 1e6 / ChangedRows);
+	return bOk;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FSpacetimeDBTablePagingTest,
+	"SpacetimeDB.Performance.TablePaging",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+	bool FSpacetimeDBTablePagingTest::RunTest(const FString& /*Parameters*/)
+{
+	using namespace SpacetimeDBPerf;
+	using namespace UE::SpacetimeDB;
+
+	constexpr int32 RowCount = 50000;
+	constexpr int32 PageSize = 100;
+
+	LOG_Category("Paging through a whole table with removed rows, from the cache and from a snapshot");
+
+	// Every third row is deleted again, leaving holes in the cache entries and rows moved within the snapshot buckets
+	const TRowKeyWriter<FEntityRow> WriteKey = MakeRowKeyWriter<FEntityRow, FEntityRowTable>();
+	TArray<FEntityRow> Rows, Removed;
+	for (int32 i = 0; i < RowCount; ++i)
+	{
+		Rows.Add(FEntityRow{ uint32(i), TEXT("npc"), FTransformArgs{ float(i), 0.0f, 0.0f, 0.0f, 0.0f, 0.0f } });
+		if (i % 3 == 0)
+		{
+			Removed.Add(Rows.Last());
+		}
+	}
+	const int32 Remaining = RowCount - Removed.Num();
+
+	const FString TableName(TEXT("entities"));
+	TSharedPtr<UClientCache<FEntityRow>> Cache = MakeShared<UClientCache<FEntityRow>>();
+	TSharedPtr<FTableCache<FEntityRow>> Table = Cache->GetOrAdd(TableName);
+	Table->EnableSnapshots();
+	{
+		TArray<FWithBsatn<FEntityRow>> Inserts;
+		ParseRowListWithBsatn(MakeRowList(Rows, false), Inserts, WriteKey);
+		Cache->ApplyDiff(TableName, MoveTemp(Inserts), {});
+	}
+	{
+		TArray<FWithBsatn<FEntityRow>> Deletes;
+		ParseRowListWithBsatn(MakeRowList(Removed, false), Deletes, WriteKey);
+		Cache->ApplyDiff(TableName, {}, Deletes);
+	}
+
+	const uint64 ForEachStart = FPlatformTime::Cycles64();
+	int32 ForEachRows = 0;
+	ForEachRowInTable<FEntityRow>(Cache, TableName, [&ForEachRows](const FEntityRow&) { ++ForEachRows; });
+	const double ForEachSeconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - ForEachStart);
+
+	bool bOk = true;
+	const auto PageAll = [&](const TCHAR* Name)
+	{
+		TArray<int32> Visits;
+		Visits.SetNumZeroed(RowCount);
+		int32 Pages = 0;
+		int32 Cursor = 0;
+		bool bHasMore = true;
+		const uint64 Start = FPlatformTime::Cycles64();
+		while (bHasMore)
+		{
+			int32 NextCursor = 0;
+			for (const FEntityRow& Row : GetRowPageFromTable<FEntityRow>(Cache, TableName, Cursor, PageSize, NextCursor, bHasMore))
+			{
+				++Visits[Row.EntityId];
+			}
+			Cursor = NextCursor;
+			++Pages;
+		}
+		const double Seconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - Start);
+		LOG_INFO(TEXT("%-8s %d pages of %d in %.3f ms, %.1fx one ForEach over the table"), Name, Pages, PageSize, Seconds * 1e3, Seconds / FMath::Max(ForEachSeconds, 1e-9));
+
+		for (int32 i = 0; i < RowCount; ++i)
+		{
+			const int32 Expected = i % 3 == 0 ? 0 : 1;
+			if (Visits[i] != Expected)
+			{
+				LOG_FAIL(TEXT("%s visited row %d %d times, expected %d"), Name, i, Visits[i], Expected);
+				bOk = false;
+				break;
+			}
+		}
+		// Only the last page may be short, removed rows are skipped instead of leaving gaps in a page
+		if (Pages != FMath::DivideAndRoundUp(Remaining, PageSize))
+		{
+			LOG_FAIL(TEXT("%s read %d rows in %d pages of %d"), Name, Remaining, Pages, PageSize);
+			bOk = false;
+		}
+	};
+
+	PageAll(TEXT("Cache"));
+	Table->SnapshotPublisher->DeferVisibility();
+	if (!Table->ReadsThroughSnapshots() || Table->PinSnapshot()->Num() != Remaining)
+	{
+		LOG_FAIL(TEXT("The table does not read through a snapshot of the %d remaining rows"), Remaining);
+		return false;
+	}
+	PageAll(TEXT("Snapshot"));
+
+	if (ForEachRows != Remaining)
+	{
+		LOG_FAIL(TEXT("ForEach visited %d rows, expected %d"), ForEachRows, Remaining);
+		bOk = false;
+	}
+	return bOk;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FSpacetimeDBFrameBudgetTest,
+	"SpacetimeDB.Performance.FrameBudget",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+	bool FSpacetimeDBFrameBudgetTest::RunTest(const FString& /*Parameters*/)
+{
+	using namespace SpacetimeDBPerf;
+	using namespace UE::SpacetimeDB;
+
+	constexpr int32 Messages = 8;
+	constexpr int32 RowsPerMessage = 100;
+	constexpr float ApplyMs = 2.0f;
+
+	LOG_Category("FrameTick with a time budget carries whole transactions over to the next tick");
+
+	UTestDbConnection* Connection = NewObject<UTestDbConnection>();
+	Connection->SetParallelApplyMinRows(0);
+	FEntityEventContext Context;
+	Connection->TableEventContext = &Context;
+	FEntityHandlerTable Entities(TEXT("entities"));
+	Connection->RegisterTable<FEntityRow, FEntityHandlerTable, FEntityEventContext>(Entities.TableName, &Entities);
+
+	// The first row of every message holds its apply up for longer than the budget
+	int32 Inserts = 0;
+	Entities.OnInsert.AddLambda([&Inserts](const FEntityEventContext&, const FEntityRow& Row)
+	{
+		if (Row.EntityId % RowsPerMessage == 0)
+		{
+			FPlatformProcess::Sleep(ApplyMs / 1000.0f);
+		}
+		++Inserts;
+	});
+
+	const auto ReceiveMessages = [&](int32 FirstMessage)
+	{
+		for (int32 Message = FirstMessage; Message < FirstMessage + Messages; ++Message)
+		{
+			TArray<FEntityRow> Rows;
+			for (int32 i = 0; i < RowsPerMessage; ++i)
+			{
+				Rows.Add(MakeEntity(Message * RowsPerMessage + i, 0.0f));
+			}
+			FDatabaseUpdateType Database;
+			Database.Tables.Add(MakeTableUpdate(1, Entities.TableName, MakeQuery(Rows, {}), RowsPerMessage));
+			FTransactionUpdateType Transaction;
+			Transaction.Status = FUpdateStatusType::Committed(Database);
+			FDbConnectionBaseTestAccess::ReceiveDecodedFrame(*Connection, MakeServerFrame(FServerMessageType::TransactionUpdate(Transaction)));
+		}
+	};
+
+	bool bOk = true;
+
+	// A burst waits a whole apply before the first tick, which then has to leave most of it for later
+	ReceiveMessages(0);
+	FPlatformProcess::Sleep(ApplyMs / 1000.0f);
+	const float OldestAgeMs = Connection->GetOldestPendingMessageAgeMs();
+	if (Connection->GetPendingMessageCount() != Messages || OldestAgeMs < ApplyMs)
+	{
+		LOG_FAIL(TEXT("Backlog of %d messages reported as %d, oldest %.2f ms old"), Messages, Connection->GetPendingMessageCount(), OldestAgeMs);
+		bOk = false;
+	}
+
+	Connection->SetFrameBudgetMs(ApplyMs / 2.0f);
+	int32 Ticks = 0;
+	double MaxTickMs = 0.0;
+	while (bOk && Connection->GetPendingMessageCount() > 0 && Ticks < Messages)
+	{
+		const int32 PendingBefore = Connection->GetPendingMessageCount();
+		const uint64 Start = FPlatformTime::Cycles64();
+		Connection->FrameTick();
+		MaxTickMs = FMath::Max(MaxTickMs, FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - Start) * 1e3);
+		++Ticks;
+
+		// Each message outlasts the budget, so a tick applies exactly one and never part of one
+		const int32 Applied = PendingBefore - Connection->GetPendingMessageCount();
+		if (Applied != 1 || Inserts != Ticks * RowsPerMessage)
+		{
+			LOG_FAIL(TEXT("Tick %d applied %d messages and %d rows in total, expected one whole message per tick"), Ticks, Applied, Inserts);
+			bOk = false;
+		}
+	}
+	if (Ticks != Messages || Entities.NumUpdates.load() != Messages || Connection->GetOldestPendingMessageAgeMs() != 0.0f)
+	{
+		LOG_FAIL(TEXT("Budgeted ticks applied %d updates in %d ticks, %d messages left"), Entities.NumUpdates.load(), Ticks, Connection->GetPendingMessageCount());
+		bOk = false;
+	}
+
+	// Without a budget the next tick drains the whole backlog
+	Connection->SetFrameBudgetMs(0.0f);
+	ReceiveMessages(Messages);
+	const uint64 Start = FPlatformTime::Cycles64();
+	Connection->FrameTick();
+	const double DrainMs = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - Start) * 1e3;
+	if (Connection->GetPendingMessageCount() != 0 || Inserts != 2 * Messages * RowsPerMessage)
+	{
+		LOG_FAIL(TEXT("Unbudgeted tick left %d messages and broadcast %d inserts"), Connection->GetPendingMessageCount(), Inserts);
+		bOk = false;
+	}
+
+	LOG_INFO(TEXT("Backlog of %d messages of %.1f ms each: %d budgeted ticks of at most %.2f ms, or one tick of %.2f ms"),
+		Messages, ApplyMs, Ticks, MaxTickMs, DrainMs);
+	return bOk;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FSpacetimeDBDecompressPayloadViewTest,
+	"SpacetimeDB.Performance.DecompressPayloadViews",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+	bool FSpacetimeDBDecompressPayloadViewTest::RunTest(const FString& /*Parameters*/)
+{
+	using namespace SpacetimeDBPerf;
+	using namespace UE::SpacetimeDB;
+
+	constexpr int32 RawSize = 256 * 1024;
+	constexpr int32 Iterations = 50;
+
+	LOG_Category("Payloads decompressed from a view of the frame into a reused buffer");
+
+	// Bytes of a few distinct values, compressible about as well as row data
+	FRandomStream Random(42);
+	TArray<uint8> Raw;
+	Raw.SetNumUninitialized(RawSize);
+	for (uint8& Byte : Raw)
+	{
+		Byte = static_cast<uint8>(Random.RandRange(0, 15));
+	}
+	int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Gzip, RawSize);
+	TArray<uint8> Gzip;
+	Gzip.SetNumUninitialized(CompressedSize);
+	if (!FCompression::CompressMemory(NAME_Gzip, Gzip.GetData(), CompressedSize, Raw.GetData(), RawSize))
+	{
+		LOG_FAIL(TEXT("Could not gzip the payload"));
+		return false;
+	}
+	Gzip.SetNum(CompressedSize);
+
+	FCountingMalloc& Counter = GetCountingMalloc();
+	const auto Matches = [&Raw](TArrayView<const uint8> View)
+	{
+		return View.Num() == Raw.Num() && FMemory::Memcmp(View.GetData(), Raw.GetData(), Raw.Num()) == 0;
+	};
+	bool bOk = true;
+
+	// Uncompressed payloads are read in place, the scratch buffer is never touched
+	TArray<uint8> Scratch;
+	TArrayView<const uint8> View;
+	bool bDecoded = false;
+	const int32 UncompressedAllocations = Counter.CountAllocations([&]()
+	{
+		bDecoded = Compression::DecompressPayload(ECompressableQueryUpdateTag::Uncompressed, Raw, Scratch, View);
+	});
+	if (!bDecoded || View.GetData() != Raw.GetData() || View.Num() != RawSize || UncompressedAllocations != 0 || Scratch.Max() != 0)
+	{
+		LOG_FAIL(TEXT("Uncompressed payload was copied, %d allocations"), UncompressedAllocations);
+		bOk = false;
+	}
+
+	// Gzip sizes the output once from a plausible trailer, then reuses it for the next payload
+	const int32 FirstAllocations = Counter.CountAllocations([&]()
+	{
+		bDecoded = Compression::DecompressPayload(ECompressableQueryUpdateTag::Gzip, Gzip, Scratch, View);
+	}, RawSize);
+	if (!bDecoded || !Matches(View) || View.GetData() != Scratch.GetData() || FirstAllocations != 1 || Scratch.Max() >= RawSize * 2)
+	{
+		LOG_FAIL(TEXT("First gzip decode made %d payload sized allocations into a %d byte buffer"), FirstAllocations, Scratch.Max());
+		bOk = false;
+	}
+	const int32 ReusedAllocations = Counter.CountAllocations([&]()
+	{
+		bDecoded = Compression::DecompressPayload(ECompressableQueryUpdateTag::Gzip, Gzip, Scratch, View);
+	}, RawSize);
+	if (!bDecoded || !Matches(View) || ReusedAllocations != 0)
+	{
+		LOG_FAIL(TEXT("Gzip decode into a reused buffer made %d payload sized allocations"), ReusedAllocations);
+		bOk = false;
+	}
+
+	AddExpectedError(TEXT("Gzip decompression failed"), EAutomationExpectedErrorFlags::Contains, 2);
+
+	// A trailer claiming 4 GB is not trusted for the allocation, the buffer starts at four times the input plus slack
+	// and inflate rejects the stream
+	TArray<uint8> Lying = Gzip;
+	FMemory::Memset(Lying.GetData() + Lying.Num() - 4, 0xFF, 4);
+	TArray<uint8> LyingOut;
+	if (Compression::DecompressGzip(Lying, LyingOut) || LyingOut.Max() > Lying.Num() * 8)
+	{
+		LOG_FAIL(TEXT("Gzip with a lying trailer decoded into a %d byte buffer"), LyingOut.Max());
+		bOk = false;
+	}
+
+	// A truncated stream fails instead of handing back part of the payload
+	TArray<uint8> Truncated(Gzip.GetData(), Gzip.Num() / 2);
+	TArray<uint8> TruncatedOut;
+	if (Compression::DecompressGzip(Truncated, TruncatedOut))
+	{
+		LOG_FAIL(TEXT("Truncated gzip stream decoded to %d bytes"), TruncatedOut.Num());
+		bOk = false;
+	}
+
+	const uint64 Start = FPlatformTime::Cycles64();
+	for (int32 i = 0; i < Iterations; ++i)
+	{
+		Compression::DecompressPayload(ECompressableQueryUpdateTag::Gzip, Gzip, Scratch, View);
+	}
+	const double Seconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - Start);
+	LOG_INFO(TEXT("%d byte payload gzipped to %d bytes, inflated at %.1f MB/s into a reused buffer"),
+		RawSize, Gzip.Num(), double(RawSize) * Iterations / FMath::Max(Seconds, 1e-9) / (1024.0 * 1024.0));
+	return bOk;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FSpacetimeDBPreprocessedTableDataTest,
+	"SpacetimeDB.Performance.PreprocessedTableData",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+	bool FSpacetimeDBPreprocessedTableDataTest::RunTest(const FString& /*Parameters*/)
+{
+	using namespace SpacetimeDBPerf;
+	using namespace UE::SpacetimeDB;
+
+	constexpr int32 RowCount = 1000;
+
+	LOG_Category("Preprocessed rows carried by their message, next to a table without a handler");
+
+	UTestDbConnection* Connection = NewObject<UTestDbConnection>();
+	Connection->SetParallelApplyMinRows(0);
+	FEntityEventContext Context;
+	Connection->TableEventContext = &Context;
+	FEntityHandlerTable Entities(TEXT("entities"));
+	FEntityHandlerTable Players(TEXT("players"));
+	Connection->RegisterTable<FEntityRow, FEntityHandlerTable, FEntityEventContext>(Entities.TableName, &Entities);
+	Connection->RegisterTable<FEntityRow, FEntityHandlerTable, FEntityEventContext>(Players.TableName, &Players);
+
+	// Rows of message Message are placed at X = Message, so a row applied from the wrong message shows
+	const auto MakeRows = [](int32 FirstId, float X)
+	{
+		TArray<FEntityRow> Rows;
+		for (int32 i = 0; i < RowCount; ++i)
+		{
+			Rows.Add(MakeEntity(FirstId + i, X));
+		}
+		return Rows;
+	};
+	const auto PreProcess = [&](TArray<FTableUpdateType> Tables)
+	{
+		FTransactionUpdateType Transaction;
+		FDatabaseUpdateType Database;
+		Database.Tables = MoveTemp(Tables);
+		Transaction.Status = FUpdateStatusType::Committed(Database);
+		return FDbConnectionBaseTestAccess::PreProcessMessage(*Connection, MakeServerFrame(FServerMessageType::TransactionUpdate(Transaction)));
+	};
+
+	// The unregistered table comes first, where a queue of preprocessed tables would hand its slot to the next table
+	AddExpectedError(TEXT("No deserializer found for table unregistered"), EAutomationExpectedErrorFlags::Contains, 1);
+	AddExpectedError(TEXT("Skipping table unregistered updates due to missing deserializer"), EAutomationExpectedErrorFlags::Contains, 1);
+	const FParsedServerMessage First = PreProcess({
+		MakeTableUpdate(3, TEXT("unregistered"), MakeQuery(MakeRows(0, 1.0f), {}), RowCount),
+		MakeTableUpdate(1, Entities.TableName, MakeQuery(MakeRows(0, 1.0f), {}), RowCount),
+		MakeTableUpdate(2, Players.TableName, MakeQuery(MakeRows(0, 1.0f), {}), RowCount) });
+	const FParsedServerMessage Second = PreProcess({
+		MakeTableUpdate(1, Entities.TableName, MakeQuery(MakeRows(RowCount, 2.0f), {}), RowCount) });
+
+	bool bOk = true;
+	if (First.TableData.Num() != 3 || First.TableData[0].IsValid()
+		|| !First.TableData[1].IsValid() || First.TableData[1]->NumRows() != RowCount
+		|| !First.TableData[2].IsValid() || First.TableData[2]->NumRows() != RowCount)
+	{
+		LOG_FAIL(TEXT("First message carries %d preprocessed tables, expected none for the unregistered table then both registered ones"), First.TableData.Num());
+		bOk = false;
+	}
+	if (Second.TableData.Num() != 1 || !Second.TableData[0].IsValid() || Second.TableData[0]->NumRows() != RowCount)
+	{
+		LOG_FAIL(TEXT("Second message carries %d preprocessed tables, expected 1"), Second.TableData.Num());
+		bOk = false;
+	}
+
+	// Processed in the opposite order, each message still applies only its own rows
+	const uint64 Start = FPlatformTime::Cycles64();
+	FDbConnectionBaseTestAccess::ProcessServerMessage(*Connection, Second);
+	FDbConnectionBaseTestAccess::ProcessServerMessage(*Connection, First);
+	const double Seconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - Start);
+
+	const FEntityRow* FirstEntity = Entities.Find(0);
+	const FEntityRow* SecondEntity = Entities.Find(RowCount);
+	const FEntityRow* Player = Players.Find(0);
+	if (Entities.Num() != 2 * RowCount || Players.Num() != RowCount || Players.Find(RowCount)
+		|| !FirstEntity || FirstEntity->Transform.X != 1.0f || !SecondEntity || SecondEntity->Transform.X != 2.0f
+		|| !Player || Player->Transform.X != 1.0f)
+	{
+		LOG_FAIL(TEXT("Tables cached %d entities and %d players, rows were paired with the wrong message"), Entities.Num(), Players.Num());
+		bOk = false;
+	}
+
+	LOG_INFO(TEXT("Applied %d preprocessed rows from 2 messages in %.3f ms"), 3 * RowCount, Seconds * 1e3);
+	return bOk;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FSpacetimeDBTableIdDispatchTest,
+	"SpacetimeDB.Performance.TableIdDispatch",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+	bool FSpacetimeDBTableIdDispatchTest::RunTest(const FString& /*Parameters*/)
+{
+	using namespace SpacetimeDBPerf;
+	using namespace UE::SpacetimeDB;
+
+	constexpr int32 TableCount = 16;
+	constexpr int32 Iterations = 10000;
+	// Beyond the ids the connection indexes, these are resolved by name on every update
+	constexpr uint32 UnindexedTableId = 1u << 20;
+
+	LOG_Category("Table deserializers and update handlers resolved by name once, then dispatched by table id");
+
+	UDbConnectionBase* Connection = NewObject<UDbConnectionBase>();
+	TArray<TUniquePtr<FEntityHandlerTable>> Tables;
+	FDatabaseUpdateType Indexed, Unindexed;
+	for (int32 Table = 0; Table < TableCount; ++Table)
+	{
+		FEntityHandlerTable& Handler = *Tables.Add_GetRef(MakeUnique<FEntityHandlerTable>(FString::Printf(TEXT("table_%d"), Table)));
+		Connection->RegisterTable<FEntityRow, FEntityHandlerTable, FEntityEventContext>(Handler.TableName, &Handler);
+		Indexed.Tables.Add(MakeTableUpdate(Table + 1, Handler.TableName, MakeQuery({}, {}), 0));
+		Unindexed.Tables.Add(MakeTableUpdate(UnindexedTableId + Table, Handler.TableName, MakeQuery({}, {}), 0));
+	}
+
+	bool bOk = true;
+	bool bDistinct = false;
+	if (FDbConnectionBaseTestAccess::ResolveTableUpdates(*Connection, Indexed, bDistinct) != TableCount
+		|| FDbConnectionBaseTestAccess::ResolveTableUpdates(*Connection, Unindexed, bDistinct) != TableCount)
+	{
+		LOG_FAIL(TEXT("Registered tables were not all resolved by name"));
+		bOk = false;
+	}
+
+	// Once resolved the id alone picks the table, the name is not looked at again
+	FDatabaseUpdateType Renamed;
+	Renamed.Tables.Add(MakeTableUpdate(1, TEXT("renamed"), MakeQuery({ MakeEntity(0, 0.0f) }, {}), 1));
+	FTransactionUpdateType Transaction;
+	Transaction.Status = FUpdateStatusType::Committed(Renamed);
+	const FParsedServerMessage Parsed = FDbConnectionBaseTestAccess::PreProcessMessage(*Connection, MakeServerFrame(FServerMessageType::TransactionUpdate(Transaction)));
+	if (FDbConnectionBaseTestAccess::ResolveTableUpdates(*Connection, Renamed, bDistinct) != 1
+		|| Parsed.TableData.Num() != 1 || !Parsed.TableData[0].IsValid() || Parsed.TableData[0]->NumRows() != 1)
+	{
+		LOG_FAIL(TEXT("Table id 1 was resolved by name again instead of through the id"));
+		bOk = false;
+	}
+
+	// Ids too large to index keep working through the name
+	FDatabaseUpdateType UnindexedRenamed;
+	UnindexedRenamed.Tables.Add(MakeTableUpdate(UnindexedTableId, TEXT("renamed"), MakeQuery({}, {}), 0));
+	if (FDbConnectionBaseTestAccess::ResolveTableUpdates(*Connection, UnindexedRenamed, bDistinct) != 0)
+	{
+		LOG_FAIL(TEXT("Table id %u was resolved from a stale cache instead of by name"), UnindexedTableId);
+		bOk = false;
+	}
+
+	// A later registration may move a name to another handler, the handler ids are resolved again
+	FEntityHandlerTable Late(TEXT("late"));
+	Connection->RegisterTable<FEntityRow, FEntityHandlerTable, FEntityEventContext>(Late.TableName, &Late);
+	if (FDbConnectionBaseTestAccess::ResolveTableUpdates(*Connection, Renamed, bDistinct) != 0
+		|| FDbConnectionBaseTestAccess::ResolveTableUpdates(*Connection, Indexed, bDistinct) != TableCount)
+	{
+		LOG_FAIL(TEXT("Handler ids resolved before a registration were kept"));
+		bOk = false;
+	}
+
+	const auto Measure = [&](const FDatabaseUpdateType& Update)
+	{
+		int32 Resolved = 0;
+		const uint64 Start = FPlatformTime::Cycles64();
+		for (int32 i = 0; i < Iterations; ++i)
+		{
+			Resolved += FDbConnectionBaseTestAccess::ResolveTableUpdates(*Connection, Update, bDistinct);
+		}
+		const double Seconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - Start);
+		if (Resolved != Iterations * TableCount)
+		{
+			LOG_FAIL(TEXT("Resolved %d of %d table updates"), Resolved, Iterations * TableCount);
+			bOk = false;
+		}
+		return Seconds * 1e9 / (double(Iterations) * TableCount);
+	};
+	const double IdNs = Measure(Indexed);
+	const double NameNs = Measure(Unindexed);
+	LOG_INFO(TEXT("Handler lookup per table update: %.1f ns by id, %.1f ns by name under the lock"), IdNs, NameNs);
+	return bOk;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FSpacetimeDBReducerDispatchTest,
+	"SpacetimeDB.Performance.ReducerDispatch",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+	bool FSpacetimeDBReducerDispatchTest::RunTest(const FString& /*Parameters*/)
+{
+	using namespace SpacetimeDBPerf;
+	using namespace UE::SpacetimeDB;
+
+	constexpr int32 Iterations = 200000;
+
+	LOG_Category("Reducer names dispatched on a hash switch, reducer hooks called once per transaction");
+
+	// The reducers of the generated bindings, case labels hash the literal at compile time and the received name at runtime
+	const TArray<FString> Names = { TEXT("connect"), TEXT("disconnect"), TEXT("enter_game"), TEXT("move_all_players"),
+		TEXT("player_spawned"), TEXT("respawn"), TEXT("update_player_input") };
+
+	const auto DispatchByHash = [](const FString& Name) -> int32
+	{
+		switch (ReducerNameHash(Name))
+		{
+		case ReducerNameHash(TEXT("connect")): return Name.Equals(TEXT("connect"), ESearchCase::CaseSensitive) ? 0 : -1;
+		case ReducerNameHash(TEXT("disconnect")): return Name.Equals(TEXT("disconnect"), ESearchCase::CaseSensitive) ? 1 : -1;
+		case ReducerNameHash(TEXT("enter_game")): return Name.Equals(TEXT("enter_game"), ESearchCase::CaseSensitive) ? 2 : -1;
+		case ReducerNameHash(TEXT("move_all_players")): return Name.Equals(TEXT("move_all_players"), ESearchCase::CaseSensitive) ? 3 : -1;
+		case ReducerNameHash(TEXT("player_spawned")): return Name.Equals(TEXT("player_spawned"), ESearchCase::CaseSensitive) ? 4 : -1;
+		case ReducerNameHash(TEXT("respawn")): return Name.Equals(TEXT("respawn"), ESearchCase::CaseSensitive) ? 5 : -1;
+		case ReducerNameHash(TEXT("update_player_input")): return Name.Equals(TEXT("update_player_input"), ESearchCase::CaseSensitive) ? 6 : -1;
+		default: return -1;
+		}
+	};
+	// What the generated DecodeReducer did before, one comparison per reducer in turn
+	const auto DispatchByComparison = [&Names](const FString& Name) -> int32
+	{
+		for (int32 Index = 0; Index < Names.Num(); ++Index)
+		{
+			if (Name.Equals(Names[Index], ESearchCase::CaseSensitive))
+			{
+				return Index;
+			}
+		}
+		return -1;
+	};
+
+	bool bOk = true;
+	for (int32 Index = 0; Index < Names.Num(); ++Index)
+	{
+		if (DispatchByHash(Names[Index]) != Index)
+		{
+			LOG_FAIL(TEXT("Reducer %s was not dispatched to its case"), *Names[Index]);
+			bOk = false;
+		}
+	}
+	if (DispatchByHash(TEXT("Update_Player_Input")) != -1 || DispatchByHash(TEXT("unknown")) != -1)
+	{
+		LOG_FAIL(TEXT("An unknown reducer name was dispatched to a reducer"));
+		bOk = false;
+	}
+
+	const auto Measure = [&](TFunctionRef<int32(const FString&)> Dispatch)
+	{
+		int32 Wrong = 0;
+		const uint64 Start = FPlatformTime::Cycles64();
+		for (int32 i = 0; i < Iterations; ++i)
+		{
+			Wrong += Dispatch(Names[i % Names.Num()]) != i % Names.Num();
+		}
+		const double Seconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - Start);
+		if (Wrong != 0)
+		{
+			LOG_FAIL(TEXT("Dispatch picked the wrong reducer %d times"), Wrong);
+			bOk = false;
+		}
+		return Seconds * 1e9 / Iterations;
+	};
+	const double HashNs = Measure(DispatchByHash);
+	const double CompareNs = Measure(DispatchByComparison);
+
+	// Committed and failed transactions each call BeginReducerEvent once, ahead of every callback that decodes the reducer
+	UTestDbConnection* Connection = NewObject<UTestDbConnection>();
+	const auto Process = [&](const FUpdateStatusType& Status)
+	{
+		FTransactionUpdateType Transaction;
+		Transaction.Status = Status;
+		Transaction.ReducerCall.ReducerName = TEXT("update_player_input");
+		Connection->ReducerEventCalls.Reset();
+		FDbConnectionBaseTestAccess::ProcessServerMessage(*Connection,
+			FDbConnectionBaseTestAccess::PreProcessMessage(*Connection, MakeServerFrame(FServerMessageType::TransactionUpdate(Transaction))));
+		return FString::Join(Connection->ReducerEventCalls, TEXT(", "));
+	};
+	const FString Committed = Process(FUpdateStatusType::Committed(FDatabaseUpdateType()));
+	const FString Failed = Process(FUpdateStatusType::Failed(TEXT("error")));
+	if (Committed != TEXT("Begin update_player_input, DbUpdate, Reducer update_player_input, End"))
+	{
+		LOG_FAIL(TEXT("Committed transaction called %s"), *Committed);
+		bOk = false;
+	}
+	if (Failed != TEXT("Begin update_player_input, Reducer update_player_input, Failed error, End"))
+	{
+		LOG_FAIL(TEXT("Failed transaction called %s"), *Failed);
+		bOk = false;
+	}
+
+	LOG_INFO(TEXT("%d reducer names: %.1f ns per dispatch on the hash, %.1f ns comparing names in turn"), Names.Num(), HashNs, CompareNs);
+	return bOk;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FSpacetimeDBOutgoingSchedulerTest,
+	"SpacetimeDB.Performance.OutgoingScheduler",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+	bool FSpacetimeDBOutgoingSchedulerTest::RunTest(const FString& /*Parameters*/)
+{
+	using namespace SpacetimeDBPerf;
+	using namespace UE::SpacetimeDB;
+
+	constexpr float SendRate = 30.0f;
+	constexpr int32 InputRate = 500;
+	constexpr int32 Targets = 2;
+	constexpr float Threshold = 1.0f;
+
+	LOG_Category("Player input coalesced per reducer and target, flushed at a fixed rate");
+
+	const FString InputReducer(TEXT("update_player_input"));
+	const FString OtherReducer(TEXT("respawn"));
+	const auto MovedEnough = [Threshold](const FTransformArgs& LastSent, const FTransformArgs& Next)
+	{
+		return FMath::Abs(Next.X - LastSent.X) >= Threshold;
+	};
+
+	// Values carry their target in Y, so the last value sent and the number of calls are kept per reducer and target
+	TMap<TPair<FString, uint64>, FTransformArgs> LastSent;
+	TMap<TPair<FString, uint64>, int32> SentCalls;
+	FOutgoingReducerScheduler Scheduler;
+	Scheduler.SetSendRate(SendRate);
+	const auto TickAll = [&](double Now)
+	{
+		Scheduler.Tick(Now, [&](const FString& Reducer, FReducerArgsWriter WriteArgs, USetReducerFlagsBase* /*Flags*/)
+		{
+			UEWriter Writer;
+			WriteArgs(Writer);
+			const FTransformArgs Args = Deserialize<FTransformArgs>(Writer.take_buffer());
+			const TPair<FString, uint64> Key(Reducer, uint64(Args.Y));
+			LastSent.Add(Key, Args);
+			++SentCalls.FindOrAdd(Key);
+		});
+	};
+
+	bool bOk = true;
+
+	// One second of input on two targets, each input event moves its target by 0.1 X and every event may flush
+	TArray<float> Queued;
+	Queued.SetNumZeroed(Targets);
+	for (int32 Event = 1; Event <= InputRate; ++Event)
+	{
+		for (int32 Target = 0; Target < Targets; ++Target)
+		{
+			Queued[Target] += 0.1f;
+			Scheduler.Queue(InputReducer, Target, FTransformArgs{ Queued[Target], float(Target), 0.0f, 0.0f, 0.0f, 0.0f }, nullptr, MovedEnough);
+		}
+		TickAll(double(Event) / InputRate);
+	}
+
+	const FSpacetimeDBOutgoingCallStats Stats = Scheduler.GetStats();
+	LOG_INFO(TEXT("%lld calls requested over 1 s, %lld sent, %lld skipped below the threshold"), Stats.Requested, Stats.Sent, Stats.SkippedBelowThreshold);
+	if (Stats.Requested != InputRate * Targets)
+	{
+		LOG_FAIL(TEXT("Counted %lld requested calls, expected %d"), Stats.Requested, InputRate * Targets);
+		bOk = false;
+	}
+	for (int32 Target = 0; Target < Targets; ++Target)
+	{
+		const int32 Calls = SentCalls.FindRef(TPair<FString, uint64>(InputReducer, Target));
+		if (FMath::Abs(Calls - int32(SendRate)) > 1)
+		{
+			LOG_FAIL(TEXT("Target %d sent %d calls in a second at %.0f Hz"), Target, Calls, SendRate);
+			bOk = false;
+		}
+	}
+
+	// The last flush sends the latest value of each target, never an older one
+	Scheduler.Queue(InputReducer, 0, FTransformArgs{ Queued[0] + 5.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f }, nullptr, MovedEnough);
+	Scheduler.Queue(InputReducer, 0, FTransformArgs{ Queued[0] + 10.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f }, nullptr, MovedEnough);
+	TickAll(2.0);
+	const FTransformArgs* Latest = LastSent.Find(TPair<FString, uint64>(InputReducer, 0));
+	if (!Latest || Latest->X != Queued[0] + 10.0f)
+	{
+		LOG_FAIL(TEXT("Flush sent X = %.2f instead of the latest value %.2f"), Latest ? Latest->X : -1.0f, Queued[0] + 10.0f);
+		bOk = false;
+	}
+
+	// Moves below the threshold are dropped, another reducer on the same target keeps its own slot
+	const int64 SkippedBefore = Scheduler.GetStats().SkippedBelowThreshold;
+	const int64 SentBefore = Scheduler.GetStats().Sent;
+	Scheduler.Queue(InputReducer, 0, FTransformArgs{ Queued[0] + 10.5f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f }, nullptr, MovedEnough);
+	Scheduler.Queue(OtherReducer, 0, FTransformArgs{ 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f }, nullptr);
+	TickAll(3.0);
+	if (Scheduler.GetStats().SkippedBelowThreshold != SkippedBefore + 1 || Scheduler.GetStats().Sent != SentBefore + 1
+		|| SentCalls.FindRef(TPair<FString, uint64>(OtherReducer, 0)) != 1)
+	{
+		LOG_FAIL(TEXT("Below threshold move was sent or the other reducer's call was lost"));
+		bOk = false;
+	}
+
+	// Nothing pending, nothing sent
+	TickAll(4.0);
+	if (Scheduler.GetStats().Sent != SentBefore + 1)
+	{
+		LOG_FAIL(TEXT("A flush without pending calls sent %lld calls"), Scheduler.GetStats().Sent - SentBefore - 1);
+		bOk = false;
+	}
+	return bOk;
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
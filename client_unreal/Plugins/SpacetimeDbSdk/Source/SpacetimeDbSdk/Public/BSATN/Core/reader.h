@@ -114,6 +114,13 @@ namespace SpacetimeDb::bsatn {
             advance(len);
             return result;
         }
+        // Borrow the next count bytes without copying, valid as long as the input buffer
+        inline std::span<const uint8_t> read_span(size_t count) {
+            check_available(count);
+            std::span<const uint8_t> result(current_ptr, count);
+            advance(count);
+            return result;
+        }
         inline std::vector<uint8_t> read_fixed_bytes(size_t count) {
             check_available(count);
             std::vector<uint8_t> result(current_ptr, current_ptr + count);
@@ -137,9 +144,17 @@ namespace SpacetimeDb::bsatn {
         std::vector<T> read_vector() {
             uint32_t size = read_u32_le();
             std::vector<T> result;
-            result.reserve(size);
-            for (uint32_t i = 0; i < size; ++i) {
-                result.push_back(SpacetimeDb::bsatn::deserialize<T>(*this));
+            if constexpr (is_bulk_copyable_v<T>) {
+                const std::span<const uint8_t> bytes = read_span(static_cast<size_t>(size) * sizeof(T));
+                result.resize(size);
+                if (size > 0) {
+                    std::memcpy(result.data(), bytes.data(), bytes.size());
+                }
+            } else {
+                result.reserve(size);
+                for (uint32_t i = 0; i < size; ++i) {
+                    result.push_back(SpacetimeDb::bsatn::deserialize<T>(*this));
+                }
             }
             return result;
         }
@@ -23,6 +23,7 @@
 #include <string>
 #include <cstring>
 #include <type_traits>
+#include <bit>        // For std::endian
 #include <stdexcept>  // For std::runtime_error
 #include <algorithm>  // For std::copy
 #include <sstream>    // For std::ostringstream
@@ -33,6 +34,13 @@ namespace SpacetimeDb {
 namespace bsatn {
     class Writer;
     class Reader;
+
+    // Element types whose BSATN encoding is their in-memory representation, so arrays of them
+    // are read and written with one bounds check and one memcpy. bool is excluded because
+    // reading it must reject bytes other than 0 and 1.
+    template<typename T>
+    inline constexpr bool is_bulk_copyable_v =
+        std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && std::endian::native == std::endian::little;
 }
 
 // Forward declarations
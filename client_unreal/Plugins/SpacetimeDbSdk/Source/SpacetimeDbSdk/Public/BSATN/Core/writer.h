@@ -96,8 +96,12 @@ namespace SpacetimeDb::bsatn {
         template<typename T>
         void write_vector(const std::vector<T>& vec) {
             write_u32_le(static_cast<uint32_t>(vec.size()));
-            for (const auto& item : vec) {
-                serialize(*this, item);
+            if constexpr (is_bulk_copyable_v<T>) {
+                write_bytes_raw(vec.data(), vec.size() * sizeof(T));
+            } else {
+                for (const auto& item : vec) {
+                    serialize(*this, item);
+                }
             }
         }
 
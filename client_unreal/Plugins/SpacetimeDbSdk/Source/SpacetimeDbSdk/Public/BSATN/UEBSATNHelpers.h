@@ -5,15 +5,80 @@
 #include "ModuleBindings/Types/QueryUpdateType.g.h"
 #include "ModuleBindings/Types/CompressableQueryUpdateType.g.h"
 #include "DBCache/WithBsatn.h"
+#include <type_traits>
 
 /** Helper utilities for working with BSATN encoded row data in Unreal. */
 
 namespace UE::SpacetimeDB
 {
 
-	/** Parse a single row list based on its size hint and retain BSATN bytes */
+	/** Writes the primary key of a row, the cache keys rows on these bytes. Left unset for tables without a primary key. */
 	template<typename RowType>
-	static void ParseRowListWithBsatn(
+	using TRowKeyWriter = TFunction<void(UEWriter& Writer, const RowType& Row)>;
+
+	/** True when a generated table class declares FPrimaryKey and a static GetPrimaryKey(const RowType&). */
+	template<typename TableClass, typename = void>
+	struct THasPrimaryKey : std::false_type {};
+
+	template<typename TableClass>
+	struct THasPrimaryKey<TableClass, std::void_t<typename TableClass::FPrimaryKey>> : std::true_type {};
+
+	/** Key writer for the primary key TableClass declares, unset if it declares none. */
+	template<typename RowType, typename TableClass>
+	TRowKeyWriter<RowType> MakeRowKeyWriter()
+	{
+		if constexpr (THasPrimaryKey<TableClass>::value)
+		{
+			return [](UEWriter& Writer, const RowType& Row)
+			{
+				serialize(Writer, static_cast<const typename TableClass::FPrimaryKey&>(TableClass::GetPrimaryKey(Row)));
+			};
+		}
+		else
+		{
+			return TRowKeyWriter<RowType>();
+		}
+	}
+
+	/**
+	 * Key the rows from First on. With a key writer the primary keys of the whole list are serialized into one shared arena,
+	 * otherwise each row is keyed on its own row bytes.
+	 */
+	template<typename RowType>
+	static void AssignRowKeys(TArray<FWithBsatn<RowType>>& Rows, int32 First, const TRowKeyWriter<RowType>& WriteKey)
+	{
+		if (!WriteKey)
+		{
+			for (int32 i = First; i < Rows.Num(); ++i)
+			{
+				Rows[i].SetKey(Rows[i].Arena, Rows[i].Offset, Rows[i].Length);
+			}
+			return;
+		}
+
+		// Record each key's position first, the arena buffer may still move while it grows
+		TSharedRef<TArray<uint8>> Keys = MakeShared<TArray<uint8>>();
+		UEWriter Writer(*Keys);
+		for (int32 i = First; i < Rows.Num(); ++i)
+		{
+			Rows[i].KeyOffset = Writer.size();
+			WriteKey(Writer, Rows[i].Row);
+			Rows[i].KeyLength = Writer.size() - Rows[i].KeyOffset;
+		}
+
+		const FRowBytesArena KeyArena = Keys;
+		for (int32 i = First; i < Rows.Num(); ++i)
+		{
+			Rows[i].SetKey(KeyArena, Rows[i].KeyOffset, Rows[i].KeyLength);
+		}
+	}
+
+	/**
+	 * Parse a single row list based on its size hint and retain BSATN bytes.
+	 * The row bytes are copied once into an arena shared by all rows of the list, each row keeps an offset and length into it.
+	 */
+	template<typename RowType>
+	static void ParseRowList(
 		const FBsatnRowListType& List,
 		TArray<FWithBsatn<RowType>>& OutRows
 	)
@@ -27,15 +92,18 @@ namespace UE::SpacetimeDB
 			{
 				// If the size is valid, parse the rows based on the fixed size
 				int32 Count = List.RowsData.Num() / Size;
+				if (Count == 0)
+				{
+					return;
+				}
+				const FRowBytesArena Arena = MakeShared<TArray<uint8>>(List.RowsData);
+				OutRows.Reserve(OutRows.Num() + Count);
 				for (int32 i = 0; i < Count; ++i)
 				{
-					// Create a slice of the row data based on the fixed size
-					TArray<uint8> Slice;
-					Slice.Append(List.RowsData.GetData() + i * Size, Size);
-					// Deserialize the row from the slice
-					RowType Row = UE::SpacetimeDB::Deserialize<RowType>(Slice);
-					// Add the row with its BSATN bytes to the output array
-					OutRows.Add(FWithBsatn<RowType>(Slice, Row));
+					// Deserialize the row straight from its slice of the arena
+					const int32 Offset = i * Size;
+					RowType Row = UE::SpacetimeDB::Deserialize<RowType>(TArrayView<const uint8>(Arena->GetData() + Offset, Size));
+					OutRows.Emplace(Arena, Offset, static_cast<int32>(Size), MoveTemp(Row));
 				}
 				return;
 			}
@@ -44,41 +112,58 @@ namespace UE::SpacetimeDB
 		else if (List.SizeHint.IsRowOffsets())
 		{
 			// Get the offsets from the size hint
-			TArray<uint64> Offsets = List.SizeHint.GetAsRowOffsets();
+			const TArray<uint64>& Offsets = List.SizeHint.GetAsRowOffsets();
 			if (Offsets.Num() > 0)
 			{
-				// If the offsets are valid, parse the rows based on the offsets
-				UEReader Reader(List.RowsData);
+				const FRowBytesArena Arena = MakeShared<TArray<uint8>>(List.RowsData);
+				const int64 DataNum = Arena->Num();
+				OutRows.Reserve(OutRows.Num() + Offsets.Num());
 				for (int32 i = 0; i < Offsets.Num(); ++i)
 				{
 					// If this is the last offset, read until the end of the data
-					int64 Start = Offsets[i];
-					int64 End = (i + 1 < Offsets.Num()) ? Offsets[i + 1] : List.RowsData.Num();
-					int64 Length = End - Start;
-					TArray<uint8> Slice;
-					Slice.Append(List.RowsData.GetData() + Start, Length);
-
-					// Deserialize the row from the slice
-					UEReader SliceReader(Slice);
-					RowType Row = deserialize<RowType>(SliceReader);
-
-					// Add the row with its BSATN bytes to the output array
-					OutRows.Add(FWithBsatn<RowType>(Slice, Row));
+					// Checked as sent, before narrowing, so offsets past INT64_MAX cannot wrap to a negative start
+					const uint64 RawStart = Offsets[i];
+					const uint64 RawEnd = (i + 1 < Offsets.Num()) ? Offsets[i + 1] : static_cast<uint64>(DataNum);
+					if (RawStart > RawEnd || RawEnd > static_cast<uint64>(DataNum))
+					{
+						UE_LOG(LogTemp, Error, TEXT("Row offset %llu..%llu out of range for %lld bytes of row data"), RawStart, RawEnd, DataNum);
+						return;
+					}
+					const int64 Start = static_cast<int64>(RawStart);
+					int32 Length = static_cast<int32>(RawEnd - RawStart);
+
+					// Deserialize the row straight from its slice of the arena
+					RowType Row = UE::SpacetimeDB::Deserialize<RowType>(TArrayView<const uint8>(Arena->GetData() + Start, Length));
+					OutRows.Emplace(Arena, static_cast<int32>(Start), Length, MoveTemp(Row));
 				}
 			}
 		}
 	}
 
+	/** Parse a single row list and key its rows, on their primary key when WriteKey is set */
+	template<typename RowType>
+	static void ParseRowListWithBsatn(
+		const FBsatnRowListType& List,
+		TArray<FWithBsatn<RowType>>& OutRows,
+		const TRowKeyWriter<RowType>& WriteKey = TRowKeyWriter<RowType>()
+	)
+	{
+		const int32 First = OutRows.Num();
+		ParseRowList(List, OutRows);
+		AssignRowKeys(OutRows, First, WriteKey);
+	}
+
 	/** Parse a query update into row arrays */
 	template<typename RowType>
 	static void ParseQueryUpdateWithBsatn(
 		const FQueryUpdateType& Query,
 		TArray<FWithBsatn<RowType>>& OutInserts,
-		TArray<FWithBsatn<RowType>>& OutDeletes)
+		TArray<FWithBsatn<RowType>>& OutDeletes,
+		const TRowKeyWriter<RowType>& WriteKey = TRowKeyWriter<RowType>())
 	{
 		// Parse inserts and deletes from the query update, retaining BSATN bytes
-		ParseRowListWithBsatn(Query.Inserts, OutInserts);
-		ParseRowListWithBsatn(Query.Deletes, OutDeletes);
+		ParseRowListWithBsatn(Query.Inserts, OutInserts, WriteKey);
+		ParseRowListWithBsatn(Query.Deletes, OutDeletes, WriteKey);
 	}
 
 	/** Apply a table update keeping BSATN bytes */
@@ -86,22 +171,18 @@ namespace UE::SpacetimeDB
 	void ProcessTableUpdateWithBsatn(
 		const FTableUpdateType& TableUpdate,
 		TArray<FWithBsatn<RowType>>& Inserts,
-		TArray<FWithBsatn<RowType>>& Deletes)
+		TArray<FWithBsatn<RowType>>& Deletes,
+		const TRowKeyWriter<RowType>& WriteKey = TRowKeyWriter<RowType>())
 	{
-		for (FCompressableQueryUpdateType CQU : TableUpdate.Updates)
+		for (const FCompressableQueryUpdateType& CQU : TableUpdate.Updates)
 		{
-			FQueryUpdateType QueryUpdate;
 			//Should be uncompressed at this point
-			if (CQU.IsUncompressed())
-			{
-				QueryUpdate = CQU.GetAsUncompressed();
-			}
-			else
+			if (!CQU.IsUncompressed())
 			{
 				UE_LOG(LogTemp, Error, TEXT("Compresstion state for row in table %s not uncompressed at parsing step"), *TableUpdate.TableName);
 				continue;
 			}
-			ParseQueryUpdateWithBsatn(QueryUpdate, Inserts, Deletes);
+			ParseQueryUpdateWithBsatn(CQU.GetAsUncompressed(), Inserts, Deletes, WriteKey);
 		}
 	}
 
@@ -109,6 +190,9 @@ namespace UE::SpacetimeDB
 	struct FPreprocessedTableDataBase
 	{
 		virtual ~FPreprocessedTableDataBase() {}
+
+		/** Number of deserialized inserts and deletes. */
+		virtual int32 NumRows() const = 0;
 	};
 
 	/** A wrapper for a row type that includes its bsatn value. Used to store rows with their bsatn values. */
@@ -118,6 +202,8 @@ namespace UE::SpacetimeDB
 		// The type of the row being processed
 		TArray<FWithBsatn<RowType>> Inserts;
 		TArray<FWithBsatn<RowType>> Deletes;
+
+		virtual int32 NumRows() const override { return Inserts.Num() + Deletes.Num(); }
 	};
 
 	/** Interface for deserializing table rows from a database update. Allows for different row types to be processed in SDK. */
@@ -125,8 +211,8 @@ namespace UE::SpacetimeDB
 	{
 	public:
 		virtual ~ITableRowDeserializer() {}
-		/** Preprocess the table update and return a shared pointer to preprocessed data. */
-		virtual TSharedPtr<FPreprocessedTableDataBase> PreProcess(const TArray<FCompressableQueryUpdateType>& Updates, const FString TableName) const = 0;
+		/** Preprocess the uncompressed query updates of a table and return a shared pointer to preprocessed data. The updates are only read during the call. */
+		virtual TSharedPtr<FPreprocessedTableDataBase> PreProcess(const TArray<const FQueryUpdateType*>& Updates, const FString TableName) const = 0;
 	};
 
 	/** Specialization of ITableRowDeserializer for a specific row type not defined in SDK. Used to deserialize rows of a specific type from a database update. */
@@ -134,24 +220,26 @@ namespace UE::SpacetimeDB
 	class TTableRowDeserializer : public ITableRowDeserializer
 	{
 	public:
-		virtual TSharedPtr<FPreprocessedTableDataBase> PreProcess(const TArray<FCompressableQueryUpdateType>& Updates, const FString TableName) const override
+		explicit TTableRowDeserializer(TRowKeyWriter<RowType> InWriteKey = TRowKeyWriter<RowType>())
+			: WriteKey(MoveTemp(InWriteKey))
+		{
+		}
+
+		virtual TSharedPtr<FPreprocessedTableDataBase> PreProcess(const TArray<const FQueryUpdateType*>& Updates, const FString TableName) const override
 		{
 			// Create a new preprocessed table data object for the specific row type
 			TSharedPtr<TPreprocessedTableData<RowType>> Result = MakeShared<TPreprocessedTableData<RowType>>();
-			// Process each compressable query update in the table update
-			for (const FCompressableQueryUpdateType& CQU : Updates)
+			// Process each uncompressed query update in the table update
+			for (const FQueryUpdateType* Query : Updates)
 			{
-				if (!CQU.IsUncompressed()) 
-				{ 
-					UE_LOG(LogTemp, Error, TEXT("Compresstion state for row in table %s not uncompressed at parsing step"), *TableName);
-					continue; 
-				}
-				// Get the uncompressed query update from the compressable query update
-				FQueryUpdateType Query = CQU.GetAsUncompressed();
 				// Parse the query update into inserts and deletes, retaining BSATN bytes
-				ParseQueryUpdateWithBsatn<RowType>(Query, Result->Inserts, Result->Deletes);
+				ParseQueryUpdateWithBsatn<RowType>(*Query, Result->Inserts, Result->Deletes, WriteKey);
 			}
 			return Result;
 		}
+
+	private:
+		/** Primary key writer of the table, unset when rows are keyed on their bytes */
+		TRowKeyWriter<RowType> WriteKey;
 	};
 }
\ No newline at end of file
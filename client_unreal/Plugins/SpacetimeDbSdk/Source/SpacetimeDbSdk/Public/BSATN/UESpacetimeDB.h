@@ -35,6 +35,7 @@
 #include <chrono>
 #include <array>
 #include <typeinfo>
+#include <bit>
 
 namespace UE::SpacetimeDB {
 
@@ -53,20 +54,50 @@ namespace UE::SpacetimeDB {
 
 	/**
 	 * @class UEWriter
-	 * @brief Wrapper around SpacetimeDB's BSATN Writer for Unreal Engine types
+	 * @brief BSATN writer for Unreal Engine types
 	 *
 	 * This class provides a UE-friendly interface to the BSATN serialization system,
-	 * handling conversions between UE types (FString, TArray) and standard C++ types.
+	 * handling conversions between UE types (FString, TArray) and the wire format.
 	 *
-	 * The writer maintains an internal buffer that accumulates serialized data.
-	 * Use take_buffer() to extract the final result.
+	 * The writer appends to a TArray<uint8>, either its own or one provided by the caller,
+	 * growing it with TArray's amortized slack policy. Use take_buffer() to extract the final result.
 	 */
 	class UEWriter {
 	private:
-		::SpacetimeDb::bsatn::Writer core_writer;  ///< Underlying BSATN writer
+		TArray<uint8> owned_buffer;  ///< Used when no external buffer is given
+		TArray<uint8>* buffer;       ///< Buffer being appended to
+
+		/** Store the little-endian bytes of an arithmetic value at dest. */
+		template<typename T>
+		static void store_le(uint8* dest, T value) {
+			static_assert(std::is_arithmetic_v<T>, "store_le only works with arithmetic types");
+			FMemory::Memcpy(dest, &value, sizeof(T));
+			if constexpr (std::endian::native != std::endian::little) {
+				// The wire format is little-endian, reverse the bytes on big-endian hosts
+				for (size_t i = 0; i < sizeof(T) / 2; ++i) {
+					Swap(dest[i], dest[sizeof(T) - 1 - i]);
+				}
+			}
+		}
+
+		/** Append the little-endian bytes of an arithmetic value. */
+		template<typename T>
+		void write_le(T value) {
+			const int32 offset = buffer->AddUninitialized(sizeof(T));
+			store_le(buffer->GetData() + offset, value);
+		}
 
 	public:
-		UEWriter() = default;
+		UEWriter() : buffer(&owned_buffer) {}
+
+		/**
+		 * Append to a caller-owned buffer instead of the internal one
+		 * @param external_buffer Buffer to append to, must outlive the writer. Existing contents are kept.
+		 */
+		explicit UEWriter(TArray<uint8>& external_buffer) : buffer(&external_buffer) {}
+
+		UEWriter(const UEWriter&) = delete;
+		UEWriter& operator=(const UEWriter&) = delete;
 
 		// -------------------------------------------------------------------------
 		// Primitive Type Writers
@@ -76,23 +107,23 @@ namespace UE::SpacetimeDB {
 		 *  Write primitive integer types to the buffer
 		 */
 		 ///@{
-		void write_bool(bool value) { core_writer.write_bool(value); }
-		void write_u8(uint8_t value) { core_writer.write_u8(value); }
-		void write_u16(uint16_t value) { core_writer.write_u16_le(value); }
-		void write_u32(uint32_t value) { core_writer.write_u32_le(value); }
-		void write_u64(uint64_t value) { core_writer.write_u64_le(value); }
-		void write_i8(int8_t value) { core_writer.write_i8(value); }
-		void write_i16(int16_t value) { core_writer.write_i16_le(value); }
-		void write_i32(int32_t value) { core_writer.write_i32_le(value); }
-		void write_i64(int64_t value) { core_writer.write_i64_le(value); }
+		void write_bool(bool value) { buffer->Add(static_cast<uint8>(value ? 1 : 0)); }
+		void write_u8(uint8_t value) { buffer->Add(value); }
+		void write_u16(uint16_t value) { write_le(value); }
+		void write_u32(uint32_t value) { write_le(value); }
+		void write_u64(uint64_t value) { write_le(value); }
+		void write_i8(int8_t value) { buffer->Add(static_cast<uint8>(value)); }
+		void write_i16(int16_t value) { write_le(value); }
+		void write_i32(int32_t value) { write_le(value); }
+		void write_i64(int64_t value) { write_le(value); }
 		///@}
 
 		/** @name Floating Point Writers
 		 *  Write floating point values to the buffer
 		 */
 		 ///@{
-		void write_f32(float value) { core_writer.write_f32_le(value); }
-		void write_f64(double value) { core_writer.write_f64_le(value); }
+		void write_f32(float value) { write_le(value); }
+		void write_f64(double value) { write_le(value); }
 		///@}
 
 		// -------------------------------------------------------------------------
@@ -104,8 +135,18 @@ namespace UE::SpacetimeDB {
 		 * @param str The FString to serialize
 		 */
 		void write_string(const FString& str) {
-			FTCHARToUTF8 converter(*str);
-			core_writer.write_string(std::string(converter.Get(), converter.Length()));
+			// The converter keeps short strings in an inline buffer, append straight from it
+			FTCHARToUTF8 converter(*str, str.Len());
+			write_u32(static_cast<uint32_t>(converter.Length()));
+			buffer->Append(reinterpret_cast<const uint8*>(converter.Get()), converter.Length());
+		}
+
+		/**
+		 * Append already serialized bytes without a length prefix
+		 * @param data The bytes to append
+		 */
+		void write_raw_bytes(TArrayView<const uint8> data) {
+			buffer->Append(data.GetData(), data.Num());
 		}
 
 		/**
@@ -113,10 +154,8 @@ namespace UE::SpacetimeDB {
 		 * @param arr The byte array to serialize
 		 */
 		void write_array_u8(const TArray<uint8>& arr) {
-			core_writer.write_u32_le(static_cast<uint32_t>(arr.Num()));
-			if (arr.Num() > 0) {
-				core_writer.write_bytes(std::vector<uint8_t>(arr.GetData(), arr.GetData() + arr.Num()));
-			}
+			write_u32(static_cast<uint32_t>(arr.Num()));
+			buffer->Append(arr);
 		}
 
 		/**
@@ -135,24 +174,32 @@ namespace UE::SpacetimeDB {
 		/**
 		 * Extract the serialized buffer as a UE TArray
 		 * @return TArray<uint8> containing the serialized data
-		 * @note This consumes the writer (move semantics)
+		 * @note This consumes the writer (move semantics), an external buffer is moved out as well
 		 */
 		TArray<uint8> take_buffer()&& {
-			auto std_buffer = std::move(core_writer).take_buffer();
-			TArray<uint8> ue_buffer;
-			ue_buffer.Reserve(static_cast<int32_t>(std_buffer.size()));
-			for (auto byte : std_buffer) {
-				ue_buffer.Add(byte);
-			}
-			return ue_buffer;
+			return MoveTemp(*buffer);
+		}
+
+		/**
+		 * Get a reference to the buffer being written
+		 * @return The serialized bytes so far
+		 */
+		const TArray<uint8>& get_buffer() const {
+			return *buffer;
+		}
+
+		/** Number of bytes in the buffer, including any an external buffer held before writing started. */
+		int32 size() const {
+			return buffer->Num();
 		}
 
 		/**
-		 * Get a reference to the internal buffer (for compatibility)
-		 * @return Reference to the internal std::vector buffer
+		 * Overwrite 4 already written bytes with a little-endian u32, used to back-patch length prefixes.
+		 * @param offset Position of the bytes in the buffer, as returned by size() before they were written.
 		 */
-		const std::vector<uint8_t>& get_std_buffer() const {
-			return core_writer.get_buffer();
+		void patch_u32_le(int32 offset, uint32_t value) {
+			check(offset >= 0 && offset + static_cast<int32>(sizeof(uint32_t)) <= buffer->Num());
+			store_le(buffer->GetData() + offset, value);
 		}
 	};
 
@@ -167,36 +214,45 @@ namespace UE::SpacetimeDB {
 	 * This class provides a UE-friendly interface for deserializing BSATN data,
 	 * handling conversions between standard C++ types and UE types.
 	 *
-	 * The reader stores a copy of the input data to prevent lifetime issues
-	 * that could occur if the original TArray is destroyed.
+	 * The reader borrows its input without copying it, the bytes must stay alive
+	 * and unmodified for as long as the reader is used.
 	 */
 	class UEReader {
 	private:
-		std::vector<uint8_t> stored_data;           ///< Local copy of data to ensure lifetime
-		::SpacetimeDb::bsatn::Reader core_reader;   ///< Underlying BSATN reader
+		::SpacetimeDb::bsatn::Reader core_reader;   ///< Underlying BSATN reader, points into the borrowed bytes
 
 	public:
 		/**
-		 * Construct a reader from a UE byte array
-		 * @param data The TArray<uint8> containing serialized BSATN data
-		 * @note Makes a copy of the data to prevent lifetime issues
+		 * Construct a reader over a UE byte array
+		 * @param data The TArray<uint8> containing serialized BSATN data, must outlive the reader
 		 */
 		explicit UEReader(const TArray<uint8>& data)
-			: stored_data(data.GetData(), data.GetData() + data.Num()),
-			core_reader(stored_data) {
-			// Debug output (can be removed in production)
-			if (data.Num() > 0) {
-				//std::cout << "  UEReader initialized with data[0] = " << std::hex << (int)data[0] << std::dec << std::endl;
-			}
-		}
+			: core_reader(data.GetData(), static_cast<size_t>(data.Num())) {}
+
+		/**
+		 * Construct a reader from a view into a larger buffer, e.g. a frame past its header byte
+		 * @param data View over the serialized BSATN data, must outlive the reader
+		 */
+		explicit UEReader(TArrayView<const uint8> data)
+			: core_reader(data.GetData(), static_cast<size_t>(data.Num())) {}
+
+		/**
+		 * Construct a reader over a span of bytes
+		 * @param data The serialized BSATN data, must outlive the reader
+		 */
+		explicit UEReader(std::span<const uint8_t> data)
+			: core_reader(data) {}
 
 		/**
-		 * Construct a reader from a standard vector
-		 * @param data The vector containing serialized BSATN data
+		 * Construct a reader over a standard vector
+		 * @param data The vector containing serialized BSATN data, must outlive the reader
 		 */
 		explicit UEReader(const std::vector<uint8_t>& data)
-			: stored_data(data),
-			core_reader(stored_data) {}
+			: core_reader(data) {}
+
+		/** Temporaries would be destroyed before the reader is used. */
+		explicit UEReader(TArray<uint8>&&) = delete;
+		explicit UEReader(std::vector<uint8_t>&&) = delete;
 
 		// -------------------------------------------------------------------------
 		// Primitive Type Readers
@@ -237,8 +293,16 @@ namespace UE::SpacetimeDB {
 		 * @return FString containing the deserialized string
 		 */
 		FString read_string() {
-			auto std_str = core_reader.read_string();
-			return FString(UTF8_TO_TCHAR(std_str.c_str()));
+			// Convert straight from the borrowed bytes, no intermediate std::string
+			const uint32_t len = core_reader.read_u32_le();
+			const std::span<const uint8_t> bytes = core_reader.read_span(len);
+			const FUTF8ToTCHAR converter(reinterpret_cast<const ANSICHAR*>(bytes.data()), static_cast<int32>(bytes.size()));
+			return FString::ConstructFromPtrSize(converter.Get(), converter.Length());
+		}
+
+		/** Bytes left to read. */
+		int32 remaining_bytes() const {
+			return static_cast<int32>(core_reader.remaining_bytes());
 		}
 
 		/**
@@ -246,13 +310,9 @@ namespace UE::SpacetimeDB {
 		 * @return TArray<uint8> containing the deserialized bytes
 		 */
 		TArray<uint8> read_array_u8() {
-			uint32_t count = core_reader.read_u32_le();
-			TArray<uint8> result;
-			result.Reserve(count);
-			for (uint32_t i = 0; i < count; ++i) {
-				result.Add(core_reader.read_u8());
-			}
-			return result;
+			const uint32_t count = core_reader.read_u32_le();
+			const std::span<const uint8_t> bytes = core_reader.read_span(count);
+			return TArray<uint8>(bytes.data(), static_cast<int32>(bytes.size()));
 		}
 
 		/**
@@ -721,11 +781,17 @@ namespace UE::SpacetimeDB {
 	template<typename T>
 	void UEWriter::write_array(const TArray<T>& arr) {
 		// Write count as 32-bit length prefix
-		core_writer.write_u32_le(static_cast<uint32_t>(arr.Num()));
+		write_u32(static_cast<uint32_t>(arr.Num()));
 
-		// Serialize each element
-		for (const auto& item : arr) {
-			serialize(*this, item);
+		if constexpr (::SpacetimeDb::bsatn::is_bulk_copyable_v<T>) {
+			// Wire format matches memory, append the elements in one copy
+			buffer->Append(reinterpret_cast<const uint8*>(arr.GetData()), arr.Num() * static_cast<int32>(sizeof(T)));
+		}
+		else {
+			// Serialize each element
+			for (const auto& item : arr) {
+				serialize(*this, item);
+			}
 		}
 	}
 
@@ -740,21 +806,30 @@ namespace UE::SpacetimeDB {
 		// Read count from 32-bit length prefix
 		uint32_t count = core_reader.read_u32_le();
 
-		// Pre-allocate array
 		TArray<T> result;
-		result.Reserve(count);
+		if constexpr (::SpacetimeDb::bsatn::is_bulk_copyable_v<T>) {
+			// One bounds check for the whole payload, then a single copy
+			const std::span<const uint8_t> bytes = core_reader.read_span(static_cast<size_t>(count) * sizeof(T));
+			result.SetNumUninitialized(static_cast<int32>(count));
+			FMemory::Memcpy(result.GetData(), bytes.data(), bytes.size());
+			return result;
+		}
+		else {
+			// Pre-allocate array
+			result.Reserve(count);
 
-		// Deserialize each element
-		for (uint32_t i = 0; i < count; ++i) {
-			// Use DeserializeHelper for nested containers, direct deserialize for primitives
-			if constexpr (is_tarray_check<T>::value) {
-				result.Add(DeserializeHelper<T>::deserialize(*this));
-			}
-			else {
-				result.Add(deserialize<T>(*this));
+			// Deserialize each element
+			for (uint32_t i = 0; i < count; ++i) {
+				// Use DeserializeHelper for nested containers, direct deserialize for primitives
+				if constexpr (is_tarray_check<T>::value) {
+					result.Add(DeserializeHelper<T>::deserialize(*this));
+				}
+				else {
+					result.Add(deserialize<T>(*this));
+				}
 			}
+			return result;
 		}
-		return result;
 	}
 
 	// =============================================================================
@@ -838,6 +913,24 @@ namespace UE::SpacetimeDB {
 		}
 	}
 
+	/**
+	 * Deserialize a view over BSATN bytes to a UE type
+	 * @tparam T Type to deserialize to (must be explicitly specified)
+	 * @param data View over the BSATN data, only read during the call
+	 */
+	template<typename T>
+	T Deserialize(TArrayView<const uint8> data) {
+
+		UEReader reader(data);
+
+		if constexpr (is_tarray_v<T> || is_toptional_v<T>) {
+			return DeserializeHelper<T>::deserialize(reader);
+		}
+		else {
+			return deserialize<T>(reader);
+		}
+	}
+
 	/** @} */ // end of HighLevelAPI group
 
 	// =============================================================================
@@ -916,7 +1009,7 @@ namespace UE::SpacetimeDB {
 #define UE_READ_CASE_TVARIANT(EnumTok, FieldTok, TagTok, TypeTok)                      \
 	case EnumTok::TagTok: {                                                            \
 		auto _tmp = deserialize<TypeTok>(r);                                           \
-		out.FieldTok.Set<TypeTok>(_tmp);                                               \
+		out.FieldTok.Set<TypeTok>(MoveTemp(_tmp));                                     \
 		break;                                                                         \
 	}
 
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace UE::SpacetimeDB::Compression
+{
+	/**
+	 * Decode a complete Brotli stream (RFC 7932) held in memory. Stateless and thread-safe.
+	 * The whole output is kept, so backward references read it directly instead of a sliding window.
+	 * @param InData Compressed stream, bytes after its last meta-block are ignored.
+	 * @param OutData Receives the decoded bytes, its allocation is reused.
+	 * @param OutError Set to a static description of the problem when decoding fails.
+	 * @return False if the stream is malformed, truncated or decodes to more than MAX_int32 bytes.
+	 */
+	SPACETIMEDBSDK_API bool DecodeBrotli(TArrayView<const uint8> InData, TArray<uint8>& OutData, const TCHAR*& OutError);
+}
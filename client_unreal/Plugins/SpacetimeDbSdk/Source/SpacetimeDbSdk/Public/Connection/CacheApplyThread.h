@@ -0,0 +1,147 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Containers/Queue.h"
+#include "Connection/SequencedMessageRing.h"
+#include <atomic>
+
+/**
+ * Single thread that applies decoded messages to the client cache ahead of the game thread.
+ *
+ * It is the only consumer of the sequenced ring the decode workers publish into, so messages are
+ * applied strictly in arrival order. Applied messages are handed to the game thread through a
+ * queue, which then only has to broadcast what changed. At most MaxAhead messages are applied
+ * but not yet taken by the game thread, beyond that the thread waits so the cache never runs
+ * far ahead of the events the game has seen.
+ */
+template<typename T>
+class TCacheApplyThread final : public FRunnable
+{
+public:
+	/**
+	 * Start the thread.
+	 * @param InSource Ring to consume, the caller stops dequeuing from it.
+	 * @param InApply Applies one message to the cache, runs on this thread only.
+	 * @param InMaxAhead Maximum number of applied messages waiting for the game thread.
+	 */
+	TCacheApplyThread(TSequencedMessageRing<T>& InSource, TFunction<void(T&)> InApply, int32 InMaxAhead)
+		: Source(InSource)
+		, Apply(MoveTemp(InApply))
+		, MaxAhead(FMath::Max(1, InMaxAhead))
+	{
+		WorkAvailable = FPlatformProcess::GetSynchEventFromPool(false);
+		SpaceAvailable = FPlatformProcess::GetSynchEventFromPool(false);
+		Thread = FRunnableThread::Create(this, TEXT("SpacetimeDBApply"), 0, TPri_Normal);
+		if (!Thread)
+		{
+			UE_LOG(LogTemp, Error, TEXT("TCacheApplyThread: Failed to create the apply thread"));
+		}
+	}
+
+	virtual ~TCacheApplyThread() override
+	{
+		Shutdown();
+		FPlatformProcess::ReturnSynchEventToPool(WorkAvailable);
+		FPlatformProcess::ReturnSynchEventToPool(SpaceAvailable);
+	}
+
+	TCacheApplyThread(const TCacheApplyThread&) = delete;
+	TCacheApplyThread& operator=(const TCacheApplyThread&) = delete;
+
+	/** False if the thread could not be started, the caller should keep applying on the game thread. */
+	bool IsRunning() const { return Thread != nullptr; }
+
+	/** Wake the thread after publishing into the source ring. Safe from any thread. */
+	void Notify() { WorkAvailable->Trigger(); }
+
+	/** Game thread only. Take the next applied message, in arrival order. */
+	bool TryDequeue(T& OutItem)
+	{
+		if (!Applied.Dequeue(OutItem))
+		{
+			return false;
+		}
+		if (AppliedAhead.fetch_sub(1, std::memory_order_acq_rel) == MaxAhead)
+		{
+			SpaceAvailable->Trigger();
+		}
+		return true;
+	}
+
+	/** Number of applied messages waiting for the game thread. */
+	int32 GetNumAhead() const { return AppliedAhead.load(std::memory_order_relaxed); }
+
+	/** Number of messages applied so far. */
+	int64 GetNumApplied() const { return NumApplied.load(std::memory_order_relaxed); }
+
+	/** Seconds spent applying messages. */
+	double GetBusySeconds() const { return FPlatformTime::ToSeconds64(BusyCycles.load(std::memory_order_relaxed)); }
+
+	virtual uint32 Run() override
+	{
+		T Item;
+		while (!bStopping.load(std::memory_order_acquire))
+		{
+			if (AppliedAhead.load(std::memory_order_acquire) >= MaxAhead)
+			{
+				SpaceAvailable->Wait(WaitSliceMs);
+				continue;
+			}
+			if (!Source.TryDequeue(Item))
+			{
+				WorkAvailable->Wait(WaitSliceMs);
+				continue;
+			}
+
+			const uint64 WorkStart = FPlatformTime::Cycles64();
+			Apply(Item);
+			BusyCycles.fetch_add(FPlatformTime::Cycles64() - WorkStart, std::memory_order_relaxed);
+			NumApplied.fetch_add(1, std::memory_order_relaxed);
+
+			Applied.Enqueue(MoveTemp(Item));
+			AppliedAhead.fetch_add(1, std::memory_order_release);
+			Item = T();
+		}
+		return 0;
+	}
+
+	/** Stop and join the thread, messages not yet applied stay in the source ring. Safe to call more than once. */
+	void Shutdown()
+	{
+		if (bStopping.exchange(true) || !Thread)
+		{
+			return;
+		}
+		WorkAvailable->Trigger();
+		SpaceAvailable->Trigger();
+		Thread->WaitForCompletion();
+		delete Thread;
+		Thread = nullptr;
+	}
+
+private:
+	/** Upper bound on a single wait so a missed wake-up only costs a short delay. */
+	static constexpr uint32 WaitSliceMs = 50;
+
+	TSequencedMessageRing<T>& Source;
+	TFunction<void(T&)> Apply;
+	int32 MaxAhead;
+
+	/** Applied messages, produced by this thread and consumed by the game thread. */
+	TQueue<T, EQueueMode::Spsc> Applied;
+	std::atomic<int32> AppliedAhead{ 0 };
+
+	/** Signalled when a message is published into the source ring. */
+	FEvent* WorkAvailable = nullptr;
+	/** Signalled when the game thread takes a message while the thread waits for room. */
+	FEvent* SpaceAvailable = nullptr;
+
+	FRunnableThread* Thread = nullptr;
+	std::atomic<bool> bStopping{ false };
+	std::atomic<int64> NumApplied{ 0 };
+	std::atomic<uint64> BusyCycles{ 0 };
+};
@@ -80,24 +80,42 @@ public:
 	FORCEINLINE bool IsFailed() const { return Tag == ESpacetimeDBStatusTag::Failed; }
 	FORCEINLINE bool IsOutOfEnergy() const { return Tag == ESpacetimeDBStatusTag::OutOfEnergy; }
 
-	FORCEINLINE FSpacetimeDBUnit GetAsCommitted() const
+	FORCEINLINE const FSpacetimeDBUnit& GetAsCommitted() const&
 	{
 		ensureMsgf(IsCommitted(), TEXT("MessageData does not hold Committed!"));
 		return MessageData.Get<FSpacetimeDBUnit>();
 	}
 
-	FORCEINLINE FString GetAsFailed() const
+	FORCEINLINE FSpacetimeDBUnit GetAsCommitted() &&
+	{
+		ensureMsgf(IsCommitted(), TEXT("MessageData does not hold Committed!"));
+		return MoveTemp(MessageData.Get<FSpacetimeDBUnit>());
+	}
+
+	FORCEINLINE const FString& GetAsFailed() const&
 	{
 		ensureMsgf(IsFailed(), TEXT("MessageData does not hold Failed!"));
 		return MessageData.Get<FString>();
 	}
 
-	FORCEINLINE FSpacetimeDBUnit GetAsOutOfEnergy() const
+	FORCEINLINE FString GetAsFailed() &&
+	{
+		ensureMsgf(IsFailed(), TEXT("MessageData does not hold Failed!"));
+		return MoveTemp(MessageData.Get<FString>());
+	}
+
+	FORCEINLINE const FSpacetimeDBUnit& GetAsOutOfEnergy() const&
 	{
 		ensureMsgf(IsOutOfEnergy(), TEXT("MessageData does not hold OutOfEnergy!"));
 		return MessageData.Get<FSpacetimeDBUnit>();
 	}
 
+	FORCEINLINE FSpacetimeDBUnit GetAsOutOfEnergy() &&
+	{
+		ensureMsgf(IsOutOfEnergy(), TEXT("MessageData does not hold OutOfEnergy!"));
+		return MoveTemp(MessageData.Get<FSpacetimeDBUnit>());
+	}
+
 	// -- Equality ----------------------
 	FORCEINLINE bool operator==(const FSpacetimeDBStatus& Other) const
 	{
@@ -327,47 +345,83 @@ public:
 
 	// Tag checks + GetAs methods
 	FORCEINLINE bool IsReducer() const { return Tag == ESpacetimeDBEventTag::Reducer; }
-	FORCEINLINE FReducerEvent GetAsReducer() const
+	FORCEINLINE const FReducerEvent& GetAsReducer() const&
 	{
 		ensureMsgf(IsReducer(), TEXT("MessageData does not hold Reducer!"));
 		return MessageData.Get<FReducerEvent>();
 	}
 
+	FORCEINLINE FReducerEvent GetAsReducer() &&
+	{
+		ensureMsgf(IsReducer(), TEXT("MessageData does not hold Reducer!"));
+		return MoveTemp(MessageData.Get<FReducerEvent>());
+	}
+
 	FORCEINLINE bool IsSubscribeApplied() const { return Tag == ESpacetimeDBEventTag::SubscribeApplied; }
-	FORCEINLINE FSpacetimeDBUnit GetAsSubscribeApplied() const
+	FORCEINLINE const FSpacetimeDBUnit& GetAsSubscribeApplied() const&
 	{
 		ensureMsgf(IsSubscribeApplied(), TEXT("MessageData does not hold SubscribeApplied!"));
 		return MessageData.Get<FSpacetimeDBUnit>();
 	}
 
+	FORCEINLINE FSpacetimeDBUnit GetAsSubscribeApplied() &&
+	{
+		ensureMsgf(IsSubscribeApplied(), TEXT("MessageData does not hold SubscribeApplied!"));
+		return MoveTemp(MessageData.Get<FSpacetimeDBUnit>());
+	}
+
 	FORCEINLINE bool IsUnsubscribeApplied() const { return Tag == ESpacetimeDBEventTag::UnsubscribeApplied; }
-	FORCEINLINE FSpacetimeDBUnit GetAsUnsubscribeApplied() const
+	FORCEINLINE const FSpacetimeDBUnit& GetAsUnsubscribeApplied() const&
 	{
 		ensureMsgf(IsUnsubscribeApplied(), TEXT("MessageData does not hold UnsubscribeApplied!"));
 		return MessageData.Get<FSpacetimeDBUnit>();
 	}
 
+	FORCEINLINE FSpacetimeDBUnit GetAsUnsubscribeApplied() &&
+	{
+		ensureMsgf(IsUnsubscribeApplied(), TEXT("MessageData does not hold UnsubscribeApplied!"));
+		return MoveTemp(MessageData.Get<FSpacetimeDBUnit>());
+	}
+
 	FORCEINLINE bool IsDisconnected() const { return Tag == ESpacetimeDBEventTag::Disconnected; }
-	FORCEINLINE FSpacetimeDBUnit GetAsDisconnected() const
+	FORCEINLINE const FSpacetimeDBUnit& GetAsDisconnected() const&
 	{
 		ensureMsgf(IsDisconnected(), TEXT("MessageData does not hold Disconnected!"));
 		return MessageData.Get<FSpacetimeDBUnit>();
 	}
 
+	FORCEINLINE FSpacetimeDBUnit GetAsDisconnected() &&
+	{
+		ensureMsgf(IsDisconnected(), TEXT("MessageData does not hold Disconnected!"));
+		return MoveTemp(MessageData.Get<FSpacetimeDBUnit>());
+	}
+
 	FORCEINLINE bool IsSubscribeError() const { return Tag == ESpacetimeDBEventTag::SubscribeError; }
-	FORCEINLINE FString GetAsSubscribeError() const
+	FORCEINLINE const FString& GetAsSubscribeError() const&
 	{
 		ensureMsgf(IsSubscribeError(), TEXT("MessageData does not hold SubscribeError!"));
 		return MessageData.Get<FString>();
 	}
 
+	FORCEINLINE FString GetAsSubscribeError() &&
+	{
+		ensureMsgf(IsSubscribeError(), TEXT("MessageData does not hold SubscribeError!"));
+		return MoveTemp(MessageData.Get<FString>());
+	}
+
 	FORCEINLINE bool IsUnknownTransaction() const { return Tag == ESpacetimeDBEventTag::UnknownTransaction; }
-	FORCEINLINE FSpacetimeDBUnit GetAsUnknownTransaction() const
+	FORCEINLINE const FSpacetimeDBUnit& GetAsUnknownTransaction() const&
 	{
 		ensureMsgf(IsUnknownTransaction(), TEXT("MessageData does not hold UnknownTransaction!"));
 		return MessageData.Get<FSpacetimeDBUnit>();
 	}
 
+	FORCEINLINE FSpacetimeDBUnit GetAsUnknownTransaction() &&
+	{
+		ensureMsgf(IsUnknownTransaction(), TEXT("MessageData does not hold UnknownTransaction!"));
+		return MoveTemp(MessageData.Get<FSpacetimeDBUnit>());
+	}
+
 	// Equality operators
 	FORCEINLINE bool operator==(const FSpacetimeDBEvent& Other) const
 	{
@@ -7,18 +7,27 @@
 #include "Subscription.h"
 #include "ModuleBindings/Types/ServerMessageType.g.h"
 #include "DBCache/TableAppliedDiff.h"
+#include "DBCache/TableSnapshot.h"
 #include "HAL/CriticalSection.h"
 #include "Containers/Queue.h"
 #include "HAL/ThreadSafeBool.h"
 #include "BSATN/UEBSATNHelpers.h"
 #include "Connection/SetReducerFlags.h"
 #include "Connection/Callback.h"
+#include "Connection/DecodeWorkerPool.h"
+#include "Connection/SequencedMessageRing.h"
+#include "Connection/OutgoingReducerScheduler.h"
+#include "Connection/ReducerCallWriter.h"
+#include "Connection/ParallelTableApply.h"
+#include "Connection/CacheApplyThread.h"
+#include <atomic>
 
 #include "DbConnectionBase.generated.h"
 
 
 
 class UDbConnectionBuilder;
+class UDbConnectionBase;
 
 /** Macro for safae way to bind delegate without needing to write Function name as an FName. */
 #define BIND_DELEGATE_SAFE(DelegateVar, Object, ClassType, FunctionName) \
@@ -47,27 +56,39 @@ DECLARE_DYNAMIC_DELEGATE_TwoParams(
 	const FString&, Error);
 
 
-/** Key used to index preprocessed table data without relying on row addresses */
-struct FPreprocessedTableKey
+namespace UE::SpacetimeDB
 {
-	uint32 TableId;
-	FString TableName;
+	/** Cache update of one table made by the apply thread, waiting for the game thread to broadcast it. */
+	class FAppliedTableUpdateBase
+	{
+	public:
+		virtual ~FAppliedTableUpdateBase() {}
 
-	FPreprocessedTableKey() : TableId(0) {}
-	FPreprocessedTableKey(uint32 InId, const FString& InName)
-		: TableId(InId), TableName(InName) {
-	}
+		/** Make the table snapshot this update produced the one game thread reads see. */
+		virtual void MakeVisible() = 0;
 
-	friend bool operator==(const FPreprocessedTableKey& A, const FPreprocessedTableKey& B)
-	{
-		return A.TableId == B.TableId && A.TableName == B.TableName;
-	}
-};
+		/** Broadcast the diff to the table's delegates. */
+		virtual void Broadcast(UDbConnectionBase* Conn, void* Context) = 0;
+	};
+}
 
-FORCEINLINE uint32 GetTypeHash(const FPreprocessedTableKey& Key)
+/** A decoded server message together with the rows its decode worker already deserialized. */
+struct FParsedServerMessage
 {
-	return HashCombine(GetTypeHash(Key.TableId), GetTypeHash(Key.TableName));
-}
+	FServerMessageType Message;
+
+	/**
+	 * Preprocessed rows for each entry of the message's database update Tables, in the same order.
+	 * Null where the table has no registered deserializer. Empty for messages without a database update.
+	 */
+	TArray<TSharedPtr<UE::SpacetimeDB::FPreprocessedTableDataBase>> TableData;
+
+	/** Table updates the apply thread already made to the cache, in the order of the registered tables in the update. */
+	TArray<TSharedPtr<UE::SpacetimeDB::FAppliedTableUpdateBase>> AppliedTables;
+
+	/** Set once the apply thread handled the message, the game thread then only broadcasts AppliedTables. */
+	bool bCacheApplied = false;
+};
 
 UCLASS()
 class SPACETIMEDBSDK_API UDbConnectionBase : public UObject, public FTickableGameObject
@@ -79,6 +100,8 @@ public:
 	/** The default constructor is private to prevent instantiation without using the builder. */
 	explicit UDbConnectionBase(const FObjectInitializer& ObjectInitializer = FObjectInitializer::Get());
 
+	virtual void BeginDestroy() override;
+
 	/** Disconnect from the server. */
 	UFUNCTION(BlueprintCallable, Category="SpacetimeDB")
 	void Disconnect();
@@ -93,10 +116,45 @@ public:
 	UFUNCTION(BlueprintCallable, Category="SpacetimeDB")
 	void SetAutoTicking(bool bAutoTick) { bIsAutoTicking = bAutoTick; }
 
+	/**
+	 * Limit how long FrameTick may spend applying messages. Messages left over carry to the next tick.
+	 * A message is always applied whole and at least one is applied per tick.
+	 * @param BudgetMs Time budget in milliseconds, 0 or less disables the limit.
+	 */
+	UFUNCTION(BlueprintCallable, Category="SpacetimeDB")
+	void SetFrameBudgetMs(float BudgetMs) { FrameBudgetMs = BudgetMs; }
+
+	/**
+	 * Apply the tables of one update in parallel once it carries at least MinRows rows in total.
+	 * Table events are still broadcast in order on the game thread after every table is applied.
+	 * @param MinRows Total inserts and deletes, 0 or less always applies tables one at a time.
+	 */
+	UFUNCTION(BlueprintCallable, Category="SpacetimeDB")
+	void SetParallelApplyMinRows(int32 MinRows) { ParallelApplyMinRows = MinRows; }
+
+	/** Number of received messages not yet applied, including ones still being decoded. */
+	UFUNCTION(BlueprintPure, Category="SpacetimeDB")
+	int32 GetPendingMessageCount() const;
+
+	/** Milliseconds since the oldest message that has not been applied was received, 0 if none. */
+	UFUNCTION(BlueprintPure, Category="SpacetimeDB")
+	float GetOldestPendingMessageAgeMs() const;
+
+	/**
+	 * Rate at which coalesced reducer calls are flushed, see CallReducerCoalesced.
+	 * @param Hz Sends per second, 0 or less flushes on every FrameTick.
+	 */
+	UFUNCTION(BlueprintCallable, Category="SpacetimeDB")
+	void SetOutgoingSendRate(float Hz) { OutgoingScheduler.SetSendRate(Hz); }
+
+	/** Coalesced reducer calls requested versus actually sent. */
+	UFUNCTION(BlueprintPure, Category="SpacetimeDB")
+	FSpacetimeDBOutgoingCallStats GetOutgoingCallStats() const { return OutgoingScheduler.GetStats(); }
+
 	/** Send a raw JSON message to the server. */
 	bool SendRawMessage(const FString& Message);
 	/** Send a raw binary message to the server. */
-	bool SendRawMessage(const TArray<uint8>& Message);
+	bool SendRawMessage(TArrayView<const uint8> Message);
 
 	/** Get the current subscription builder. This is used to create subscriptions. */
 	UFUNCTION()
@@ -110,19 +168,47 @@ public:
 	UFUNCTION(BlueprintPure, Category = "SpacetimeDB")
 	FSpacetimeDBConnectionId GetConnectionId() const;
 
+	/** Per-worker utilization of the message decode pool. Empty until the first message arrives. */
+	TArray<FDecodeWorkerStats> GetDecodeWorkerStats() const;
+
+	/** Number of received messages waiting for a decode worker, including ones held back on the game thread. */
+	int32 GetDecodeQueueDepth() const;
+
 	// Typed reducer call helper: hides BSATN bytes from callers.
+	// Args are serialized straight into the send buffer, see UE::SpacetimeDB::WriteCallReducerMessage.
 	template<typename ArgsStruct>
 	void CallReducerTyped(const FString& Reducer, const ArgsStruct& Args, USetReducerFlagsBase* Flags)
 	{
-		TArray<uint8> Bytes = UE::SpacetimeDB::Serialize(Args);
-		InternalCallReducer(Reducer, MoveTemp(Bytes), Flags);
+		InternalCallReducer(Reducer, [&Args](UE::SpacetimeDB::UEWriter& Writer) { UE::SpacetimeDB::serialize(Writer, Args); }, Flags);
+	}
+
+	/**
+	 * Latest-value-wins reducer call, sent on the next flush at the outgoing send rate instead of immediately.
+	 * Calls for the same reducer and Target replace each other, use it for state that is resent continuously such as player input.
+	 * @param IsSignificant Optional test against the last value sent, returning false skips the send.
+	 */
+	template<typename ArgsStruct, typename PredicateType = FOutgoingReducerScheduler::TSignificancePredicate<ArgsStruct>>
+	void CallReducerCoalesced(const FString& Reducer, uint64 Target, const ArgsStruct& Args, USetReducerFlagsBase* Flags,
+		PredicateType&& IsSignificant = nullptr)
+	{
+		OutgoingScheduler.Queue<ArgsStruct>(Reducer, Target, Args, Flags, Forward<PredicateType>(IsSignificant));
 	}
 
+	/** Total seconds the apply thread spent applying messages, 0 when the connection applies them on the game thread. */
+	double GetApplyThreadBusySeconds() const { return ApplyThread ? ApplyThread->GetBusySeconds() : 0.0; }
+
+	/** Register the row deserializer of a table, rows are cached by their serialized primary key when WriteKey is set. */
 	template<typename RowType>
-	void RegisterTable(const FString& TableName)
+	void RegisterTable(const FString& TableName, UE::SpacetimeDB::TRowKeyWriter<RowType> WriteKey = UE::SpacetimeDB::TRowKeyWriter<RowType>())
 	{
 		FScopeLock Lock(&TableDeserializersMutex);
-		TableDeserializers.Add(TableName, MakeShared<UE::SpacetimeDB::TTableRowDeserializer<RowType>>());
+		if (TSharedPtr<UE::SpacetimeDB::ITableRowDeserializer>* Existing = TableDeserializers.Find(TableName))
+		{
+			// Decode workers may still be using the old instance through the id cache
+			RetiredDeserializers.Add(*Existing);
+			ResetDeserializersById();
+		}
+		TableDeserializers.Add(TableName, MakeShared<UE::SpacetimeDB::TTableRowDeserializer<RowType>>(MoveTemp(WriteKey)));
 	}
 
 	/** Internal interface for applying table updates generically */
@@ -131,11 +217,47 @@ public:
 	public:
 		virtual ~ITableUpdateHandler() {}
 
-		/** Update the in-memory cache for the table and store the diff */
-		virtual void UpdateCache(UDbConnectionBase* Conn, const FTableUpdateType& Update, void* Context) = 0;
+		/**
+		 * Update the in-memory cache for the table and store the diff. Preprocessed is null when the rows still need parsing.
+		 * May run on a task thread, concurrently with the handlers of other tables.
+		 */
+		virtual void UpdateCache(UDbConnectionBase* Conn, const FTableUpdateType& Update, const TSharedPtr<UE::SpacetimeDB::FPreprocessedTableDataBase>& Preprocessed, void* Context) = 0;
 
 		/** Broadcast the previously stored diff */
 		virtual void BroadcastDiff(UDbConnectionBase* Conn, void* Context) = 0;
+
+		/**
+		 * Hand the table cache to the apply thread. Snapshots are enabled and only made visible by the game thread,
+		 * which reads the table through them from then on.
+		 */
+		virtual void TakeCacheOwnership() = 0;
+
+		/** Update the cache on the apply thread, the game thread broadcasts the returned update later. */
+		virtual TSharedPtr<UE::SpacetimeDB::FAppliedTableUpdateBase> ApplyToCache(const FTableUpdateType& Update, const TSharedPtr<UE::SpacetimeDB::FPreprocessedTableDataBase>& Preprocessed) = 0;
+	};
+
+	/** Diff applied to a table by the apply thread, with the snapshot of the table right after it. */
+	template<typename RowType, typename TableClass, typename EventContext>
+	class TAppliedTableUpdate : public UE::SpacetimeDB::FAppliedTableUpdateBase
+	{
+	public:
+		TAppliedTableUpdate(TableClass* InTable, FTableAppliedDiff<RowType>&& InDiff, TSharedPtr<const FTableSnapshot<RowType>> InSnapshot)
+			: Table(InTable), Diff(MoveTemp(InDiff)), Snapshot(MoveTemp(InSnapshot)) {}
+
+		virtual void MakeVisible() override
+		{
+			Table->GetSnapshotPublisher()->MakeVisible(Snapshot);
+		}
+
+		virtual void Broadcast(UDbConnectionBase* Conn, void* Context) override
+		{
+			Conn->BroadcastDiff(Table, Diff, *reinterpret_cast<EventContext*>(Context));
+		}
+
+	private:
+		TableClass* Table;
+		FTableAppliedDiff<RowType> Diff;
+		TSharedPtr<const FTableSnapshot<RowType>> Snapshot;
 	};
 
 	template<typename RowType, typename TableClass, typename EventContext>
@@ -145,23 +267,9 @@ public:
 		explicit TTableUpdateHandler(TableClass* InTable) : Table(InTable) {}
 
 		//** Update the in-memory cache for the table and store the diff */
-		virtual void UpdateCache(UDbConnectionBase* Conn, const FTableUpdateType& Update, void* Context) override
+		virtual void UpdateCache(UDbConnectionBase* Conn, const FTableUpdateType& Update, const TSharedPtr<UE::SpacetimeDB::FPreprocessedTableDataBase>& Preprocessed, void* Context) override
 		{
-			// Attempt to take preprocessed data if available
-			TSharedPtr<UE::SpacetimeDB::TPreprocessedTableData<RowType>> Pre;
-			if (Conn->TakePreprocessedTableData<RowType>(Update, Pre))
-			{
-				// If preprocessed data is available, use it to update the table
-				LastDiff = Table->Update(Pre->Inserts, Pre->Deletes);
-			}
-			else
-			{
-				// If no preprocessed data, process the update directly. Backup
-				UE_LOG(LogTemp, Warning, TEXT("No preprocessed data for table update. Processing directly."));
-				TArray<FWithBsatn<RowType>> Inserts, Deletes;
-				UE::SpacetimeDB::ProcessTableUpdateWithBsatn<RowType>(Update, Inserts, Deletes);
-				LastDiff = Table->Update(Inserts, Deletes);
-			}
+			LastDiff = ApplyUpdate(Update, Preprocessed);
 		}
 		//** Broadcast the last stored diff to the table's delegates */
 		virtual void BroadcastDiff(UDbConnectionBase* Conn, void* Context) override
@@ -170,7 +278,37 @@ public:
 			Conn->BroadcastDiff(Table, LastDiff, Ctx);
 		}
 
+		virtual void TakeCacheOwnership() override
+		{
+			Table->EnableSnapshots();
+			Table->GetSnapshotPublisher()->DeferVisibility();
+		}
+
+		virtual TSharedPtr<UE::SpacetimeDB::FAppliedTableUpdateBase> ApplyToCache(const FTableUpdateType& Update, const TSharedPtr<UE::SpacetimeDB::FPreprocessedTableDataBase>& Preprocessed) override
+		{
+			FTableAppliedDiff<RowType> Diff = ApplyUpdate(Update, Preprocessed);
+			// Published by the update, not visible until the game thread broadcasts it
+			TSharedPtr<const FTableSnapshot<RowType>> Snapshot = Table->GetSnapshotPublisher()->Pin();
+			return MakeShared<TAppliedTableUpdate<RowType, TableClass, EventContext>>(Table, MoveTemp(Diff), MoveTemp(Snapshot));
+		}
+
 	private:
+		FTableAppliedDiff<RowType> ApplyUpdate(const FTableUpdateType& Update, const TSharedPtr<UE::SpacetimeDB::FPreprocessedTableDataBase>& Preprocessed)
+		{
+			if (Preprocessed.IsValid())
+			{
+				// The table's deserializer was registered with the same row type, and each message is applied once so the rows can be moved out
+				UE::SpacetimeDB::TPreprocessedTableData<RowType>& Pre = static_cast<UE::SpacetimeDB::TPreprocessedTableData<RowType>&>(*Preprocessed);
+				return Table->Update(MoveTemp(Pre.Inserts), MoveTemp(Pre.Deletes));
+			}
+
+			// If no preprocessed data, process the update directly. Backup
+			UE_LOG(LogTemp, Warning, TEXT("No preprocessed data for table update. Processing directly."));
+			TArray<FWithBsatn<RowType>> Inserts, Deletes;
+			UE::SpacetimeDB::ProcessTableUpdateWithBsatn<RowType>(Update, Inserts, Deletes, UE::SpacetimeDB::MakeRowKeyWriter<RowType, TableClass>());
+			return Table->Update(Inserts, Deletes);
+		}
+
 		TableClass* Table;
 		FTableAppliedDiff<RowType> LastDiff;
 	};
@@ -178,33 +316,18 @@ public:
 	template<typename RowType, typename TableClass, typename EventContext>
 	void RegisterTable(const FString& TableName, TableClass* Table)
 	{
-		RegisterTable<RowType>(TableName);
-		FScopeLock Lock(&RegisteredTablesMutex);
-		RegisteredTables.Add(TableName, MakeShared<TTableUpdateHandler<RowType, TableClass, EventContext>>(Table));
-	}
-	//** Take preprocessed table row data. */
-	template<typename RowType>
-	bool TakePreprocessedTableData(const FTableUpdateType& Update, TSharedPtr<UE::SpacetimeDB::TPreprocessedTableData<RowType>>& OutData)
-	{
-		FScopeLock Lock(&PreprocessedDataMutex);
-		FPreprocessedTableKey Key(Update.TableId, Update.TableName);
-		if (TArray<TSharedPtr<UE::SpacetimeDB::FPreprocessedTableDataBase>>* Found = PreprocessedTableData.Find(Key))
+		if (ApplyThread)
 		{
-			if (Found->Num() > 0)
-			{
-				OutData = StaticCastSharedPtr<UE::SpacetimeDB::TPreprocessedTableData<RowType>>((*Found)[0]);
-				Found->RemoveAt(0);
-				if (Found->Num() == 0)
-				{
-					PreprocessedTableData.Remove(Key);
-				}
-				return OutData.IsValid();
-			}
+			// The apply thread owns the handler cache and every table cache it was started with
+			UE_LOG(LogTemp, Error, TEXT("RegisterTable: %s registered after the apply thread started, ignored"), *TableName);
+			return;
 		}
-		return false;
+		RegisterTable<RowType>(TableName, UE::SpacetimeDB::MakeRowKeyWriter<RowType, TableClass>());
+		FScopeLock Lock(&RegisteredTablesMutex);
+		RegisteredTables.Add(TableName, MakeShared<TTableUpdateHandler<RowType, TableClass, EventContext>>(Table));
+		HandlersById.Reset();
 	}
 
-
 protected:
 
 	friend class UDbConnectionBuilderBase;
@@ -212,6 +335,8 @@ protected:
 	friend class USubscriptionHandleBase;
 	friend class USubscriptionBuilder;
 	friend class URemoteReducers;
+	/** Lets the SDK automation tests drive the message pipeline without a socket. */
+	friend class FDbConnectionBaseTestAccess;
 
 	/** Allow derived classes to override the delegates used when connecting */
 	void SetOnConnectDelegate(const FOnConnectBaseDelegate& Delegate) { OnConnectBaseDelegate = Delegate; }
@@ -223,6 +348,14 @@ protected:
 	void HandleWSClosed(int32 StatusCode, const FString& Reason, bool bWasClean);
 	UFUNCTION()
 	void HandleWSBinaryMessage(const TArray<uint8>& Message);
+	/** Native frame handler, shares ownership of the socket buffer instead of copying it. */
+	void HandleWSBinaryFrame(const FWebsocketFrameBuffer& Frame);
+
+	/**
+	 * Hand held back frames to the decode workers in arrival order. Game thread only.
+	 * Stops at the first frame the release ring or the decode queue has no room for, it is retried from FrameTick.
+	 */
+	void DispatchDeferredFrames();
 
 	virtual void Tick(float DeltaTime) override;
 
@@ -233,44 +366,138 @@ protected:
 	virtual bool IsTickableInEditor() const override;
 
 	/** Internal handler that processes a single server message. */
-	void ProcessServerMessage(const FServerMessageType& Message);
-	void PreProcessDatabaseUpdate(const FDatabaseUpdateType& Update);
-	/** Decompress and parse a raw message. */
-	FServerMessageType PreProcessMessage(const TArray<uint8>& Message);
-	bool DecompressPayload(ECompressableQueryUpdateTag Variant, const TArray<uint8>& In, TArray<uint8>& Out);
-	bool DecompressGzip(const TArray<uint8>& InData, TArray<uint8>& OutData);
-	bool DecompressBrotli(const TArray<uint8>& InData, TArray<uint8>& OutData);
+	void ProcessServerMessage(const FParsedServerMessage& Parsed);
+	/** Deserialize the rows of every table in Update, OutTableData receives one entry per table. */
+	void PreProcessDatabaseUpdate(const FDatabaseUpdateType& Update, TArray<TSharedPtr<UE::SpacetimeDB::FPreprocessedTableDataBase>>& OutTableData);
+	/** Decompress and parse a raw message, deserializing the rows it carries. */
+	FParsedServerMessage PreProcessMessage(const FWebsocketFrameBuffer& Message);
+	bool DecompressPayload(ECompressableQueryUpdateTag Variant, TArrayView<const uint8> In, TArray<uint8>& Out);
+	bool DecompressGzip(TArrayView<const uint8> InData, TArray<uint8>& OutData);
+	bool DecompressBrotli(TArrayView<const uint8> InData, TArray<uint8>& OutData);
+
+	/**
+	 * Decoded messages waiting to be applied, released in arrival order.
+	 * Decode workers publish into it without locking, FrameTick or else the apply thread is the only consumer.
+	 */
+	TSequencedMessageRing<FParsedServerMessage> ReleaseRing{ ReleaseRingCapacity };
+
+	/** Number of in-order release slots, further frames wait in DeferredFrames until FrameTick releases a message. */
+	static constexpr uint32 ReleaseRingCapacity = 1024;
+
+	/** Sequence number handed to the next message dispatched to a decode worker. Only touched on the game thread. */
+	uint64 NextPreprocessId = 0;
 
-	/** Pending messages awaiting processing on the game thread. */
-	TArray<FServerMessageType> PendingMessages;
+	/**
+	 * Received frames not yet handed to a decode worker, oldest first. Only touched on the game thread.
+	 * Keeps the socket callback from ever waiting on a full decode queue or release ring.
+	 * Unbounded: IWebSocket cannot stop reading, so when decoding or FrameTick falls behind the frames pile up here.
+	 * GetDecodeQueueDepth reports its length.
+	 */
+	TQueue<FWebsocketFrameBuffer> DeferredFrames;
+
+	/** Number of frames in DeferredFrames. */
+	int32 NumDeferredFrames = 0;
+
+	/** Number of messages FrameTick has taken for processing. Only touched on the game thread. */
+	uint64 NumReleasedMessages = 0;
+
+	/** Receive time of every message not yet applied, oldest first. Only touched on the game thread. */
+	TQueue<double> PendingReceiveTimes;
 
-	/** Mutex protecting access to PendingMessages. */
-	FCriticalSection PendingMessagesMutex;
+	/** Coalesced outgoing reducer calls, flushed from FrameTick. */
+	FOutgoingReducerScheduler OutgoingScheduler;
 
-	/** Map of preprocessed messages keyed by their sequential id. */
-	TMap<int32, FServerMessageType> PreprocessedMessages;
+	/** FrameTick time budget in milliseconds, 0 or less means no limit. */
+	float FrameBudgetMs = 0.0f;
+
+	/** Total rows of an update from which its tables are applied in parallel, 0 or less disables it. Read by the apply thread. */
+	std::atomic<int32> ParallelApplyMinRows{ UE::SpacetimeDB::DefaultParallelApplyMinRows };
+
+	/** Apply table updates on ApplyThread instead of in FrameTick, set by the builder. */
+	bool bUseApplyThread = false;
+
+	/**
+	 * Applies decoded messages to the table caches ahead of FrameTick, which then only broadcasts them.
+	 * Started with the first received message when bUseApplyThread is set.
+	 */
+	TUniquePtr<TCacheApplyThread<FParsedServerMessage>> ApplyThread;
 
-	/** Protects PreprocessedMessages and PendingMessages ordering state. */
-	FCriticalSection PreprocessMutex;
+	/** Maximum number of applied messages waiting for FrameTick before the apply thread waits. */
+	static constexpr int32 MaxAppliedAhead = 64;
 
-	/** Counter for assigning ids to incoming messages. */
-	FThreadSafeCounter NextPreprocessId;
+	/** Start the apply thread and hand it every registered table cache. Falls back to game thread apply on failure. */
+	void StartApplyThread();
 
-	/** Id of the next message expected to be released. */
-	int32 NextReleaseId = 0;
+	/** Apply the database update of a message to the table caches, filling its AppliedTables. Apply thread only. */
+	void ApplyMessageToCaches(FParsedServerMessage& Parsed);
+
+	/** Worker threads that decompress and deserialize incoming messages. */
+	TUniquePtr<FDecodeWorkerPool> DecodePool;
+
+	/** Number of decode workers to start, 0 picks a default from the core count. */
+	int32 DecodeWorkerCount = 0;
+
+	/** Maximum number of messages waiting for a decode worker, further frames wait in DeferredFrames. */
+	static constexpr int32 DecodeQueueCapacity = 256;
+
+	/** Decode workers keep their decompression buffer between messages unless it grows past this. */
+	static constexpr int32 MaxRetainedScratchBytes = 16 * 1024 * 1024;
 
 	// Map of table name to row deserializer
 	TMap<FString, TSharedPtr<UE::SpacetimeDB::ITableRowDeserializer>> TableDeserializers;
 	FCriticalSection TableDeserializersMutex;
 
-	// Map from table update pointer to preprocessed data
-	TMap<FPreprocessedTableKey, TArray<TSharedPtr<UE::SpacetimeDB::FPreprocessedTableDataBase>>> PreprocessedTableData;
-	FCriticalSection PreprocessedDataMutex;
+	/** Deserializers replaced by a later registration, kept alive because DeserializersById may still point at them. */
+	TArray<TSharedPtr<UE::SpacetimeDB::ITableRowDeserializer>> RetiredDeserializers;
+
+	/** Table ids below this are dispatched through flat arrays, larger ids always go through the name maps. */
+	static constexpr uint32 MaxIndexedTableId = 4096;
+
+	/**
+	 * Row deserializer per table id, resolved by name on the first update of each table.
+	 * Read by decode workers without locking, only written under TableDeserializersMutex.
+	 */
+	TUniquePtr<std::atomic<UE::SpacetimeDB::ITableRowDeserializer*>[]> DeserializersById;
+
+	/** Find the row deserializer for a table, through the id cache when possible. Safe from any thread. */
+	UE::SpacetimeDB::ITableRowDeserializer* FindTableDeserializer(const FTableUpdateType& TableUpdate);
+
+	/** Forget every resolved table id. Caller holds TableDeserializersMutex. */
+	void ResetDeserializersById();
+
+	/** Message being applied by ProcessServerMessage, lets ApplyRegisteredTableUpdates find its preprocessed rows. Game thread only. */
+	const FParsedServerMessage* ApplyingMessage = nullptr;
 
 	// Map of table name to generic table update handler
 	TMap<FString, TSharedPtr<ITableUpdateHandler>> RegisteredTables;
 	FCriticalSection RegisteredTablesMutex;
 
+	/** Update handler resolved for a table id, Handler stays null for tables nobody registered. */
+	struct FTableHandlerSlot
+	{
+		TSharedPtr<ITableUpdateHandler> Handler;
+		bool bResolved = false;
+	};
+
+	/** Update handler per table id, resolved by name on the first update of each table. Only used by the thread applying the caches. */
+	TArray<FTableHandlerSlot> HandlersById;
+
+	/** Find the update handler for a table, through the id cache when possible. Only called by the thread applying the caches. */
+	ITableUpdateHandler* FindTableUpdateHandler(const FTableUpdateType& TableUpdate);
+
+	/** Registered tables of one database update, in update order, with the rows each carries. */
+	struct FResolvedTableUpdates
+	{
+		TArray<ITableUpdateHandler*, TInlineAllocator<16>> Handlers;
+		TArray<int32, TInlineAllocator<16>> TableIndices;
+		TArray<int64, TInlineAllocator<16>> RowCounts;
+		/** False when a table is listed twice, its updates then have to be applied in order. */
+		bool bDistinctTables = true;
+	};
+
+	/** Resolve the handler of every table in Update. TableData is the preprocessed rows matching Update, or null. */
+	void ResolveTableUpdates(const FDatabaseUpdateType& Update, const TArray<TSharedPtr<UE::SpacetimeDB::FPreprocessedTableDataBase>>* TableData, FResolvedTableUpdates& Out);
+
 
 	/** Start a subscription. This will add the subscription to the active list and send a subscribe message to the server. */
 	void StartSubscription(USubscriptionHandleBase* Handle);
@@ -279,6 +506,8 @@ protected:
 
 	/** Call a reducer on the connected SpacetimeDB instance. */
 	void InternalCallReducer(const FString& Reducer, TArray<uint8> Args, USetReducerFlagsBase* Flags);
+	/** Call a reducer, WriteArgs serializes the arguments in place into the outgoing message. */
+	void InternalCallReducer(const FString& Reducer, UE::SpacetimeDB::FReducerArgsWriter WriteArgs, USetReducerFlagsBase* Flags);
 
 	/**
 	* Update function to apply database changes.
@@ -287,6 +516,13 @@ protected:
 	*/
 	virtual void DbUpdate(const FDatabaseUpdateType& Update, const FSpacetimeDBEvent& Event) {};
 
+	/**
+	 * Called once per TransactionUpdate before DbUpdate and ReducerEvent, and EndReducerEvent after them.
+	 * Lets child classes decode the reducer arguments a single time and share them between both calls.
+	 */
+	virtual void BeginReducerEvent(const FReducerEvent& Event) {};
+	virtual void EndReducerEvent() {};
+
 	/** Event handler for reducer events. This can should overridden by child classes to handle specific reducer events. */
 	virtual void ReducerEvent(const FReducerEvent& Event) {};
 
@@ -354,18 +590,18 @@ protected:
 		// Broadcast the diff to the table's delegates
 		if (Table->OnInsert.IsBound())
 		{
-			for (const TPair<TArray<uint8>, RowType>& Pair : Diff.Inserts)
+			for (const TPair<FRowKey, TSharedPtr<const RowType>>& Pair : Diff.Inserts)
 			{
-				Table->OnInsert.Broadcast(Context, Pair.Value);
+				Table->OnInsert.Broadcast(Context, *Pair.Value);
 			}
 		}
 
 		// If the table has a delete delegate, broadcast deletes
 		if (Table->OnDelete.IsBound())
 		{
-			for (const TPair<TArray<uint8>, RowType>& Pair : Diff.Deletes)
+			for (const TPair<FRowKey, TSharedPtr<const RowType>>& Pair : Diff.Deletes)
 			{
-				Table->OnDelete.Broadcast(Context, Pair.Value);
+				Table->OnDelete.Broadcast(Context, *Pair.Value);
 			}
 		}
 
@@ -375,8 +611,8 @@ protected:
 			int32 Count = FMath::Min(Diff.UpdateDeletes.Num(), Diff.UpdateInserts.Num());
 			for (int32 Index = 0; Index < Count; ++Index)
 			{
-				const RowType& OldRow = Diff.UpdateDeletes[Index];
-				const RowType& NewRow = Diff.UpdateInserts[Index];
+				const RowType& OldRow = *Diff.UpdateDeletes[Index];
+				const RowType& NewRow = *Diff.UpdateInserts[Index];
 				Table->OnUpdate.Broadcast(Context, OldRow, NewRow);
 			}
 		}
@@ -22,9 +22,18 @@ public:
     /** Provide an authentication token if available. */
     UDbConnectionBuilderBase* WithTokenBase(const FString& InToken);
 
-    /** Provide an specific compresstion method. Brotli not implemented, will default to Gzip */
+    /** Provide an specific compresstion method. */
     UDbConnectionBuilderBase* WithCompressionBase(const ESpacetimeDBCompression& InCompression);
 
+    /** Set the number of threads used to decode incoming messages. 0 picks a default from the core count. */
+    UDbConnectionBuilderBase* WithDecodeWorkerCountBase(int32 InWorkerCount);
+
+    /**
+     * Apply table updates on a dedicated thread ahead of the game thread, which then only broadcasts the table events.
+     * Table reads go through snapshots in this mode, index lookups follow the visible snapshot.
+     */
+    UDbConnectionBuilderBase* WithApplyThreadBase(bool bInUseApplyThread);
+
     //@TODO: Add With Light Mode
     //UDbConnectionBuilderBase* WithLightMode(const bool& bWithLightMode);
 
@@ -46,6 +55,8 @@ private:
     FString Token;
     ESpacetimeDBCompression Compression;
     bool bCompressionSet = false;
+    int32 DecodeWorkerCount = 0;
+    bool bUseApplyThread = false;
 
     FOnConnectErrorDelegate OnConnectErrorCallback;
     FOnConnectBaseDelegate    OnConnectCallback;
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "Containers/Queue.h"
+#include <atomic>
+
+class FRunnableThread;
+
+/** Snapshot of a single decode worker's activity. */
+struct FDecodeWorkerStats
+{
+	/** Index of the worker inside its pool. */
+	int32 WorkerIndex = 0;
+	/** Number of jobs the worker has completed. */
+	int64 JobsProcessed = 0;
+	/** Seconds spent running jobs. */
+	double BusySeconds = 0.0;
+	/** Seconds spent waiting for work. */
+	double IdleSeconds = 0.0;
+
+	/** Fraction of the worker's lifetime spent running jobs, in [0, 1]. */
+	double GetUtilization() const
+	{
+		const double Total = BusySeconds + IdleSeconds;
+		return Total > 0.0 ? BusySeconds / Total : 0.0;
+	}
+};
+
+/**
+ * Fixed set of FRunnable threads that decode server messages off the game thread.
+ * The job queue is bounded and TryEnqueue never blocks, when the queue is full the job is refused
+ * and the producer holds on to it instead of stalling. The socket is not slowed down: the connection
+ * keeps refused frames in its own unbounded queue, so a slow decoder costs memory rather than throughput.
+ */
+class SPACETIMEDBSDK_API FDecodeWorkerPool
+{
+public:
+	/**
+	 * Start the worker threads.
+	 * @param NumWorkers Number of threads to spawn, clamped to at least 1.
+	 * @param MaxQueuedJobs Maximum number of jobs waiting for a worker before TryEnqueue refuses more.
+	 */
+	FDecodeWorkerPool(int32 NumWorkers, int32 MaxQueuedJobs);
+	~FDecodeWorkerPool();
+
+	FDecodeWorkerPool(const FDecodeWorkerPool&) = delete;
+	FDecodeWorkerPool& operator=(const FDecodeWorkerPool&) = delete;
+
+	/**
+	 * Queue a job for a worker, never waits. Runs the job inline if no worker could be started.
+	 * @return False, leaving Job untouched, if the queue is full or the pool has been shut down.
+	 */
+	bool TryEnqueue(TUniqueFunction<void()>&& Job);
+
+	/** Stop all workers and drop any jobs that have not started. Safe to call more than once. */
+	void Shutdown();
+
+	/** Number of worker threads. */
+	int32 GetNumWorkers() const { return Workers.Num(); }
+
+	/** Number of jobs waiting for a worker. */
+	int32 GetQueueDepth() const { return QueuedJobs.load(std::memory_order_relaxed); }
+
+	/** Number of jobs TryEnqueue refused because the queue was full. */
+	int64 GetBackpressureStalls() const { return BackpressureStalls.load(std::memory_order_relaxed); }
+
+	/** Per-worker utilization snapshot. */
+	TArray<FDecodeWorkerStats> GetWorkerStats() const;
+
+	/** Default number of workers when none is configured. */
+	static int32 GetDefaultNumWorkers();
+
+private:
+	class FWorker;
+
+	/** Pop the next job, waiting until one is available. Returns false on shutdown. */
+	bool WaitForJob(TUniqueFunction<void()>& OutJob);
+
+	/** Jobs waiting for a worker, guarded by QueueMutex. */
+	TQueue<TUniqueFunction<void()>> Jobs;
+	FCriticalSection QueueMutex;
+
+	/** Signalled when a job is queued. */
+	FEvent* WorkAvailable = nullptr;
+
+	TArray<FWorker*> Workers;
+	TArray<FRunnableThread*> Threads;
+
+	int32 MaxQueuedJobs = 0;
+	std::atomic<int32> QueuedJobs{ 0 };
+	std::atomic<int64> BackpressureStalls{ 0 };
+	std::atomic<bool> bStopping{ false };
+};
@@ -0,0 +1,144 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BSATN/UESpacetimeDB.h"
+#include "Connection/ReducerCallWriter.h"
+#include "Connection/SetReducerFlags.h"
+#include "OutgoingReducerScheduler.generated.h"
+
+/** Counters for coalesced reducer calls, used to size server capacity. */
+USTRUCT(BlueprintType)
+struct SPACETIMEDBSDK_API FSpacetimeDBOutgoingCallStats
+{
+	GENERATED_BODY()
+
+	/** Coalesced reducer calls requested by the game. */
+	UPROPERTY(BlueprintReadOnly, Category = "SpacetimeDB")
+	int64 Requested = 0;
+
+	/** Calls actually sent to the server. */
+	UPROPERTY(BlueprintReadOnly, Category = "SpacetimeDB")
+	int64 Sent = 0;
+
+	/** Flushed values dropped because they did not differ enough from the last value sent. */
+	UPROPERTY(BlueprintReadOnly, Category = "SpacetimeDB")
+	int64 SkippedBelowThreshold = 0;
+};
+
+/**
+ * Latest-value-wins outgoing reducer calls flushed at a fixed rate.
+ *
+ * Every reducer and target pair owns one slot. Queueing overwrites the pending value of the slot,
+ * so between two flushes any number of calls collapse into a single send of the most recent value.
+ * Arguments are only serialized when they are actually sent, in place into the outgoing message. Game thread only.
+ */
+class SPACETIMEDBSDK_API FOutgoingReducerScheduler
+{
+public:
+	using FSendFunction = TFunctionRef<void(const FString& Reducer, UE::SpacetimeDB::FReducerArgsWriter WriteArgs, USetReducerFlagsBase* Flags)>;
+
+	/** Returns false when Next is too close to LastSent to be worth sending. */
+	template<typename ArgsStruct>
+	using TSignificancePredicate = TFunction<bool(const ArgsStruct& LastSent, const ArgsStruct& Next)>;
+
+	/**
+	 * Replace the pending call for Reducer and Target.
+	 * A reducer must always be queued with the same argument type, IsSignificant is only taken from the first call for a slot
+	 * and is only converted to a TSignificancePredicate then.
+	 */
+	template<typename ArgsStruct, typename PredicateType = TSignificancePredicate<ArgsStruct>>
+	void Queue(const FString& Reducer, uint64 Target, const ArgsStruct& Args, USetReducerFlagsBase* Flags, PredicateType&& IsSignificant = nullptr)
+	{
+		++Stats.Requested;
+		// Look the slot up without building an FSlotKey, which would copy the reducer name on every call
+		const uint32 KeyHash = HashSlotKey(Reducer, Target);
+		TUniquePtr<FSlotBase>* Slot = Slots.FindByHash(KeyHash, FSlotKeyRef{ Reducer, Target });
+		if (!Slot)
+		{
+			TUniquePtr<FSlotBase> NewSlot = MakeUnique<TSlot<ArgsStruct>>(TSignificancePredicate<ArgsStruct>(Forward<PredicateType>(IsSignificant)));
+			Slot = &Slots.AddByHash(KeyHash, FSlotKey{ Reducer, Target }, MoveTemp(NewSlot));
+		}
+		TSlot<ArgsStruct>& Typed = static_cast<TSlot<ArgsStruct>&>(**Slot);
+		Typed.Pending = Args;
+		Typed.Flags = Flags;
+	}
+
+	/** Send the pending calls if the send interval has elapsed since the last flush. */
+	void Tick(double Now, FSendFunction Send);
+
+	/** Send every pending call now. */
+	void Flush(FSendFunction Send);
+
+	/** Flush rate in Hz, 0 or less sends on every tick. */
+	void SetSendRate(float Hz) { SendInterval = Hz > 0.0f ? 1.0 / Hz : 0.0; }
+
+	/** Drop every slot, including the last sent values used for the significance test. */
+	void Reset() { Slots.Reset(); }
+
+	const FSpacetimeDBOutgoingCallStats& GetStats() const { return Stats; }
+
+private:
+	static uint32 HashSlotKey(const FString& Reducer, uint64 Target) { return HashCombine(GetTypeHash(Reducer), GetTypeHash(Target)); }
+
+	/** Borrowed key used for lookups. */
+	struct FSlotKeyRef
+	{
+		const FString& Reducer;
+		uint64 Target;
+	};
+
+	struct FSlotKey
+	{
+		FString Reducer;
+		uint64 Target = 0;
+
+		friend bool operator==(const FSlotKey& A, const FSlotKey& B) { return A.Target == B.Target && A.Reducer == B.Reducer; }
+		friend bool operator==(const FSlotKey& A, const FSlotKeyRef& B) { return A.Target == B.Target && A.Reducer == B.Reducer; }
+		friend uint32 GetTypeHash(const FSlotKey& Key) { return HashSlotKey(Key.Reducer, Key.Target); }
+	};
+
+	struct FSlotBase
+	{
+		virtual ~FSlotBase() {}
+
+		/** Send the pending value if there is one and it is significant. bOutSkipped is set when it was dropped by the threshold. */
+		virtual bool SendPending(const FString& Reducer, FSendFunction Send, bool& bOutSkipped) = 0;
+
+		TWeakObjectPtr<USetReducerFlagsBase> Flags;
+	};
+
+	template<typename ArgsStruct>
+	struct TSlot : FSlotBase
+	{
+		explicit TSlot(TSignificancePredicate<ArgsStruct>&& InIsSignificant) : IsSignificant(MoveTemp(InIsSignificant)) {}
+
+		virtual bool SendPending(const FString& Reducer, FSendFunction Send, bool& bOutSkipped) override
+		{
+			bOutSkipped = false;
+			if (!Pending.IsSet())
+			{
+				return false;
+			}
+			if (LastSent.IsSet() && IsSignificant && !IsSignificant(LastSent.GetValue(), Pending.GetValue()))
+			{
+				Pending.Reset();
+				bOutSkipped = true;
+				return false;
+			}
+			const ArgsStruct& Args = Pending.GetValue();
+			Send(Reducer, [&Args](UE::SpacetimeDB::UEWriter& Writer) { UE::SpacetimeDB::serialize(Writer, Args); }, Flags.Get());
+			LastSent = MoveTemp(Pending);
+			Pending.Reset();
+			return true;
+		}
+
+		TOptional<ArgsStruct> Pending;
+		TOptional<ArgsStruct> LastSent;
+		TSignificancePredicate<ArgsStruct> IsSignificant;
+	};
+
+	TMap<FSlotKey, TUniquePtr<FSlotBase>> Slots;
+	FSpacetimeDBOutgoingCallStats Stats;
+	double SendInterval = 1.0 / 30.0;
+	double LastFlushTime = 0.0;
+};
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Applies the cache updates of the tables in one database update.
+ * Every table owns an independent cache, so once an update is large enough its tables are applied
+ * in parallel on the task graph. Small updates stay on the calling thread, where a task dispatch would cost more than it saves.
+ */
+namespace UE::SpacetimeDB
+{
+	/** Default total row count from which the tables of an update are applied in parallel. */
+	constexpr int32 DefaultParallelApplyMinRows = 20000;
+
+	/**
+	 * Call Apply once for each table of an update and return once every call finished.
+	 * With at least two tables and MinRows or more rows in total, the calls run in parallel, largest table first.
+	 * Otherwise they run in order on the calling thread.
+	 * @param RowCounts Rows carried by each table, inserts and deletes.
+	 * @param MinRows Total row count from which tables are applied in parallel, 0 or less always applies them in order.
+	 * @param Apply Applies the table at the given index. Calls for different tables must not share state.
+	 * @return True when the tables were applied in parallel.
+	 */
+	SPACETIMEDBSDK_API bool ApplyTableUpdates(TArrayView<const int64> RowCounts, int32 MinRows, TFunctionRef<void(int32 TableIndex)> Apply);
+}
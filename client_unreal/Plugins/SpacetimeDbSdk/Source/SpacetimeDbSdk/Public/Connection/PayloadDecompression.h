@@ -0,0 +1,31 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ModuleBindings/Types/CompressableQueryUpdateType.g.h"
+
+/**
+ * Decompression helpers for server messages and compressed query updates.
+ * Stateless and thread-safe, they are called from the decode workers.
+ */
+namespace UE::SpacetimeDB::Compression
+{
+	/**
+	 * Inflate a gzip stream into OutData. The trailer size is only used as an allocation hint,
+	 * the output grows as inflate produces data so truncated or lying trailers are harmless.
+	 */
+	SPACETIMEDBSDK_API bool DecompressGzip(TArrayView<const uint8> InData, TArray<uint8>& OutData);
+
+	/** Decompress a Brotli stream into OutData, see BrotliDecoder.h. */
+	SPACETIMEDBSDK_API bool DecompressBrotli(TArrayView<const uint8> InData, TArray<uint8>& OutData);
+
+	/**
+	 * Decompress based on the compression variant without copying uncompressed input.
+	 * @param In Payload bytes, must outlive OutView when Variant is Uncompressed.
+	 * @param Scratch Buffer that receives decompressed bytes, reused across calls to avoid reallocating.
+	 * @param OutView Set to In for uncompressed payloads, otherwise to the decompressed bytes in Scratch.
+	 */
+	SPACETIMEDBSDK_API bool DecompressPayload(ECompressableQueryUpdateTag Variant, TArrayView<const uint8> In, TArray<uint8>& Scratch, TArrayView<const uint8>& OutView);
+
+	/** Decompress based on the compression variant, Uncompressed copies the input. */
+	SPACETIMEDBSDK_API bool DecompressPayload(ECompressableQueryUpdateTag Variant, TArrayView<const uint8> In, TArray<uint8>& Out);
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BSATN/UESpacetimeDB.h"
+
+/**
+ * Single pass serialization of CallReducer client messages.
+ * The message header and the reducer arguments are written in place into a send buffer owned by the
+ * calling thread, which keeps its capacity between calls, so steady state reducer calls do not allocate.
+ */
+namespace UE::SpacetimeDB
+{
+	/** Writes the BSATN encoded reducer arguments. */
+	using FReducerArgsWriter = TFunctionRef<void(UEWriter& Writer)>;
+
+	/**
+	 * Encode a complete CallReducer message, equivalent to serializing FClientMessageType::CallReducer.
+	 * @return View of the encoded message, valid until the next call on the same thread.
+	 */
+	SPACETIMEDBSDK_API TArrayView<const uint8> WriteCallReducerMessage(const FString& Reducer, uint32 RequestId, uint8 Flags, FReducerArgsWriter WriteArgs);
+
+	/** Encode a CallReducer message for a typed argument struct. */
+	template<typename ArgsStruct>
+	TArrayView<const uint8> WriteCallReducerMessage(const FString& Reducer, const ArgsStruct& Args, uint32 RequestId, uint8 Flags)
+	{
+		return WriteCallReducerMessage(Reducer, RequestId, Flags, [&Args](UEWriter& Writer) { serialize(Writer, Args); });
+	}
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Reducer name hashing used by generated code to dispatch on a reducer name with a switch.
+ * The compile-time and runtime versions produce the same value, so a name can be used as a case label.
+ * Two reducers hashing to the same value fail to compile as duplicate case labels,
+ * generated code still compares the full name inside each case.
+ */
+namespace UE::SpacetimeDB
+{
+	/** 32-bit FNV-1a over the UTF-16/32 code units of Name. */
+	constexpr uint32 ReducerNameHash(const TCHAR* Name, int32 Len)
+	{
+		uint32 Hash = 2166136261u;
+		for (int32 Index = 0; Index < Len; ++Index)
+		{
+			Hash = (Hash ^ static_cast<uint32>(Name[Index])) * 16777619u;
+		}
+		return Hash;
+	}
+
+	/** Hash of a string literal, usable as a case label. */
+	template<int32 N>
+	constexpr uint32 ReducerNameHash(const TCHAR (&Name)[N])
+	{
+		return ReducerNameHash(Name, N - 1);
+	}
+
+	/** Hash of a reducer name received from the server. */
+	FORCEINLINE uint32 ReducerNameHash(const FString& Name)
+	{
+		return ReducerNameHash(*Name, Name.Len());
+	}
+}
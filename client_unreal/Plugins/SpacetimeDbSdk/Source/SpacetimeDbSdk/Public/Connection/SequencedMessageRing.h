@@ -0,0 +1,101 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+/**
+ * Lock-free ring that releases items strictly in sequence order.
+ *
+ * Every item carries a sequence number assigned by the caller when the work was started.
+ * Any number of producers may publish in any order, the single consumer only ever sees
+ * the next sequence number, so items that finish early simply wait in their slot until
+ * the gap before them is filled.
+ *
+ * Each slot stores the sequence it is ready to accept (free) or that sequence plus one
+ * (published). The consumer frees a slot by advancing it a full lap, which is what lets a
+ * producer Capacity items ahead reuse it. Publishing into a slot that is not free yet fails
+ * instead of waiting, so a producer never stalls on a consumer that is waiting on it.
+ */
+template<typename T>
+class TSequencedMessageRing
+{
+public:
+	/** @param InCapacity Number of slots, rounded up to a power of two. */
+	explicit TSequencedMessageRing(uint32 InCapacity = 1024)
+	{
+		const uint32 Capacity = FMath::RoundUpToPowerOfTwo(FMath::Max<uint32>(InCapacity, 2));
+		Mask = Capacity - 1;
+		Slots = MakeUnique<FSlot[]>(Capacity);
+		for (uint32 Index = 0; Index < Capacity; ++Index)
+		{
+			Slots[Index].Sequence.store(Index, std::memory_order_relaxed);
+		}
+	}
+
+	TSequencedMessageRing(const TSequencedMessageRing&) = delete;
+	TSequencedMessageRing& operator=(const TSequencedMessageRing&) = delete;
+
+	/**
+	 * Publish the item for Sequence. Safe from any thread, never waits.
+	 * Producers must keep Sequence less than a lap (Capacity) ahead of the consumer, the slot is otherwise
+	 * still held by the item one lap behind.
+	 * @return False, leaving Item untouched, if the slot is still held or the ring was closed.
+	 */
+	bool Publish(uint64 Sequence, T&& Item)
+	{
+		FSlot& Slot = Slots[Sequence & Mask];
+		if (bClosed.load(std::memory_order_relaxed) || Slot.Sequence.load(std::memory_order_acquire) != Sequence)
+		{
+			return false;
+		}
+		Slot.Value = MoveTemp(Item);
+		Slot.Sequence.store(Sequence + 1, std::memory_order_release);
+		return true;
+	}
+
+	/** Refuse any further items. Used on shutdown when the consumer has stopped. */
+	void Close() { bClosed.store(true, std::memory_order_relaxed); }
+
+	/** True once Close was called. */
+	bool IsClosed() const { return bClosed.load(std::memory_order_relaxed); }
+
+	/** Consumer only. Take the next item in sequence if it has been published. */
+	bool TryDequeue(T& OutItem)
+	{
+		FSlot& Slot = Slots[ReadSequence & Mask];
+		if (Slot.Sequence.load(std::memory_order_acquire) != ReadSequence + 1)
+		{
+			return false;
+		}
+		OutItem = MoveTemp(Slot.Value);
+		Slot.Value = T();
+		Slot.Sequence.store(ReadSequence + Mask + 1, std::memory_order_release);
+		++ReadSequence;
+		return true;
+	}
+
+	/** Consumer only. The next item in sequence, or null if it has not been published. */
+	const T* Peek() const
+	{
+		const FSlot& Slot = Slots[ReadSequence & Mask];
+		return Slot.Sequence.load(std::memory_order_acquire) == ReadSequence + 1 ? &Slot.Value : nullptr;
+	}
+
+	/** Sequence number the consumer will release next. */
+	uint64 GetReadSequence() const { return ReadSequence; }
+
+	/** Number of slots in the ring. */
+	uint32 GetCapacity() const { return static_cast<uint32>(Mask + 1); }
+
+private:
+	struct alignas(PLATFORM_CACHE_LINE_SIZE) FSlot
+	{
+		std::atomic<uint64> Sequence{ 0 };
+		T Value;
+	};
+
+	TUniquePtr<FSlot[]> Slots;
+	uint64 Mask = 0;
+	uint64 ReadSequence = 0;
+	std::atomic<bool> bClosed{ false };
+};
@@ -23,6 +23,59 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnWebSocketClosed, int32, Status
 /** Delegate broadcast when binary data is received */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnWebSocketBinaryMessageReceived, const TArray<uint8>&, Data);
 
+/** Ref-counted buffer holding one complete binary frame. Safe to hand across threads. */
+using FWebsocketFrameBuffer = TSharedRef<TArray<uint8>, ESPMode::ThreadSafe>;
+
+/** Native delegate broadcast with the reassembled frame buffer. Listeners share ownership, nothing is copied. */
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnWebSocketBinaryFrameReceived, const FWebsocketFrameBuffer& /*Frame*/);
+
+/**
+ * Thread-safe pool of reusable frame buffers.
+ * A buffer handed out by Acquire returns to the pool when its last reference is dropped,
+ * so frames do not reallocate on every message. Buffers grown past MaxRetainedBufferBytes,
+ * such as the one of a large initial subscription, are freed instead of kept for the connection's lifetime.
+ */
+class SPACETIMEDBSDK_API FWebsocketFramePool : public TSharedFromThis<FWebsocketFramePool, ESPMode::ThreadSafe>
+{
+public:
+	~FWebsocketFramePool();
+
+	/**
+	 * Get an empty buffer with at least MinCapacity bytes reserved.
+	 * @param MinCapacity Number of bytes the caller expects to write.
+	 */
+	FWebsocketFrameBuffer Acquire(int32 MinCapacity);
+
+	/** Number of idle buffers currently held by the pool. */
+	int32 NumFree() const;
+
+private:
+	/** Return a buffer to the free list, or delete it if the pool is full or the buffer is too large to keep. */
+	void Release(TArray<uint8>* Buffer);
+
+	/** Upper bound on idle buffers kept around between frames. */
+	static constexpr int32 MaxFreeBuffers = 8;
+
+	/** Buffers with more capacity than this are freed on release rather than pooled. */
+	static constexpr SIZE_T MaxRetainedBufferBytes = 1024 * 1024;
+
+	mutable FCriticalSection Mutex;
+	TArray<TArray<uint8>*> FreeBuffers;
+};
+
+/** Copy statistics for binary frame reassembly. */
+struct FWebsocketFrameStats
+{
+	/** Size in bytes of the last completed frame. */
+	int64 LastFrameBytes = 0;
+	/** Bytes copied while building and delivering the last frame, including the socket ingest copy. */
+	int64 LastFrameBytesCopied = 0;
+	/** Number of complete frames received. */
+	int64 TotalFrames = 0;
+	/** Bytes copied across all frames. */
+	int64 TotalBytesCopied = 0;
+};
+
 
 /**
  * Manages the low-level WebSocket connection to the SpacetimeDB server.
@@ -61,7 +114,7 @@ public:
 	* @param Data The bytes to send.
 	* @return True if the message was sent successfully, false otherwise.
 	*/
-	bool SendMessage(const TArray<uint8>& Data);
+	bool SendMessage(TArrayView<const uint8> Data);
 
 	/**
 	 * Checks if the WebSocket connection is currently active.
@@ -87,10 +140,27 @@ public:
 	UPROPERTY()
 	FOnWebSocketMessageReceived OnMessageReceived;
 
-	/** Broadcast for binary payloads */
+	/** Broadcast for binary payloads. Each bound listener costs a copy of the frame, prefer OnBinaryFrameReceived. */
 	UPROPERTY()
 	FOnWebSocketBinaryMessageReceived OnBinaryMessageReceived;
 
+	/** Broadcast for binary payloads with shared ownership of the pooled frame buffer */
+	FOnWebSocketBinaryFrameReceived OnBinaryFrameReceived;
+
+	/** Copy statistics for received binary frames. */
+	const FWebsocketFrameStats& GetFrameStats() const { return FrameStats; }
+
+	/**
+	 * Record every received binary frame to a file, as an int32 length followed by the raw frame bytes.
+	 * Recordings can be replayed by the compression benchmarks.
+	 * @param FilePath File to write, replaced if it exists.
+	 * @return True if the file was opened.
+	 */
+	bool StartFrameCapture(const FString& FilePath);
+
+	/** Stop recording frames and close the capture file. */
+	void StopFrameCapture();
+
 	/** Broadcast when the socket is closed */
 	UPROPERTY()
 	FOnWebSocketClosed OnClosed;
@@ -119,13 +189,28 @@ private:
 
 	FString InitToken;
 
+	/** Pool the frame buffers are drawn from. */
+	TSharedRef<FWebsocketFramePool, ESPMode::ThreadSafe> FramePool = MakeShared<FWebsocketFramePool, ESPMode::ThreadSafe>();
+
 	/** Buffer used to accumulate binary fragments until a complete message
 	*  is received. */
-	TArray<uint8> IncompleteMessage;
+	TSharedPtr<TArray<uint8>, ESPMode::ThreadSafe> IncompleteMessage;
+
+	/** Bytes copied so far for the frame being assembled. */
+	int64 IncompleteMessageBytesCopied = 0;
+
+	/** Copy statistics for completed frames. */
+	FWebsocketFrameStats FrameStats;
+
+	/** Open capture file while frames are being recorded. */
+	TUniquePtr<FArchive> FrameCapture;
 
 	/** Tracks if we are waiting for additional binary fragments. */
 	bool bAwaitingBinaryFragments = false;
 
+	/** Set while the remaining fragments of an oversized frame are being dropped. */
+	bool bDiscardingBinaryFrame = false;
+
 };
 
 // Helper function to log a struct as JSON, expanding any transient objects
@@ -1,77 +1,359 @@
 ﻿
 #pragma once
-#include <map>
+#include "Algo/Sort.h"
+#include "Templates/IntegerSequence.h"
+#include "Templates/Tuple.h"
 #include "IUniqueIndex.h"
 
-// A multi-key index implementation that maps a key to one or more serialized row identifiers.
+namespace UE::SpacetimeDB::IndexOrder
+{
+    template<typename... LhsTypes, typename... RhsTypes>
+    int32 Compare(const TTuple<LhsTypes...>& A, const TTuple<RhsTypes...>& B);
+
+    // Three way comparison of two key values through operator<.
+    template<typename LhsType, typename RhsType>
+    FORCEINLINE int32 Compare(const LhsType& A, const RhsType& B)
+    {
+        return A < B ? -1 : (B < A ? 1 : 0);
+    }
+
+    // Compares the leading elements of Key with every element of Prefix, stopping at the first difference.
+    template<typename KeyType, typename PrefixType, uint32... Indices>
+    FORCEINLINE int32 ComparePrefix(const KeyType& Key, const PrefixType& Prefix, TIntegerSequence<uint32, Indices...>)
+    {
+        int32 Result = 0;
+        ((Result = Result != 0 ? Result : Compare(Key.template Get<Indices>(), Prefix.template Get<Indices>())), ...);
+        return Result;
+    }
+
+    template<typename... KeyTypes, typename... PrefixTypes>
+    FORCEINLINE int32 ComparePrefix(const TTuple<KeyTypes...>& Key, const TTuple<PrefixTypes...>& Prefix)
+    {
+        static_assert(sizeof...(PrefixTypes) <= sizeof...(KeyTypes), "Prefix has more elements than the index key");
+        return ComparePrefix(Key, Prefix, TMakeIntegerSequence<uint32, sizeof...(PrefixTypes)>());
+    }
+
+    // Tuple keys are ordered lexicographically, element by element.
+    template<typename... LhsTypes, typename... RhsTypes>
+    FORCEINLINE int32 Compare(const TTuple<LhsTypes...>& A, const TTuple<RhsTypes...>& B)
+    {
+        static_assert(sizeof...(LhsTypes) == sizeof...(RhsTypes), "Compared tuple keys have different lengths");
+        return ComparePrefix(A, B);
+    }
+}
+
+// An ordered multi-key index that maps a key to one or more cached rows.
 // This is typically used for non-unique indexing (one key → many rows) in the client table cache.
+//
+// Rows are kept in one flat array sorted by key, so a lookup is a binary search and every key range,
+// or every tuple key starting with a given prefix, is a contiguous slice of the array.
+// Row changes are buffered while a diff is applied and merged into the array once, by Commit.
 template<typename RowType, typename KeyType>
 class FMultiKeyBTreeIndex : public IMultiKeyIndex<RowType>
 {
 public:
+    // One indexed row: its extracted key and the row instance owned by the table cache.
+    struct FEntry
+    {
+        KeyType Key;
+        TSharedPtr<RowType> Row;
+    };
+
     // Function that extracts the index key from a row instance.
     // For example, given a FMessage row, it might return Msg.Sender or a tuple of fields.
     TFunction<KeyType(const RowType&)> ExtractKey;
 
-    // Maps a key to one or more serialized primary keys (TArray<uint8>) for rows that match.
-    // The serialized keys can then be used to retrieve full rows from the table cache.
-    TMultiMap<KeyType, TArray<uint8>> KeyToSerialized;
+    // Optional order of the rows sharing a key, for example by primary key.
+    // Without it those rows are kept in an arbitrary order.
+    TFunction<bool(const RowType&, const RowType&)> OrderWithinKey;
 
-    // Temporary buffer to store found keys during a query.
-    // Mutable so that FindKeys (which is const) can reuse this array without reallocating each time.
-    mutable TArray<TArray<uint8>> MutableFoundKeys;
+    // Every indexed row, sorted by key, then by OrderWithinKey.
+    TArray<FEntry> SortedEntries;
 
-    // Constructor — stores the key extraction function.
-    explicit FMultiKeyBTreeIndex(TFunction<KeyType(const RowType&)> InExtractKey)
+    // Constructor — stores the key extraction function and the order of rows sharing a key.
+    explicit FMultiKeyBTreeIndex(TFunction<KeyType(const RowType&)> InExtractKey, TFunction<bool(const RowType&, const RowType&)> InOrderWithinKey = nullptr)
         : ExtractKey(InExtractKey)
+        , OrderWithinKey(InOrderWithinKey)
     {
     }
 
     /**
-     * Adds a row to the multi-key index by mapping its extracted key to the serialized primary key.
+     * Queues a row to be added to the index by the next Commit.
      *
-     * @param SerializedKey  Serialized representation of the row's primary key.
-     * @param Row            Shared pointer to the row being added.
+     * @param Row  Shared pointer to the row being added.
      */
-    virtual void AddRow(const TArray<uint8>& SerializedKey, const TSharedPtr<RowType>& Row) override
+    virtual void AddRow(const TSharedPtr<RowType>& Row) override
     {
-        // Extract the key from the row and add an entry mapping it to the serialized key.
-        KeyToSerialized.Add(ExtractKey(*Row), SerializedKey);
+        PendingAdds.Add(FEntry{ ExtractKey(*Row), Row });
     }
 
 
     /**
-     * Removes a single mapping from the multi-key index matching the extracted key and serialized key.
+     * Queues the entry of this exact row handle to be removed from the index by the next Commit.
      *
-     * @param SerializedKey  Serialized representation of the row's primary key.
-     * @param Row            Shared pointer to the row being removed.
+     * @param Row  Shared pointer to the row being removed.
+     */
+    virtual void RemoveRow(const TSharedPtr<RowType>& Row) override
+    {
+        PendingRemoves.Add(FEntry{ ExtractKey(*Row), Row });
+    }
+
+
+    /**
+     * Applies the queued changes to the sorted entries.
+     * Rows replaced by a row with the same key, the common case of an update, are swapped in place.
+     * Any other change is merged in a single pass over the entries.
      */
-    virtual void RemoveRow(const TArray<uint8>& SerializedKey, const TSharedPtr<RowType>& Row) override
+    virtual void Commit() override
     {
-        // Remove one occurrence of the pair (extracted key, serialized key) from the index.
-        KeyToSerialized.RemoveSingle(ExtractKey(*Row), SerializedKey);
+        if (PendingAdds.IsEmpty() && PendingRemoves.IsEmpty())
+        {
+            return;
+        }
+
+        const auto ByEntryOrder = [this](const FEntry& A, const FEntry& B) { return Less(A, B); };
+        Algo::Sort(PendingAdds, ByEntryOrder);
+        Algo::Sort(PendingRemoves, ByEntryOrder);
+        CancelPendingPairs();
+
+        const int32 Replaced = ReplaceInPlace();
+        if (Replaced < PendingAdds.Num() || Replaced < PendingRemoves.Num())
+        {
+            MergePending(Replaced);
+        }
+
+        PendingAdds.Reset();
+        PendingRemoves.Reset();
     }
 
 
     /**
-     * Finds all serialized keys associated with the given index key.
+     * Finds all rows associated with the given index key, in index order.
      *
      * @param KeyPtr  Pointer to the key value (type-erased as void*).
-     * @return        Pointer to an array of serialized keys matching the given key.
+     * @return        Range over the handles of the contiguous run of entries holding the key.
      */
-    virtual const TArray<TArray<uint8>>* FindKeys(const void* KeyPtr) const override
+    virtual FIndexRowRange<RowType> FindRows(const void* KeyPtr) const override
     {
         // Cast the void pointer back to the actual key type.
         const KeyType* TypedKey = static_cast<const KeyType*>(KeyPtr);
+        return RowsOf(EqualRange(*TypedKey));
+    }
 
-        // Clear the temporary array to store matching keys.
-        MutableFoundKeys.Reset();
+    /** Row handles of a run of entries, read in place */
+    static FIndexRowRange<RowType> RowsOf(TArrayView<const FEntry> Entries)
+    {
+        return Entries.Num() > 0
+            ? FIndexRowRange<RowType>(&Entries[0].Row, Entries.Num(), sizeof(FEntry))
+            : FIndexRowRange<RowType>();
+    }
+
+    /** Position of the first entry whose key is not less than Key */
+    int32 LowerBound(const KeyType& Key) const
+    {
+        return PartitionPoint([&Key](const FEntry& Entry) { return UE::SpacetimeDB::IndexOrder::Compare(Entry.Key, Key) < 0; });
+    }
 
-        // Retrieve all serialized keys mapped to the given index key.
-        KeyToSerialized.MultiFind(*TypedKey, MutableFoundKeys);
+    /** Position of the first entry whose key is greater than Key */
+    int32 UpperBound(const KeyType& Key) const
+    {
+        return PartitionPoint([&Key](const FEntry& Entry) { return UE::SpacetimeDB::IndexOrder::Compare(Entry.Key, Key) <= 0; });
+    }
 
-        // Return the pointer to the results array owned by this object.
-        return &MutableFoundKeys;
+    /** Entries whose key is in [Lower, Upper), in index order */
+    TArrayView<const FEntry> Range(const KeyType& Lower, const KeyType& Upper) const
+    {
+        const int32 First = LowerBound(Lower);
+        return Slice(First, FMath::Max(First, LowerBound(Upper)));
     }
 
+    /** Entries whose key equals Key, in index order */
+    TArrayView<const FEntry> EqualRange(const KeyType& Key) const
+    {
+        return Slice(LowerBound(Key), UpperBound(Key));
+    }
+
+    /**
+     * Entries of a tuple keyed index whose leading key elements equal Prefix,
+     * ordered by the remaining key elements.
+     */
+    template<typename PrefixType>
+    TArrayView<const FEntry> PrefixRange(const PrefixType& Prefix) const
+    {
+        using UE::SpacetimeDB::IndexOrder::ComparePrefix;
+        const int32 First = PartitionPoint([&Prefix](const FEntry& Entry) { return ComparePrefix(Entry.Key, Prefix) < 0; });
+        const int32 Last = PartitionPoint([&Prefix](const FEntry& Entry) { return ComparePrefix(Entry.Key, Prefix) <= 0; });
+        return Slice(First, Last);
+    }
+
+private:
+    // Changes queued since the last Commit.
+    TArray<FEntry> PendingAdds;
+    TArray<FEntry> PendingRemoves;
+
+    // Destination of the merge, swapped with SortedEntries so both keep their allocation between commits.
+    TArray<FEntry> MergeScratch;
+
+    // Entry order: key, then OrderWithinKey, then row address so that every entry has a distinct position.
+    bool Less(const FEntry& A, const FEntry& B) const
+    {
+        const int32 KeyOrder = UE::SpacetimeDB::IndexOrder::Compare(A.Key, B.Key);
+        if (KeyOrder != 0)
+        {
+            return KeyOrder < 0;
+        }
+        if (OrderWithinKey)
+        {
+            if (OrderWithinKey(*A.Row, *B.Row))
+            {
+                return true;
+            }
+            if (OrderWithinKey(*B.Row, *A.Row))
+            {
+                return false;
+            }
+        }
+        return UPTRINT(A.Row.Get()) < UPTRINT(B.Row.Get());
+    }
+
+    // Number of leading entries for which IsBefore holds, IsBefore must be true for a prefix of the entries only.
+    template<typename PredicateType>
+    int32 PartitionPoint(PredicateType IsBefore) const
+    {
+        int32 First = 0;
+        int32 Count = SortedEntries.Num();
+        while (Count > 0)
+        {
+            const int32 Step = Count / 2;
+            if (IsBefore(SortedEntries[First + Step]))
+            {
+                First += Step + 1;
+                Count -= Step + 1;
+            }
+            else
+            {
+                Count = Step;
+            }
+        }
+        return First;
+    }
+
+    TArrayView<const FEntry> Slice(int32 First, int32 Last) const
+    {
+        return TArrayView<const FEntry>(SortedEntries.GetData() + First, Last - First);
+    }
+
+    // Position of the entry holding the row of Pending, or INDEX_NONE.
+    int32 FindEntry(const FEntry& Pending) const
+    {
+        const int32 Index = PartitionPoint([this, &Pending](const FEntry& Entry) { return Less(Entry, Pending); });
+        return Index < SortedEntries.Num() && SortedEntries[Index].Row == Pending.Row ? Index : INDEX_NONE;
+    }
+
+    // Drops the rows that were both added and removed since the last commit, both queues are sorted.
+    void CancelPendingPairs()
+    {
+        if (PendingAdds.IsEmpty() || PendingRemoves.IsEmpty())
+        {
+            return;
+        }
+
+        int32 Add = 0, Remove = 0, KeptAdds = 0, KeptRemoves = 0;
+        const auto Keep = [](TArray<FEntry>& Queue, int32& Kept, int32& Index)
+        {
+            if (Kept != Index)
+            {
+                Queue[Kept] = MoveTemp(Queue[Index]);
+            }
+            ++Kept;
+            ++Index;
+        };
+        while (Add < PendingAdds.Num() && Remove < PendingRemoves.Num())
+        {
+            if (PendingAdds[Add].Row == PendingRemoves[Remove].Row)
+            {
+                ++Add;
+                ++Remove;
+            }
+            else if (Less(PendingAdds[Add], PendingRemoves[Remove]))
+            {
+                Keep(PendingAdds, KeptAdds, Add);
+            }
+            else
+            {
+                Keep(PendingRemoves, KeptRemoves, Remove);
+            }
+        }
+        while (Add < PendingAdds.Num())
+        {
+            Keep(PendingAdds, KeptAdds, Add);
+        }
+        while (Remove < PendingRemoves.Num())
+        {
+            Keep(PendingRemoves, KeptRemoves, Remove);
+        }
+        PendingAdds.SetNum(KeptAdds, EAllowShrinking::No);
+        PendingRemoves.SetNum(KeptRemoves, EAllowShrinking::No);
+    }
+
+    // Swaps removed rows for added rows with the same key where the entry keeps its position.
+    // Returns the number of leading queued pairs handled.
+    int32 ReplaceInPlace()
+    {
+        const int32 Pairs = FMath::Min(PendingAdds.Num(), PendingRemoves.Num());
+        int32 Replaced = 0;
+        for (; Replaced < Pairs; ++Replaced)
+        {
+            FEntry& Added = PendingAdds[Replaced];
+            const FEntry& Removed = PendingRemoves[Replaced];
+            if (UE::SpacetimeDB::IndexOrder::Compare(Added.Key, Removed.Key) != 0)
+            {
+                break;
+            }
+            const int32 Index = FindEntry(Removed);
+            if (Index == INDEX_NONE
+                || (Index > 0 && !Less(SortedEntries[Index - 1], Added))
+                || (Index + 1 < SortedEntries.Num() && !Less(Added, SortedEntries[Index + 1])))
+            {
+                break;
+            }
+            SortedEntries[Index].Row = MoveTemp(Added.Row);
+        }
+        return Replaced;
+    }
+
+    // Rebuilds the sorted entries without the queued removals and with the queued additions, starting at First in both queues.
+    void MergePending(int32 First)
+    {
+        MergeScratch.Reset();
+        MergeScratch.Reserve(SortedEntries.Num() + PendingAdds.Num() - First);
+
+        int32 Add = First;
+        int32 Remove = First;
+        for (FEntry& Entry : SortedEntries)
+        {
+            // Skip removals of rows that are not indexed
+            while (Remove < PendingRemoves.Num() && Less(PendingRemoves[Remove], Entry))
+            {
+                ++Remove;
+            }
+            if (Remove < PendingRemoves.Num() && PendingRemoves[Remove].Row == Entry.Row)
+            {
+                ++Remove;
+                continue;
+            }
+            while (Add < PendingAdds.Num() && Less(PendingAdds[Add], Entry))
+            {
+                MergeScratch.Add(MoveTemp(PendingAdds[Add++]));
+            }
+            MergeScratch.Add(MoveTemp(Entry));
+        }
+        while (Add < PendingAdds.Num())
+        {
+            MergeScratch.Add(MoveTemp(PendingAdds[Add++]));
+        }
+
+        Swap(SortedEntries, MergeScratch);
+        MergeScratch.Reset();
+    }
 };
\ No newline at end of file
@@ -2,6 +2,7 @@
 #include "CoreMinimal.h"
 #include "TableCache.h"
 #include "TableAppliedDiff.h"
+#include "WithBsatn.h"
 
 /* ============================================================================ *
  *  ClientCache.h (2025-05-28)
@@ -74,11 +75,19 @@ public:
      *  Apply Inserts + Deletes to the specified table.
      *  Inserts: increment refCount, add new entry when needed.
      *  Deletes: decrement refCount, remove when it reaches 0.
+     *  A delete and insert under the same key replace the row in place and are reported as an update pair.
+     *  Rows are looked up by a view of their BSATN bytes and the hash computed when they were decoded,
+     *  an owned key is only built when it is stored.
+     *
+     *  Each live row exists once: the entry, the indices and the returned diff share the same instance.
+     *  Insert rows are moved out of Inserts into that instance.
+     *  When the table reads through snapshots the indices are left to the game thread, which updates them
+     *  once the published version becomes visible.
      */
     FTableAppliedDiff<RowType> ApplyDiff(
         const FString& Name,
-        const TArray<TPair<TArray<uint8>, RowType>>& Inserts,
-        const TArray<TArray<uint8>>& Deletes)
+        TArray<FWithBsatn<RowType>>&& Inserts,
+        const TArray<FWithBsatn<RowType>>& Deletes)
     {
         if (Name.IsEmpty())
         {
@@ -93,90 +102,133 @@ public:
         }
 
         FTableAppliedDiff<RowType> Diff;
+        bUpdateIndices = !Table->ReadsThroughSnapshots();
 
-        // Map of deleted SerializedBytes -> (Key, Row)
-        // The key type is now generic TArray<uint8>
-        TMap<TArray<uint8>, TPair<TArray<uint8>, TSharedPtr<RowType>>> DeletedEntries;
+        // Entries whose refcount dropped to zero, the key views borrow the bytes of Deletes
+        TArray<TPair<FRowBytesView, TSharedPtr<RowType>>> DeletedEntries;
 
-        // Phase 1: Pre-process Deletes
-        for (const TArray<uint8>& Key : Deletes)
+        // Phase 1: Pre-process Deletes, rows leaving the cache leave the indices right away
+        for (const FWithBsatn<RowType>& Delete : Deletes)
         {
-
-            FRowEntry<RowType>* Entry = Table->Entries.Find(Key);
+            const FRowBytesView Key = Delete.GetKey();
+            FRowEntry<RowType>* Entry = Table->Entries.FindByHash(Key.Hash, Key);
             if (!Entry) continue;
 
             // Decrement refcount and store the entry if it's about to be deleted
             if (--Entry->RefCount == 0)
             {
-                DeletedEntries.Add(Key, TPair<TArray<uint8>, TSharedPtr<RowType>>(Key, Entry->Row));
+                RemoveFromIndices(Entry->Row, Key.Hash);
+                DeletedEntries.Emplace(Key, Entry->Row);
             }
         }
 
-        // Phase 2: Process Inserts and Updates
-        for (const auto& Ins : Inserts)
+        // Phase 2: Process Inserts and Updates, after every removal so a unique value moving between rows is kept
+        for (FWithBsatn<RowType>& Ins : Inserts)
         {
-            const TArray<uint8>& Key = Ins.Key;
-            const RowType& Row = Ins.Value;
+            const FRowBytesView Key = Ins.GetKey();
 
-            TSharedPtr<RowType> NewRow = MakeShared<RowType>(Row);
+            FRowEntry<RowType>* Entry = Table->Entries.FindByHash(Key.Hash, Key);
+            if (Entry && Entry->bReplacedInDiff)
+            {
+                // Inserted again by an overlapping subscription, the update pair is already reported
+                ++Entry->RefCount;
+                continue;
+            }
 
-            // This is a new row or an update to an existing row that was not deleted.
-            FRowEntry<RowType>* Entry = Table->Entries.Find(Key);
+            TSharedPtr<RowType> NewRow = MakeShared<RowType>(MoveTemp(Ins.Row));
             if (!Entry)
             {
                 // True insert
-                Table->Entries.Add(Key, FRowEntry<RowType>{NewRow, 1});
+                Table->Entries.Add(FRowKey(Key), FRowEntry<RowType>{NewRow, 1});
+                Diff.Inserts.Add(FRowKey(Key), NewRow);
+            }
+            else if (Entry->RefCount == 0)
+            {
+                // Deleted above and inserted again under the same key, which for primary keyed
+                // tables is an update: replace the row in place instead of removing the entry
+                Diff.UpdateDeletes.Add(Entry->Row);
+                Diff.UpdateInserts.Add(NewRow);
+                Entry->Row = NewRow;
+                Entry->RefCount = 1;
+                Entry->bReplacedInDiff = true;
             }
             else
             {
-                // True update
-                Table->Entries.Add(Key, FRowEntry<RowType>{NewRow, Entry->RefCount + 1});
+                // Already cached through another subscription
+                RemoveFromIndices(Entry->Row, Key.Hash);
+                Entry->Row = NewRow;
+                ++Entry->RefCount;
+                Diff.Inserts.Add(FRowKey(Key), NewRow);
             }
-
-            Diff.Inserts.Add(Key, *NewRow);
-        }
-
-        // Phase 3: Finalize Deletes and Update Indices
-        for (const auto& KeyValue : DeletedEntries)
-        {
-            // Add to diff before removal
-            Diff.Deletes.Add(KeyValue.Key, *KeyValue.Value.Value);
-            Table->Entries.Remove(KeyValue.Key);
+            AddToIndices(NewRow, Key.Hash);
         }
+        CommitIndices();
 
-        // Now, update all indices with the completed diff
-        for (const auto& DeletePair : Diff.Deletes)
+        // Phase 3: Finalize Deletes that were not replaced
+        for (const TPair<FRowBytesView, TSharedPtr<RowType>>& Deleted : DeletedEntries)
         {
-            for (auto& IndexPair : Table->UniqueIndices)
+            FRowEntry<RowType>* Entry = Table->Entries.FindByHash(Deleted.Key.Hash, Deleted.Key);
+            if (!Entry)
+            {
+                continue;
+            }
+            if (Entry->RefCount == 0)
+            {
+                // The diff keeps the row alive after the entry is gone
+                Diff.Deletes.Add(FRowKey(Deleted.Key), Deleted.Value);
+                Table->Entries.RemoveByHash(Deleted.Key.Hash, Deleted.Key);
+            }
+            else
             {
-                // Assuming RemoveRow takes the TSharedPtr<RowType> directly
-                IndexPair.Value->RemoveRow(MakeShared<RowType>(DeletePair.Value));
+                Entry->bReplacedInDiff = false;
             }
         }
 
-        for (const auto& InsertPair : Diff.Inserts)
+        // Readers pinning a snapshot see the whole diff or none of it
+        if (Table->SnapshotPublisher.IsValid())
         {
-            for (auto& IndexPair : Table->UniqueIndices)
-            {
-                // Assuming AddRow takes TSharedPtr<RowType> directly
-                IndexPair.Value->AddRow(MakeShared<RowType>(InsertPair.Value));
-            }
+            Table->SnapshotPublisher->Publish();
         }
 
-        // And for BtreeIndices...
-        for (auto& Pair : Table->BTreeIndices)
+        return Diff;
+    }
+
+private:
+    /** Add the cached row instance to every index of the table, KeyHash is the hash of its cache key */
+    void AddToIndices(const TSharedPtr<RowType>& Row, uint32 KeyHash)
+    {
+        if (bUpdateIndices)
         {
-            for (const auto& DeletePair : Diff.Deletes)
-            {
-                Pair.Value->RemoveRow(DeletePair.Key, MakeShared<RowType>(DeletePair.Value));
-            }
+            Table->AddRowToIndices(Row);
+        }
+        if (Table->SnapshotPublisher.IsValid())
+        {
+            Table->SnapshotPublisher->AddRow(KeyHash, Row);
+        }
+    }
 
-            for (const auto& InsertPair : Diff.Inserts)
-            {
-                Pair.Value->AddRow(InsertPair.Key, MakeShared<RowType>(InsertPair.Value));
-            }
+    /** Apply the index changes buffered while the diff was processed */
+    void CommitIndices()
+    {
+        if (bUpdateIndices)
+        {
+            Table->CommitIndices();
         }
+    }
 
-        return Diff;
+    /** Remove the cached row instance from every index of the table */
+    void RemoveFromIndices(const TSharedPtr<RowType>& Row, uint32 KeyHash)
+    {
+        if (bUpdateIndices)
+        {
+            Table->RemoveRowFromIndices(Row);
+        }
+        if (Table->SnapshotPublisher.IsValid())
+        {
+            Table->SnapshotPublisher->RemoveRow(KeyHash, Row);
+        }
     }
+
+    /** False while ApplyDiff runs for a table whose indices follow the visible snapshot */
+    bool bUpdateIndices = true;
 };
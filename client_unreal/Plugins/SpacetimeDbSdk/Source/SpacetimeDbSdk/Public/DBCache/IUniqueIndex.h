@@ -1,4 +1,5 @@
 #pragma once
+#include "WithBsatn.h"
 /* ============================================================================ *
  *  IUniqueIndex.h (2025-05-28)
  *  ----------------------------------------------------------------------------
@@ -21,7 +22,7 @@ public:
      *
      * @param Row  Shared pointer to the row being added.
      */
-    virtual void AddRow(TSharedPtr<RowType> Row) = 0;
+    virtual void AddRow(const TSharedPtr<RowType>& Row) = 0;
 
     /**
      * Removes a row from the index.
@@ -29,7 +30,7 @@ public:
      *
      * @param Row  Shared pointer to the row being removed.
      */
-    virtual void RemoveRow(TSharedPtr<RowType> Row) = 0;
+    virtual void RemoveRow(const TSharedPtr<RowType>& Row) = 0;
 
     /**
      * Finds a single row by the given key pointer.
@@ -41,6 +42,55 @@ public:
 
 };
 
+/**
+ * Read-only range over row handles stored inside an index, returned by lookups instead of a copy.
+ * The handles are read in place, one every Stride bytes, so a lookup allocates nothing and shares no
+ * scratch state: any number of threads may query the same index concurrently.
+ * A range stays valid until the next diff is applied to the table.
+ */
+template<typename RowType>
+class FIndexRowRange
+{
+public:
+    class FIterator
+    {
+    public:
+        FIterator(const uint8* InPtr, int32 InStride) : Ptr(InPtr), Stride(InStride) {}
+
+        const TSharedPtr<RowType>& operator*() const { return *reinterpret_cast<const TSharedPtr<RowType>*>(Ptr); }
+        FIterator& operator++() { Ptr += Stride; return *this; }
+        bool operator!=(const FIterator& Other) const { return Ptr != Other.Ptr; }
+
+    private:
+        const uint8* Ptr;
+        int32 Stride;
+    };
+
+    FIndexRowRange() = default;
+
+    /** Num handles starting at First, each Stride bytes after the previous one */
+    FIndexRowRange(const TSharedPtr<RowType>* First, int32 InNum, int32 InStride)
+        : Data(reinterpret_cast<const uint8*>(First)), Num(InNum), Stride(InStride) {
+    }
+
+    int32 Len() const { return Num; }
+    bool IsEmpty() const { return Num == 0; }
+
+    const TSharedPtr<RowType>& operator[](int32 Index) const
+    {
+        check(Index >= 0 && Index < Num);
+        return *reinterpret_cast<const TSharedPtr<RowType>*>(Data + SIZE_T(Index) * Stride);
+    }
+
+    FIterator begin() const { return FIterator(Data, Stride); }
+    FIterator end() const { return FIterator(Data + SIZE_T(Num) * Stride, Stride); }
+
+private:
+    const uint8* Data = nullptr;
+    int32 Num = 0;
+    int32 Stride = 0;
+};
+
 template<typename RowType>
 class IMultiKeyIndex
 {
@@ -48,30 +98,35 @@ public:
     virtual ~IMultiKeyIndex() = default;
 
     /**
-     * Adds a row to the index using its serialized key and the row's data.
-     * Implementations should map the extracted key to the serialized representation.
+     * Adds a row to the index.
+     * Implementations should map the extracted key to the row handle, which is the instance owned by the cache.
      *
-     * @param SerializedKey  Binary key representing the row in serialized form.
-     * @param Row            Shared pointer to the row being added.
+     * @param Row  Shared pointer to the row being added.
      */
-    virtual void AddRow(const TArray<uint8>& SerializedKey, const TSharedPtr<RowType>& Row) = 0;
+    virtual void AddRow(const TSharedPtr<RowType>& Row) = 0;
 
     /**
-     * Removes a row from the index using its serialized key and the row's data.
-     * Implementations should ensure the mapping is cleaned up.
+     * Removes a row from the index.
+     * Implementations should remove the mapping of the extracted key to this exact row handle.
      *
-     * @param SerializedKey  Binary key representing the row in serialized form.
-     * @param Row            Shared pointer to the row being removed.
+     * @param Row  Shared pointer to the row being removed.
+     */
+    virtual void RemoveRow(const TSharedPtr<RowType>& Row) = 0;
+
+    /**
+     * Applies the rows added and removed since the last call.
+     * Called once at the end of every applied diff, implementations may buffer AddRow and RemoveRow until then.
      */
-    virtual void RemoveRow(const TArray<uint8>& SerializedKey, const TSharedPtr<RowType>& Row) = 0;
+    virtual void Commit() = 0;
 
     /**
-     * Finds all serialized keys that match the given key pointer.
+     * Finds all rows that match the given key pointer.
+     * Must not modify the index, lookups may run on several threads at once.
      *
      * @param KeyPtr  Pointer to the key value (cast to the correct key type inside the function).
-     * @return        Pointer to an array of serialized keys that match, or nullptr if none found.
+     * @return        Range over the handles of the matching rows, empty if none found.
      */
-    virtual const TArray<TArray<uint8>>* FindKeys(const void* KeyPtr) const = 0;
+    virtual FIndexRowRange<RowType> FindRows(const void* KeyPtr) const = 0;
 
 };
 
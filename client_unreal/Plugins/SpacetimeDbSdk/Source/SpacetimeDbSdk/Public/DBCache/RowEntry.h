@@ -36,6 +36,9 @@ struct FRowEntry
     /** Reference count for this row */
     int32 RefCount = 0;
 
+    /** Set while ApplyDiff runs once the row was replaced in place, later inserts of the same key only add a reference */
+    bool bReplacedInDiff = false;
+
     FRowEntry(const TSharedPtr<RowType>& InRow, int32 InRefCount)
         : Row(InRow), RefCount(InRefCount)
     {
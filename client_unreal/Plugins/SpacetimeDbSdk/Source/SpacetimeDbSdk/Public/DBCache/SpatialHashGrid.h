@@ -0,0 +1,288 @@
+#pragma once
+#include "CoreMinimal.h"
+
+/* ============================================================================ *
+ *  SpatialHashGrid.h
+ *  ----------------------------------------------------------------------------
+ *  Uniform hash grid over the positions of cached rows.
+ *
+ *  • Cells are vertical columns of CellSize x CellSize over the XY plane, keyed
+ *    in a hash map so only occupied cells use memory. Distances are 3D.
+ *  • Each cell stores the row handles with their positions, queries never call
+ *    back into the row to read a position.
+ *  • Maintained by UClientCache::ApplyDiff together with the other indices.
+ * ============================================================================ */
+
+/** Position of any transform struct with X, Y and Z members, such as the generated FTransformType */
+template<typename TransformType>
+FORCEINLINE FVector GetTransformLocation(const TransformType& Transform)
+{
+    return FVector(Transform.X, Transform.Y, Transform.Z);
+}
+
+template<typename RowType>
+class FSpatialHashGrid
+{
+public:
+    /** One row in a cell: its position when it was added and the row instance owned by the table cache */
+    struct FCellEntry
+    {
+        FVector Position;
+        TSharedPtr<RowType> Row;
+    };
+
+    /** Function that extracts the position of a row */
+    TFunction<FVector(const RowType&)> ExtractPosition;
+
+    /** Occupied cells by XY cell coordinate. A cell is removed when its last row leaves */
+    TMap<FIntPoint, TArray<FCellEntry>> Cells;
+
+    FSpatialHashGrid(float InCellSize, TFunction<FVector(const RowType&)> InExtractPosition)
+        : ExtractPosition(MoveTemp(InExtractPosition))
+        , CellSize(FMath::Max(InCellSize, UE_KINDA_SMALL_NUMBER))
+        , InvCellSize(1.0 / CellSize)
+    {
+    }
+
+    /** Adds the row at the position extracted from it */
+    void AddRow(const TSharedPtr<RowType>& Row)
+    {
+        const FVector Position = ExtractPosition(*Row);
+        const FIntPoint Cell = CellOf(Position);
+        Cells.FindOrAdd(Cell).Add(FCellEntry{ Position, Row });
+        MinCell = FIntPoint(FMath::Min(MinCell.X, Cell.X), FMath::Min(MinCell.Y, Cell.Y));
+        MaxCell = FIntPoint(FMath::Max(MaxCell.X, Cell.X), FMath::Max(MaxCell.Y, Cell.Y));
+        ++Num;
+    }
+
+    /** Removes this exact row handle. Rows are immutable, so it is found in the cell it was added to */
+    void RemoveRow(const TSharedPtr<RowType>& Row)
+    {
+        const FIntPoint Cell = CellOf(ExtractPosition(*Row));
+        TArray<FCellEntry>* Entries = Cells.Find(Cell);
+        if (!Entries)
+        {
+            return;
+        }
+        const int32 Index = Entries->IndexOfByPredicate([&Row](const FCellEntry& Entry) { return Entry.Row == Row; });
+        if (Index == INDEX_NONE)
+        {
+            return;
+        }
+        Entries->RemoveAtSwap(Index, 1, EAllowShrinking::No);
+        --Num;
+
+        if (Entries->IsEmpty())
+        {
+            Cells.Remove(Cell);
+            // Only a cell on the edge of the bounds can shrink them
+            if (Cell.X == MinCell.X || Cell.X == MaxCell.X || Cell.Y == MinCell.Y || Cell.Y == MaxCell.Y)
+            {
+                RecomputeBounds();
+            }
+        }
+    }
+
+    /** Number of rows in the grid */
+    int32 NumRows() const { return Num; }
+
+    float GetCellSize() const { return CellSize; }
+
+    /** Calls Visit for every row within Radius of Center, with its squared distance, in no particular order */
+    void ForEachInRadius(const FVector& Center, float Radius, TFunctionRef<void(const TSharedPtr<RowType>&, double)> Visit) const
+    {
+        const double RadiusSquared = double(Radius) * Radius;
+        ForEachCellInBox(
+            CellOf(Center - FVector(Radius, Radius, 0.0)),
+            CellOf(Center + FVector(Radius, Radius, 0.0)),
+            [&](const TArray<FCellEntry>& Entries)
+            {
+                for (const FCellEntry& Entry : Entries)
+                {
+                    const double DistanceSquared = FVector::DistSquared(Entry.Position, Center);
+                    if (DistanceSquared <= RadiusSquared)
+                    {
+                        Visit(Entry.Row, DistanceSquared);
+                    }
+                }
+            });
+    }
+
+    /** Handles of the rows within Radius of Center, in no particular order */
+    void FindInRadius(const FVector& Center, float Radius, TArray<TSharedPtr<RowType>>& OutRows) const
+    {
+        OutRows.Reset();
+        ForEachInRadius(Center, Radius, [&OutRows](const TSharedPtr<RowType>& Row, double) { OutRows.Add(Row); });
+    }
+
+    /** Handles of the rows inside Box, in no particular order */
+    void FindInBox(const FBox& Box, TArray<TSharedPtr<RowType>>& OutRows) const
+    {
+        OutRows.Reset();
+        ForEachCellInBox(CellOf(Box.Min), CellOf(Box.Max), [&](const TArray<FCellEntry>& Entries)
+        {
+            for (const FCellEntry& Entry : Entries)
+            {
+                if (Box.IsInsideOrOn(Entry.Position))
+                {
+                    OutRows.Add(Entry.Row);
+                }
+            }
+        });
+    }
+
+    /**
+     * Handles of the Count rows nearest to Center within MaxRadius, nearest first.
+     * Visits rings of cells around the center cell until no unvisited cell can hold a nearer row.
+     */
+    void FindNearest(const FVector& Center, int32 Count, TArray<TSharedPtr<RowType>>& OutRows, float MaxRadius = UE_BIG_NUMBER) const
+    {
+        OutRows.Reset();
+        if (Count <= 0 || Num == 0)
+        {
+            return;
+        }
+
+        // Max heap on distance holding the best candidates so far
+        struct FCandidate
+        {
+            double DistanceSquared;
+            const FCellEntry* Entry;
+        };
+        const auto FarthestFirst = [](const FCandidate& A, const FCandidate& B) { return A.DistanceSquared > B.DistanceSquared; };
+        TArray<FCandidate, TInlineAllocator<32>> Best;
+
+        const double MaxRadiusSquared = double(MaxRadius) * MaxRadius;
+        const FIntPoint CenterCell = CellOf(Center);
+        const int32 MaxRing = FMath::Max(
+            FMath::Max(FMath::Abs(CenterCell.X - MinCell.X), FMath::Abs(MaxCell.X - CenterCell.X)),
+            FMath::Max(FMath::Abs(CenterCell.Y - MinCell.Y), FMath::Abs(MaxCell.Y - CenterCell.Y)));
+
+        for (int32 Ring = 0; Ring <= MaxRing; ++Ring)
+        {
+            // Rows outside rings 0..Ring-1 are at least (Ring - 1) cells plus the center's offset in its cell away,
+            // that is at least (Ring - 1) * CellSize from Center
+            const double RingDistance = double(FMath::Max(Ring - 1, 0)) * CellSize;
+            if (RingDistance * RingDistance > MaxRadiusSquared
+                || (Best.Num() == Count && RingDistance * RingDistance > Best.HeapTop().DistanceSquared))
+            {
+                break;
+            }
+
+            ForEachCellInRing(CenterCell, Ring, [&](const TArray<FCellEntry>& Entries)
+            {
+                for (const FCellEntry& Entry : Entries)
+                {
+                    const double DistanceSquared = FVector::DistSquared(Entry.Position, Center);
+                    if (DistanceSquared > MaxRadiusSquared)
+                    {
+                        continue;
+                    }
+                    if (Best.Num() < Count)
+                    {
+                        Best.HeapPush(FCandidate{ DistanceSquared, &Entry }, FarthestFirst);
+                    }
+                    else if (DistanceSquared < Best.HeapTop().DistanceSquared)
+                    {
+                        Best.HeapPopDiscard(FarthestFirst, EAllowShrinking::No);
+                        Best.HeapPush(FCandidate{ DistanceSquared, &Entry }, FarthestFirst);
+                    }
+                }
+            });
+        }
+
+        Best.Sort([](const FCandidate& A, const FCandidate& B) { return A.DistanceSquared < B.DistanceSquared; });
+        OutRows.Reserve(Best.Num());
+        for (const FCandidate& Candidate : Best)
+        {
+            OutRows.Add(Candidate.Entry->Row);
+        }
+    }
+
+private:
+    void RecomputeBounds()
+    {
+        MinCell = FIntPoint(MAX_int32, MAX_int32);
+        MaxCell = FIntPoint(MIN_int32, MIN_int32);
+        for (const TPair<FIntPoint, TArray<FCellEntry>>& Pair : Cells)
+        {
+            MinCell = FIntPoint(FMath::Min(MinCell.X, Pair.Key.X), FMath::Min(MinCell.Y, Pair.Key.Y));
+            MaxCell = FIntPoint(FMath::Max(MaxCell.X, Pair.Key.X), FMath::Max(MaxCell.Y, Pair.Key.Y));
+        }
+    }
+
+    FIntPoint CellOf(const FVector& Position) const
+    {
+        return FIntPoint(FMath::FloorToInt32(Position.X * InvCellSize), FMath::FloorToInt32(Position.Y * InvCellSize));
+    }
+
+    template<typename VisitorType>
+    void ForEachCellInBox(const FIntPoint& First, const FIntPoint& Last, VisitorType&& Visit) const
+    {
+        // Clamp to the occupied area so large query boxes do not probe empty cells
+        const int32 MinX = FMath::Max(First.X, MinCell.X), MaxX = FMath::Min(Last.X, MaxCell.X);
+        const int32 MinY = FMath::Max(First.Y, MinCell.Y), MaxY = FMath::Min(Last.Y, MaxCell.Y);
+        if (MinX > MaxX || MinY > MaxY)
+        {
+            return;
+        }
+        if ((int64(MaxX) - MinX + 1) * (int64(MaxY) - MinY + 1) > Cells.Num())
+        {
+            // The box covers more cells than are occupied, walk the occupied ones instead
+            for (const TPair<FIntPoint, TArray<FCellEntry>>& Pair : Cells)
+            {
+                if (Pair.Key.X >= MinX && Pair.Key.X <= MaxX && Pair.Key.Y >= MinY && Pair.Key.Y <= MaxY)
+                {
+                    Visit(Pair.Value);
+                }
+            }
+            return;
+        }
+        for (int32 Y = MinY; Y <= MaxY; ++Y)
+        {
+            for (int32 X = MinX; X <= MaxX; ++X)
+            {
+                if (const TArray<FCellEntry>* Entries = Cells.Find(FIntPoint(X, Y)))
+                {
+                    Visit(*Entries);
+                }
+            }
+        }
+    }
+
+    /** Visits the cells at Chebyshev distance Ring from Center */
+    template<typename VisitorType>
+    void ForEachCellInRing(const FIntPoint& Center, int32 Ring, VisitorType&& Visit) const
+    {
+        const auto VisitCell = [this, &Visit](int32 X, int32 Y)
+        {
+            if (const TArray<FCellEntry>* Entries = Cells.Find(FIntPoint(X, Y)))
+            {
+                Visit(*Entries);
+            }
+        };
+        if (Ring == 0)
+        {
+            VisitCell(Center.X, Center.Y);
+            return;
+        }
+        for (int32 X = Center.X - Ring; X <= Center.X + Ring; ++X)
+        {
+            VisitCell(X, Center.Y - Ring);
+            VisitCell(X, Center.Y + Ring);
+        }
+        for (int32 Y = Center.Y - Ring + 1; Y <= Center.Y + Ring - 1; ++Y)
+        {
+            VisitCell(Center.X - Ring, Y);
+            VisitCell(Center.X + Ring, Y);
+        }
+    }
+
+    float CellSize;
+    double InvCellSize;
+    int32 Num = 0;
+
+    /** Bounds of the occupied cells, limits the cells visited by queries */
+    FIntPoint MinCell = FIntPoint(MAX_int32, MAX_int32);
+    FIntPoint MaxCell = FIntPoint(MIN_int32, MIN_int32);
+};
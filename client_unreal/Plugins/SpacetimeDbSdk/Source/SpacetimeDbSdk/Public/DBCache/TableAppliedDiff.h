@@ -1,5 +1,6 @@
 #pragma once
 #include "CoreMinimal.h"
+#include "WithBsatn.h"
 
 /* ============================================================================ *
  *  TableAppliedDiff.h (2025-05-28)
@@ -12,15 +13,16 @@
 template<typename RowType>
 struct FTableAppliedDiff
 {
-    // SerializedKey -> Row copy. Keeping the rows by value ensures
-    // the memory stays valid even if the underlying table reallocates
-    // or removes entries while this diff is alive.
-    TMap<TArray<uint8>, RowType> Deletes;
-    TMap<TArray<uint8>, RowType> Inserts;
+    // SerializedKey -> Row. The diff shares the row instances held by the
+    // cache and its indices instead of copying them. Cached rows are never
+    // modified in place, so a shared row stays valid and unchanged even after
+    // the table replaces or removes its entry while this diff is alive.
+    TMap<FRowKey, TSharedPtr<const RowType>> Deletes;
+    TMap<FRowKey, TSharedPtr<const RowType>> Inserts;
 
     // Parallel arrays for (old, new) row update pairs.
-    TArray<RowType> UpdateDeletes;
-    TArray<RowType> UpdateInserts;
+    TArray<TSharedPtr<const RowType>> UpdateDeletes;
+    TArray<TSharedPtr<const RowType>> UpdateInserts;
 
     bool IsEmpty() const
     {
@@ -39,18 +41,18 @@ struct FTableAppliedDiff
         if (Deletes.IsEmpty()) return;
 
         // Build PK->(key,row) map for deletes.
-        TMap<KeyType, TPair<TArray<uint8>, RowType>> DeletePK;
+        TMap<KeyType, TPair<FRowKey, TSharedPtr<const RowType>>> DeletePK;
         for (const auto& Pair : Deletes)
         {
-            DeletePK.Add(DerivePK(Pair.Value), { Pair.Key, Pair.Value });
+            DeletePK.Add(DerivePK(*Pair.Value), { Pair.Key, Pair.Value });
         }
 
         // Scan inserts for matching PKs.
-        TArray<TArray<uint8>> DeleteKeys;
-        TArray<TArray<uint8>> InsertKeys;
+        TArray<FRowKey> DeleteKeys;
+        TArray<FRowKey> InsertKeys;
         for (const auto& Pair : Inserts)
         {
-            KeyType PK = DerivePK(Pair.Value);
+            KeyType PK = DerivePK(*Pair.Value);
             if (const auto* Found = DeletePK.Find(PK))
             {
                 UpdateDeletes.Add(Found->Value);
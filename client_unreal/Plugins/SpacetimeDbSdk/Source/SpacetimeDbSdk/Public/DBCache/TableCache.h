@@ -1,8 +1,11 @@
 #pragma once
 #include "CoreMinimal.h"
 #include "RowEntry.h"
+#include "WithBsatn.h"
 #include "UniqueIndex.h"
 #include "BTreeUniqueIndex.h"
+#include "SpatialHashGrid.h"
+#include "TableSnapshot.h"
 
 /* ============================================================================ *
  *  TableCache.h (2025-05-28)
@@ -10,7 +13,8 @@
  *  An in‑memory mirror of a single database table.
  *
  *  Keyed by serialized byte blobs (BSATN) so we can hash/compare cheaply even
- *  for row structs containing floats or other non‑hashable fields.
+ *  for row structs containing floats or other non‑hashable fields. Tables with a
+ *  primary key are keyed on the serialized key column, the others on the whole row.
  * ============================================================================ */
 template<typename RowType>
 class FTableCache
@@ -18,10 +22,10 @@ class FTableCache
 public:
 
     /**
-     * Main storage of table rows keyed by their serialized primary key.
-     * TArray<uint8> is used to allow arbitrary binary keys.
+     * Main storage of table rows keyed by their serialized primary key, or by the whole row bytes for tables without one.
+     * FRowKey holds arbitrary binary keys together with their precomputed hash.
      */
-    TMap<TArray<uint8>, FRowEntry<RowType>> Entries;
+    TMap<FRowKey, FRowEntry<RowType>> Entries;
 
     /**
      * Map of unique index name -> unique index object.
@@ -31,12 +35,33 @@ public:
 
     /**
      * Map of multi-key B-Tree index name -> index object.
-     * Used for efficient lookups on non-unique columns or composite keys.
+     * Used for efficient lookups on non-unique columns or composite keys, and for key range and key prefix queries.
      */
     TMap<FString, TSharedPtr<IMultiKeyIndex<RowType>>> BTreeIndices;
 
+    /**
+     * Map of spatial index name -> hash grid over row positions.
+     * Used for radius, box and nearest neighbour queries.
+     */
+    TMap<FString, TSharedPtr<FSpatialHashGrid<RowType>>> SpatialIndices;
+
+    /**
+     * Publishes read-only snapshots of the table for worker threads, unset until EnableSnapshots is called.
+     * Updated by UClientCache::ApplyDiff together with the indices.
+     */
+    TSharedPtr<FTableSnapshotPublisher<RowType>> SnapshotPublisher;
+
     /* --------------------------------------------------------------------- */
 
+    ~FTableCache()
+    {
+        // The publisher may outlive the table in a reader's hands, its handler points at this table
+        if (SnapshotPublisher.IsValid())
+        {
+            SnapshotPublisher->SetVisibleChangesHandler(nullptr);
+        }
+    }
+
     /**
      * Adds a unique constraint (unique index) to the table.
      *
@@ -71,14 +96,16 @@ public:
     /**
      * Adds a new multi-key B-Tree index to the table.
      *
-     * @tparam KeyType      Type of the key to extract and store in the index.
-     * @param Name          Unique name for the index.
-     * @param ExtractKey    Function that extracts the key from a given row.
+     * @tparam KeyType        Type of the key to extract and store in the index, ordered by operator< or element-wise for tuples.
+     * @param Name            Unique name for the index.
+     * @param ExtractKey      Function that extracts the key from a given row.
+     * @param OrderWithinKey  Optional order of the rows sharing a key, for example by primary key.
      */
     template<typename KeyType>
     void AddMultiKeyBTreeIndex(
         const FString& Name,
-        TFunction<KeyType(const RowType&)> ExtractKey)
+        TFunction<KeyType(const RowType&)> ExtractKey,
+        TFunction<bool(const RowType&, const RowType&)> OrderWithinKey = nullptr)
     {
         // Prevent duplicate index names
         if (BTreeIndices.Contains(Name))
@@ -88,11 +115,116 @@ public:
         }
 
         // Create the B-Tree index and register it
-        TSharedPtr<IMultiKeyIndex<RowType>> NewIndex = MakeShared<FMultiKeyBTreeIndex<RowType, KeyType>>(ExtractKey);
+        TSharedPtr<IMultiKeyIndex<RowType>> NewIndex = MakeShared<FMultiKeyBTreeIndex<RowType, KeyType>>(ExtractKey, OrderWithinKey);
         BTreeIndices.Add(Name, NewIndex);
     }
 
 
+    /**
+     * Adds a spatial hash grid over the position of each row.
+     * Unlike the other indices it may be added at any time, the rows already cached are inserted into it.
+     *
+     * @param Name              Unique name for the spatial index.
+     * @param CellSize          Edge length of a grid cell, about the typical query radius works best.
+     * @param ExtractPosition   Function that extracts the position from a given row, for example GetTransformLocation(Row.Transform).
+     */
+    void AddSpatialIndex(
+        const FString& Name,
+        float CellSize,
+        TFunction<FVector(const RowType&)> ExtractPosition)
+    {
+        if (SpatialIndices.Contains(Name))
+        {
+            UE_LOG(LogTemp, Error, TEXT("Duplicate spatial index: %s"), *Name);
+            return;
+        }
+
+        TSharedPtr<FSpatialHashGrid<RowType>> NewIndex = MakeShared<FSpatialHashGrid<RowType>>(CellSize, MoveTemp(ExtractPosition));
+        if (ReadsThroughSnapshots())
+        {
+            // The entries belong to the apply thread, the indices hold the visible version
+            PinSnapshot()->ForEachHandle([&NewIndex](const TSharedPtr<const RowType>& Row)
+            {
+                NewIndex->AddRow(ConstCastSharedPtr<RowType>(Row));
+            });
+        }
+        else
+        {
+            for (const auto& Pair : Entries)
+            {
+                NewIndex->AddRow(Pair.Value.Row);
+            }
+        }
+        SpatialIndices.Add(Name, NewIndex);
+    }
+
+    /** Returns the spatial index registered under Name, or nullptr if there is none. */
+    const FSpatialHashGrid<RowType>* FindSpatialIndex(const FString& Name) const
+    {
+        const TSharedPtr<FSpatialHashGrid<RowType>>* IndexPtr = SpatialIndices.Find(Name);
+        return IndexPtr ? IndexPtr->Get() : nullptr;
+    }
+
+    /**
+     * Starts publishing snapshots of the table, the first one holds the rows already cached.
+     * Does nothing if snapshots are already enabled.
+     * Once visibility is deferred, the indices are updated when a version becomes visible instead of when it is applied.
+     *
+     * @param NumBuckets    Initial number of buckets, rounded up to a power of two. Grows with the table.
+     */
+    void EnableSnapshots(int32 NumBuckets = 256)
+    {
+        if (SnapshotPublisher.IsValid())
+        {
+            return;
+        }
+
+        SnapshotPublisher = MakeShared<FTableSnapshotPublisher<RowType>>(NumBuckets);
+        for (const auto& Pair : Entries)
+        {
+            SnapshotPublisher->AddRow(Pair.Key.Hash, Pair.Value.Row);
+        }
+        SnapshotPublisher->Publish();
+
+        // Replays each version's changes in the order ApplyDiff made them, removals before the inserts taking their unique values
+        SnapshotPublisher->SetVisibleChangesHandler([this](TConstArrayView<FTableSnapshotChange<RowType>> Changes)
+        {
+            for (const FTableSnapshotChange<RowType>& Change : Changes)
+            {
+                if (Change.bAdd)
+                {
+                    AddRowToIndices(Change.Row);
+                }
+                else
+                {
+                    RemoveRowFromIndices(Change.Row);
+                }
+            }
+            CommitIndices();
+        });
+    }
+
+    /**
+     * Pins the latest visible snapshot of the table. Safe to call from any thread once snapshots are enabled,
+     * the snapshot stays valid and unchanged for as long as the caller holds it.
+     * When diffs are applied on the apply thread it is the version matching the events the game thread broadcast last.
+     *
+     * @return  The snapshot, or nullptr if snapshots are not enabled.
+     */
+    TSharedPtr<const FTableSnapshot<RowType>> PinSnapshot() const
+    {
+        return SnapshotPublisher.IsValid() ? SnapshotPublisher->PinVisible() : nullptr;
+    }
+
+    /**
+     * True when diffs are applied off the game thread. The entries then belong to the apply thread and the game thread
+     * reads the rows through PinSnapshot. The indices stay on the game thread and follow the visible snapshot.
+     */
+    bool ReadsThroughSnapshots() const
+    {
+        return SnapshotPublisher.IsValid() && SnapshotPublisher->IsVisibilityDeferred();
+    }
+
     /**
      * Finds a row by its unique index key.
      *
@@ -121,6 +253,27 @@ public:
         return FoundRowPtr.Get();
     }
 
+    /**
+     * Finds all rows from a multi-key B-Tree index that match the given key, without copying them.
+     * Safe to call from several threads at once while no diff is being applied or made visible.
+     *
+     * @tparam KeyType   The type of the key to search for in the index.
+     * @param Name       The name of the B-Tree index to query.
+     * @param Key        The key value to search for.
+     * @return           Range over the handles of the matching rows, valid until the next applied diff.
+     */
+    template<typename KeyType>
+    FIndexRowRange<RowType> FindRowsByMultiKeyBTreeIndex(const FString& Name, const KeyType& Key) const
+    {
+        // Find the index object by its name.
+        const auto* IndexPtr = BTreeIndices.Find(Name);
+        if (!IndexPtr || !(*IndexPtr)) // Return empty if index is missing or invalid.
+        {
+            return FIndexRowRange<RowType>();
+        }
+        return (*IndexPtr)->FindRows(&Key);
+    }
+
     /**
     * Finds all rows from a multi-key B-Tree index that match the given key.
     * Uses output parameter pattern to avoid unnecessary copies.
@@ -134,52 +287,235 @@ public:
     template<typename KeyType>
     void FindByMultiKeyBTreeIndex(TArray<RowType>& OutResults, const FString& Name, const KeyType& Key) const
     {
-        // Clear output array first
         OutResults.Reset();
+        AppendIndexedRows(OutResults, FindRowsByMultiKeyBTreeIndex(Name, Key));
+    }
 
-        // Find the index object by its name.
+    /**
+     * Returns the typed B-Tree index registered under Name, or nullptr if there is none.
+     * KeyType must be the key type the index was added with.
+     */
+    template<typename KeyType>
+    const FMultiKeyBTreeIndex<RowType, KeyType>* FindBTreeIndex(const FString& Name) const
+    {
         const auto* IndexPtr = BTreeIndices.Find(Name);
-        if (!IndexPtr || !(*IndexPtr)) // Return empty if index is missing or invalid.
+        if (!IndexPtr || !(*IndexPtr))
         {
-            return;
+            return nullptr;
         }
+        return static_cast<const FMultiKeyBTreeIndex<RowType, KeyType>*>(IndexPtr->Get());
+    }
 
-        // Retrieve all serialized keys that match the provided search key.
-        const TArray<TArray<uint8>>* SerializedKeys = (*IndexPtr)->FindKeys(&Key);
-        if (!SerializedKeys) // Return empty if no matching keys found.
+    /**
+     * Finds the rows of a B-Tree index whose key is in [Lower, Upper), ordered by key, without copying them.
+     *
+     * @tparam KeyType   The key type of the index.
+     * @param Name       The name of the B-Tree index to query.
+     * @param Lower      First key of the range.
+     * @param Upper      Key ending the range, excluded.
+     * @return           Range over the handles of the matching rows, valid until the next applied diff.
+     */
+    template<typename KeyType>
+    FIndexRowRange<RowType> FindRowsInRangeByMultiKeyBTreeIndex(const FString& Name, const KeyType& Lower, const KeyType& Upper) const
+    {
+        const FMultiKeyBTreeIndex<RowType, KeyType>* Index = FindBTreeIndex<KeyType>(Name);
+        return Index ? Index->RowsOf(Index->Range(Lower, Upper)) : FIndexRowRange<RowType>();
+    }
+
+    /** Copying variant of FindRowsInRangeByMultiKeyBTreeIndex, fills OutResults with the rows in [Lower, Upper). */
+    template<typename KeyType>
+    void FindRangeByMultiKeyBTreeIndex(TArray<RowType>& OutResults, const FString& Name, const KeyType& Lower, const KeyType& Upper) const
+    {
+        OutResults.Reset();
+        AppendIndexedRows(OutResults, FindRowsInRangeByMultiKeyBTreeIndex(Name, Lower, Upper));
+    }
+
+    /**
+     * Finds the rows of a tuple keyed B-Tree index whose leading key elements equal Prefix,
+     * ordered by the remaining key elements, without copying them.
+     *
+     * @tparam KeyType    The key type of the index, a TTuple.
+     * @tparam PrefixType A TTuple of the leading key element types.
+     * @param Name        The name of the B-Tree index to query.
+     * @param Prefix      Values of the leading key elements.
+     * @return            Range over the handles of the matching rows, valid until the next applied diff.
+     */
+    template<typename KeyType, typename PrefixType>
+    FIndexRowRange<RowType> FindRowsWithPrefixByMultiKeyBTreeIndex(const FString& Name, const PrefixType& Prefix) const
+    {
+        const FMultiKeyBTreeIndex<RowType, KeyType>* Index = FindBTreeIndex<KeyType>(Name);
+        return Index ? Index->RowsOf(Index->PrefixRange(Prefix)) : FIndexRowRange<RowType>();
+    }
+
+    /** Copying variant of FindRowsWithPrefixByMultiKeyBTreeIndex, fills OutResults with the rows matching Prefix. */
+    template<typename KeyType, typename PrefixType>
+    void FindPrefixByMultiKeyBTreeIndex(TArray<RowType>& OutResults, const FString& Name, const PrefixType& Prefix) const
+    {
+        OutResults.Reset();
+        AppendIndexedRows(OutResults, FindRowsWithPrefixByMultiKeyBTreeIndex<KeyType>(Name, Prefix));
+    }
+
+    /**
+     * Iterator over the cached rows, reading each row in place.
+     * Supports range-based for loops over the table cache: for (const RowType& Row : Table) { ... }
+     * Invalidated by the next applied diff.
+     */
+    class FRowIterator
+    {
+    public:
+        using FEntryIterator = decltype(DeclVal<const TMap<FRowKey, FRowEntry<RowType>>&>().begin());
+
+        explicit FRowIterator(FEntryIterator InIt) : It(InIt) {}
+
+        const RowType& operator*() const { return *(*It).Value.Row; }
+        const RowType* operator->() const { return (*It).Value.Row.Get(); }
+        FRowIterator& operator++() { ++It; return *this; }
+        bool operator!=(const FRowIterator& Other) const { return It != Other.It; }
+
+    private:
+        FEntryIterator It;
+    };
+
+    FRowIterator begin() const { return FRowIterator(Entries.begin()); }
+    FRowIterator end() const { return FRowIterator(Entries.end()); }
+
+    /**
+     * Calls Visit for every cached row, reading the rows in place without copying them.
+     *
+     * @param Visit     Function receiving each row. It must not apply diffs to this table.
+     */
+    void ForEach(TFunctionRef<void(const RowType&)> Visit) const
+    {
+        for (const RowType& Row : *this)
         {
-            return;
+            Visit(Row);
         }
+    }
 
-        // Loop through each serialized key to find the corresponding row entry.
-        for (const TArray<uint8>& SerializedKey : *SerializedKeys)
+    /**
+     * Copies at most PageSize rows, starting at Cursor in iteration order.
+     * Lets Blueprint loops read a large table over several calls. The cursor is a slot of the entry storage,
+     * so a page starts where the previous one ended instead of walking the rows before it.
+     * Cursors only hold while no diff is applied.
+     *
+     * @param OutRows       Output array filled with the copied rows.
+     * @param Cursor        Where the page starts, 0 for the first page, then the OutNextCursor of the previous one.
+     * @param PageSize      Maximum number of rows to copy.
+     * @param OutNextCursor Where the next page starts.
+     * @return              True if rows remain after this page.
+     */
+    bool GetPage(TArray<RowType>& OutRows, int32 Cursor, int32 PageSize, int32& OutNextCursor) const
+    {
+        OutRows.Reset();
+        OutNextCursor = Cursor;
+        if (Cursor < 0 || PageSize <= 0)
         {
-            const FRowEntry<RowType>* Entry = Entries.Find(SerializedKey);
-            if (Entry && Entry->Row.IsValid()) // If the entry exists, add copy to the results.
+            return false;
+        }
+
+        const int32 NumSlots = Entries.GetMaxIndex();
+        OutRows.Reserve(FMath::Min(PageSize, Entries.Num()));
+        int32 Slot = Cursor;
+        for (; Slot < NumSlots && OutRows.Num() < PageSize; ++Slot)
+        {
+            const FSetElementId Id = FSetElementId::FromInteger(Slot);
+            if (Entries.IsValidId(Id))
             {
-                OutResults.Add(*Entry->Row);
+                OutRows.Add(*Entries.Get(Id).Value.Row);
             }
         }
+        // Skip the slots of removed entries up to the next row, so whether one remains is known
+        while (Slot < NumSlots && !Entries.IsValidId(FSetElementId::FromInteger(Slot)))
+        {
+            ++Slot;
+        }
+        OutNextCursor = Slot;
+        return Slot < NumSlots;
     }
-    
+
     /**
      * Retrieves all rows currently stored in the table cache.
+     * Copies every row, prefer ForEach or a range-based for loop when the rows are only read.
      *
      * @param AllRows   Output array to be filled with copies of all rows.
      */
     void GetValues(TArray<RowType>& AllRows) const
     {
-        // Temporary array to hold all FRowEntry objects from the Entries map
-        TArray<FRowEntry<RowType>> TempRowEntries;
-        Entries.GenerateValueArray(TempRowEntries);
-
         // Clear the output array to ensure no old data remains
-        AllRows.Empty();
+        AllRows.Reset(Entries.Num());
+
+        // Copy each row once, straight from the shared instance held by its entry
+        for (const RowType& Row : *this)
+        {
+            AllRows.Add(Row);
+        }
+    }
+
+    /** Add a cached row instance to every index of the table */
+    void AddRowToIndices(const TSharedPtr<RowType>& Row)
+    {
+        for (auto& IndexPair : UniqueIndices)
+        {
+            IndexPair.Value->AddRow(Row);
+        }
+        for (auto& IndexPair : BTreeIndices)
+        {
+            IndexPair.Value->AddRow(Row);
+        }
+        for (auto& IndexPair : SpatialIndices)
+        {
+            IndexPair.Value->AddRow(Row);
+        }
+    }
+
+    /** Remove a cached row instance from every index of the table */
+    void RemoveRowFromIndices(const TSharedPtr<RowType>& Row)
+    {
+        for (auto& IndexPair : UniqueIndices)
+        {
+            IndexPair.Value->RemoveRow(Row);
+        }
+        for (auto& IndexPair : BTreeIndices)
+        {
+            IndexPair.Value->RemoveRow(Row);
+        }
+        for (auto& IndexPair : SpatialIndices)
+        {
+            IndexPair.Value->RemoveRow(Row);
+        }
+    }
+
+    /** Apply the index changes buffered since the last commit */
+    void CommitIndices()
+    {
+        for (auto& IndexPair : BTreeIndices)
+        {
+            IndexPair.Value->Commit();
+        }
+    }
+
+    /**
+     * Heap memory held by the cache storage: the entry map, the key bytes and one row instance per entry.
+     * Memory owned by fields of the rows themselves (strings, arrays) is not included.
+     */
+    SIZE_T GetAllocatedSize() const
+    {
+        SIZE_T Size = Entries.GetAllocatedSize();
+        for (const auto& Pair : Entries)
+        {
+            Size += Pair.Key.Bytes.GetAllocatedSize() + sizeof(RowType);
+        }
+        return Size;
+    }
 
-        // Extract the actual Row objects from each FRowEntry and add them to AllRows
-        for (const FRowEntry<RowType>& Entry : TempRowEntries)
+private:
+    /** Add a copy of each row of an index range to OutResults */
+    static void AppendIndexedRows(TArray<RowType>& OutResults, const FIndexRowRange<RowType>& Rows)
+    {
+        OutResults.Reserve(OutResults.Num() + Rows.Len());
+        for (const TSharedPtr<RowType>& Row : Rows)
         {
-            AllRows.Add(Entry.Row);  // Add by value; assumes FRowEntry.Row is RowType or convertible
+            OutResults.Add(*Row);
         }
     }
 
@@ -37,29 +37,44 @@ public:
         return bValid;
     }
 
+    /*
+     * When the table is applied on the apply thread (FTableCache::ReadsThroughSnapshots) the entries
+     * belong to that thread and row reads go through the visible snapshot instead.
+     * Index lookups keep working, the indices follow the visible snapshot on the game thread.
+     */
+
     /** O(1) row count. */
     int64 Count() const
     {
         auto T = Cache->GetTable(TableName);
-        return T.IsValid() ? T->Entries.Num() : 0;
+        if (!T.IsValid())
+        {
+            return 0;
+        }
+        if (T->ReadsThroughSnapshots())
+        {
+            return T->PinSnapshot()->Num();
+        }
+        return T->Entries.Num();
     }
 
-    /** Copy all rows into an array. */
+    /** Copy all rows into an array. Prefer ForEach when the rows are only read. */
     TArray<RowType> GetAllRows() const
     {
         TArray<RowType> Out;
 
         auto T = Cache->GetTable(TableName);
-        UE_LOG(LogTemp, Warning,
-            TEXT("GetTable(%s) valid=%d"),
-            *TableName, T.IsValid());
-
         if (T.IsValid())
         {
-            for (const auto& Pair : T->Entries)
+            if (T->ReadsThroughSnapshots())
             {
-                // Dereference the shared pointer to get the RowType value
-                Out.Add(*Pair.Value.Row);
+                const TSharedPtr<const FTableSnapshot<RowType>> Snapshot = T->PinSnapshot();
+                Out.Reserve(Snapshot->Num());
+                Snapshot->ForEach([&Out](const RowType& Row) { Out.Add(Row); });
+            }
+            else
+            {
+                T->GetValues(Out);
             }
         }
         return Out;
@@ -71,14 +86,77 @@ public:
         return GetAllRows();
     }
 
+    /** Call Visit for every row, reading the rows in place without copying them. */
+    void ForEach(TFunctionRef<void(const RowType&)> Visit) const
+    {
+        auto T = Cache->GetTable(TableName);
+        if (!T.IsValid())
+        {
+            return;
+        }
+        if (T->ReadsThroughSnapshots())
+        {
+            T->PinSnapshot()->ForEach(Visit);
+        }
+        else
+        {
+            T->ForEach(Visit);
+        }
+    }
+
+    /**
+     * Copy at most PageSize rows starting at Cursor, 0 for the first page, and set OutNextCursor to where the next one starts.
+     * Returns true if rows remain after the page.
+     */
+    bool GetPage(TArray<RowType>& OutRows, int32 Cursor, int32 PageSize, int32& OutNextCursor) const
+    {
+        auto T = Cache->GetTable(TableName);
+        if (!T.IsValid())
+        {
+            OutRows.Reset();
+            OutNextCursor = Cursor;
+            return false;
+        }
+        if (T->ReadsThroughSnapshots())
+        {
+            return GetSnapshotPage(*T->PinSnapshot(), OutRows, Cursor, PageSize, OutNextCursor);
+        }
+        return T->GetPage(OutRows, Cursor, PageSize, OutNextCursor);
+    }
+
     /** Find a row via a unique index. */
     const RowType* FindUnique(const FString& IndexName, const void* Key) const
     {
         auto T = Cache->GetTable(TableName);
-        return T.IsValid() ? T->FindByUniqueIndex(IndexName, Key) : nullptr;
+        if (!T.IsValid())
+        {
+            return nullptr;
+        }
+        return T->FindByUniqueIndex(IndexName, Key);
     }
 
 private:
+    /**
+     * Page of a snapshot, in the snapshot's iteration order, which holds for as long as the same version is visible.
+     * The cursor is the position of the page's first row.
+     */
+    static bool GetSnapshotPage(const FTableSnapshot<RowType>& Snapshot, TArray<RowType>& OutRows, int32 Cursor, int32 PageSize, int32& OutNextCursor)
+    {
+        OutRows.Reset();
+        OutNextCursor = Cursor;
+        if (Cursor < 0 || PageSize <= 0 || Cursor >= Snapshot.Num())
+        {
+            return false;
+        }
+
+        OutRows.Reserve(FMath::Min(PageSize, Snapshot.Num() - Cursor));
+        OutNextCursor = Cursor + Snapshot.ForEachInRange(Cursor, PageSize, [&OutRows](const RowType& Row)
+        {
+            OutRows.Add(Row);
+        });
+        return OutNextCursor < Snapshot.Num();
+    }
+
     bool bValid;
 };
 
@@ -97,6 +175,101 @@ TArray<TData> GetAllRowsFromTable(TSharedPtr<UClientCache<TData>> Cache, const F
     return Result;
 }
 
+/** Templated functions to visit all rows of a table by name without copying them */
+template<typename TData>
+void ForEachRowInTable(TSharedPtr<UClientCache<TData>> Cache, const FString& TableName, TFunctionRef<void(const TData&)> Visit)
+{
+    // Straight to the table cache, a handle would copy the table name on every call
+    TSharedPtr<const FTableCache<TData>> Table = Cache.IsValid() ? Cache->GetTable(TableName) : nullptr;
+    if (!Table.IsValid())
+    {
+        return;
+    }
+    if (Table->ReadsThroughSnapshots())
+    {
+        Table->PinSnapshot()->ForEach(Visit);
+    }
+    else
+    {
+        Table->ForEach(Visit);
+    }
+}
+
+/** Templated functions to copy one page of rows from a table by name, starting at Cursor */
+template<typename TData>
+TArray<TData> GetRowPageFromTable(TSharedPtr<UClientCache<TData>> Cache, const FString& TableName, int32 Cursor, int32 PageSize, int32& OutNextCursor, bool& bOutHasMore)
+{
+    TArray<TData> Result;
+    OutNextCursor = Cursor;
+    bOutHasMore = false;
+    FTableHandle<TData> Handle(Cache, TableName);
+    if (Handle.IsValid())
+    {
+        bOutHasMore = Handle.GetPage(Result, Cursor, PageSize, OutNextCursor);
+    }
+    return Result;
+}
+
+/** Templated functions to get a spatial index of a table by name, nullptr if the table or index does not exist */
+template<typename TData>
+const FSpatialHashGrid<TData>* FindSpatialIndexInTable(TSharedPtr<UClientCache<TData>> Cache, const FString& TableName, const FString& IndexName)
+{
+    TSharedPtr<const FTableCache<TData>> Table = Cache.IsValid() ? Cache->GetTable(TableName) : nullptr;
+    if (!Table.IsValid())
+    {
+        return nullptr;
+    }
+    return Table->FindSpatialIndex(IndexName);
+}
+
+/** Templated functions to copy the rows within Radius of Center from a spatial index of a table */
+template<typename TData>
+TArray<TData> FindInRadiusFromTable(TSharedPtr<UClientCache<TData>> Cache, const FString& TableName, const FString& IndexName, const FVector& Center, float Radius)
+{
+    TArray<TData> Result;
+    if (const FSpatialHashGrid<TData>* Grid = FindSpatialIndexInTable(Cache, TableName, IndexName))
+    {
+        Grid->ForEachInRadius(Center, Radius, [&Result](const TSharedPtr<TData>& Row, double) { Result.Add(*Row); });
+    }
+    return Result;
+}
+
+/** Templated functions to copy the rows inside Box from a spatial index of a table */
+template<typename TData>
+TArray<TData> FindInBoxFromTable(TSharedPtr<UClientCache<TData>> Cache, const FString& TableName, const FString& IndexName, const FBox& Box)
+{
+    TArray<TData> Result;
+    if (const FSpatialHashGrid<TData>* Grid = FindSpatialIndexInTable(Cache, TableName, IndexName))
+    {
+        TArray<TSharedPtr<TData>> Rows;
+        Grid->FindInBox(Box, Rows);
+        Result.Reserve(Rows.Num());
+        for (const TSharedPtr<TData>& Row : Rows)
+        {
+            Result.Add(*Row);
+        }
+    }
+    return Result;
+}
+
+/** Templated functions to copy the Count rows nearest to Center from a spatial index of a table, nearest first */
+template<typename TData>
+TArray<TData> FindNearestFromTable(TSharedPtr<UClientCache<TData>> Cache, const FString& TableName, const FString& IndexName, const FVector& Center, int32 Count, float MaxRadius)
+{
+    TArray<TData> Result;
+    if (const FSpatialHashGrid<TData>* Grid = FindSpatialIndexInTable(Cache, TableName, IndexName))
+    {
+        TArray<TSharedPtr<TData>> Rows;
+        Grid->FindNearest(Center, Count, Rows, MaxRadius);
+        Result.Reserve(Rows.Num());
+        for (const TSharedPtr<TData>& Row : Rows)
+        {
+            Result.Add(*Row);
+        }
+    }
+    return Result;
+}
+
 /** Templated functions to get row count from table by name */
 template<typename TData>
 int32 GetRowCountFromTable(TSharedPtr<UClientCache<TData>> Cache, const FString& TableName)
@@ -139,4 +312,16 @@ public:
         }
         return TRowType(); // Return a default-constructed object if not found
     }
+
+    // Rows with Lower <= key < Upper, ordered by key.
+    // Served by the ordered index registered under the same name as the unique index.
+    TArray<TRowType> FindUniqueIndexRange(TKeyType Lower, TKeyType Upper) const
+    {
+        TArray<TRowType> Results;
+        if (Cache != nullptr)
+        {
+            Cache->template FindRangeByMultiKeyBTreeIndex<TTuple<TKeyType>>(Results, UniqueIndexName, MakeTuple(Lower), MakeTuple(Upper));
+        }
+        return Results;
+    }
 };
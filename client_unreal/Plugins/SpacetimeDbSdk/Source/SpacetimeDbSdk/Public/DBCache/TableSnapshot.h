@@ -0,0 +1,409 @@
+#pragma once
+#include "CoreMinimal.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/StableSort.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/ScopeRWLock.h"
+#include "WithBsatn.h"
+#include "BSATN/UESpacetimeDB.h"
+
+/* ============================================================================ *
+ *  TableSnapshot.h
+ *  ----------------------------------------------------------------------------
+ *  Immutable, epoch versioned views of a table cache for worker thread readers.
+ *
+ *  • A snapshot is a fixed set of buckets of row handles, bucketed by the hash
+ *    of the cache key. Neither the snapshot nor its buckets change once published.
+ *  • The game thread publishes a new version after every applied diff, copy on
+ *    write per bucket: untouched buckets are shared with the previous version.
+ *  • Readers pin a version by holding its shared pointer. Versions, buckets and
+ *    rows are reclaimed when the last reader pinning them lets go.
+ *  • When the cache is applied on its own thread, published versions only become
+ *    visible once the game thread has broadcast the diff that produced them.
+ *    The changes of each version are handed to the game thread at that point so
+ *    the table's indices can follow the visible version.
+ * ============================================================================ */
+
+/** One row of a snapshot: the hash of its cache key and the row instance shared with the table cache */
+template<typename RowType>
+struct FTableSnapshotRow
+{
+    uint32 Hash;
+    TSharedPtr<const RowType> Row;
+};
+
+template<typename RowType>
+using FTableSnapshotBucket = TArray<FTableSnapshotRow<RowType>>;
+
+/** A row entering or leaving the table, recorded in the order the diff made the change */
+template<typename RowType>
+struct FTableSnapshotChange
+{
+    /** Hash of the row's cache key */
+    uint32 Hash;
+    TSharedPtr<RowType> Row;
+    bool bAdd;
+};
+
+template<typename RowType>
+class FTableSnapshot
+{
+public:
+    /** Version of the table this snapshot shows, increases by one with every published diff */
+    uint64 GetEpoch() const { return Epoch; }
+
+    /** Number of rows in the snapshot */
+    int32 Num() const { return NumRows; }
+
+    /** Calls Visit for every row of the snapshot, in no particular order */
+    void ForEach(TFunctionRef<void(const RowType&)> Visit) const
+    {
+        for (const TSharedPtr<const FTableSnapshotBucket<RowType>>& Bucket : Buckets)
+        {
+            for (const FTableSnapshotRow<RowType>& Entry : *Bucket)
+            {
+                Visit(*Entry.Row);
+            }
+        }
+    }
+
+    /**
+     * Calls Visit for at most Count rows, starting at the Position-th row in the order ForEach visits them.
+     * The first row is found by a binary search over the buckets, the rows before it are not walked.
+     * @return Number of rows visited.
+     */
+    int32 ForEachInRange(int32 Position, int32 Count, TFunctionRef<void(const RowType&)> Visit) const
+    {
+        if (Position < 0 || Count <= 0 || Position >= NumRows)
+        {
+            return 0;
+        }
+
+        // Last bucket starting at or before Position, empty buckets share their start with the next one
+        int32 BucketIndex = Algo::UpperBound(RowsBefore, Position) - 1;
+        int32 Offset = Position - RowsBefore[BucketIndex];
+        int32 Visited = 0;
+        for (; BucketIndex < Buckets.Num() && Visited < Count; ++BucketIndex, Offset = 0)
+        {
+            const FTableSnapshotBucket<RowType>& Bucket = *Buckets[BucketIndex];
+            for (int32 Index = Offset; Index < Bucket.Num() && Visited < Count; ++Index, ++Visited)
+            {
+                Visit(*Bucket[Index].Row);
+            }
+        }
+        return Visited;
+    }
+
+    /** Calls Visit for the handle of every row of the snapshot, the instance shared with the table cache */
+    void ForEachHandle(TFunctionRef<void(const TSharedPtr<const RowType>&)> Visit) const
+    {
+        for (const TSharedPtr<const FTableSnapshotBucket<RowType>>& Bucket : Buckets)
+        {
+            for (const FTableSnapshotRow<RowType>& Entry : *Bucket)
+            {
+                Visit(Entry.Row);
+            }
+        }
+    }
+
+    /**
+     * First row whose cache key hashes to KeyHash and that matches Predicate, or nullptr.
+     * Only the bucket of KeyHash is searched.
+     */
+    template<typename PredicateType>
+    const RowType* FindByHash(uint32 KeyHash, PredicateType&& Predicate) const
+    {
+        for (const FTableSnapshotRow<RowType>& Entry : *Buckets[KeyHash & (Buckets.Num() - 1)])
+        {
+            if (Entry.Hash == KeyHash && Predicate(*Entry.Row))
+            {
+                return Entry.Row.Get();
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * Row with the given primary key, or nullptr.
+     * TableClass is the generated table declaring FPrimaryKey and GetPrimaryKey, as used to key the table cache.
+     */
+    template<typename TableClass>
+    const RowType* FindByPrimaryKey(const typename TableClass::FPrimaryKey& Key) const
+    {
+        // Same hash as the cache key: the primary key serialized to BSATN, in a buffer reused by the calling thread
+        thread_local TArray<uint8> KeyBytes;
+        KeyBytes.Reset();
+        UE::SpacetimeDB::UEWriter Writer(KeyBytes);
+        // Unqualified so the overloads of key types declared after this header are found through the writer
+        using UE::SpacetimeDB::serialize;
+        serialize(Writer, Key);
+
+        return FindByHash(HashRowBytes(KeyBytes), [&Key](const RowType& Row)
+        {
+            return TableClass::GetPrimaryKey(Row) == Key;
+        });
+    }
+
+private:
+    template<typename> friend class FTableSnapshotPublisher;
+
+    uint64 Epoch = 0;
+    int32 NumRows = 0;
+
+    /** Power of two number of buckets, a row lives in bucket Hash & (Buckets.Num() - 1) */
+    TArray<TSharedPtr<const FTableSnapshotBucket<RowType>>> Buckets;
+
+    /** Number of rows in the buckets before each bucket, lets ForEachInRange find a position without walking the rows */
+    TArray<int32> RowsBefore;
+
+    /** Fill RowsBefore once the buckets are final */
+    void CountRowsBefore()
+    {
+        RowsBefore.SetNumUninitialized(Buckets.Num());
+        int32 Count = 0;
+        for (int32 Index = 0; Index < Buckets.Num(); ++Index)
+        {
+            RowsBefore[Index] = Count;
+            Count += Buckets[Index]->Num();
+        }
+    }
+};
+
+/**
+ * Builds and publishes the snapshots of one table.
+ * Changes are recorded by the thread applying diffs and are published together in Publish.
+ * Pin and PinVisible may be called from any thread.
+ */
+template<typename RowType>
+class FTableSnapshotPublisher
+{
+public:
+    /** Average rows per bucket above which Publish doubles the number of buckets */
+    static constexpr int32 MaxRowsPerBucket = 64;
+
+    /** Receives the changes of one version, in the order they were recorded */
+    using FVisibleChangesHandler = TFunction<void(TConstArrayView<FTableSnapshotChange<RowType>>)>;
+
+    explicit FTableSnapshotPublisher(int32 NumBuckets)
+    {
+        Current = MakeSnapshot(0, static_cast<int32>(FMath::RoundUpToPowerOfTwo(static_cast<uint32>(FMath::Max(NumBuckets, 1)))));
+        Visible = Current;
+    }
+
+    /** Latest published snapshot. The caller keeps the version alive for as long as it holds the pointer */
+    TSharedPtr<const FTableSnapshot<RowType>> Pin() const
+    {
+        FReadScopeLock Lock(CurrentLock);
+        return Current;
+    }
+
+    /** Snapshot the game thread reads, the latest published one unless visibility is deferred */
+    TSharedPtr<const FTableSnapshot<RowType>> PinVisible() const
+    {
+        FReadScopeLock Lock(CurrentLock);
+        return Visible;
+    }
+
+    /**
+     * Stop Publish from making new versions visible, MakeVisible does instead.
+     * Used when diffs are applied ahead of the game thread. Call before the first diff is applied off the game thread.
+     */
+    void DeferVisibility() { bDeferVisible = true; }
+
+    bool IsVisibilityDeferred() const { return bDeferVisible; }
+
+    /**
+     * Called by MakeVisible with the changes of every version it makes visible, one call per version in publish order.
+     * Lets state only read by the game thread, such as the table's indices, follow the visible version while
+     * diffs are applied ahead of it. Set before visibility is deferred, or nullptr to stop.
+     */
+    void SetVisibleChangesHandler(FVisibleChangesHandler InHandler)
+    {
+        VisibleChangesHandler = MoveTemp(InHandler);
+    }
+
+    /**
+     * Make a published version the visible one, once the game thread has been told about the diff that produced it.
+     * The changes of this version and of any older one not made visible yet go to the visible changes handler.
+     */
+    void MakeVisible(const TSharedPtr<const FTableSnapshot<RowType>>& Snapshot)
+    {
+        TSharedPtr<const FTableSnapshot<RowType>> Retired = Snapshot;
+        {
+            FWriteScopeLock Lock(CurrentLock);
+            Swap(Retired, Visible);
+        }
+
+        TArray<FUnseenVersion> NowVisible;
+        {
+            FScopeLock Lock(&UnseenVersionsLock);
+            int32 NumVisible = 0;
+            while (NumVisible < UnseenVersions.Num() && UnseenVersions[NumVisible].Epoch <= Snapshot->GetEpoch())
+            {
+                ++NumVisible;
+            }
+            NowVisible.Reserve(NumVisible);
+            for (int32 Index = 0; Index < NumVisible; ++Index)
+            {
+                NowVisible.Add(MoveTemp(UnseenVersions[Index]));
+            }
+            UnseenVersions.RemoveAt(0, NumVisible, EAllowShrinking::No);
+        }
+        if (VisibleChangesHandler)
+        {
+            for (const FUnseenVersion& Version : NowVisible)
+            {
+                VisibleChangesHandler(Version.Changes);
+            }
+        }
+    }
+
+    /** Record a row entering the table, its cache key hashes to Hash */
+    void AddRow(uint32 Hash, const TSharedPtr<RowType>& Row)
+    {
+        Pending.Add(FTableSnapshotChange<RowType>{ Hash, Row, true });
+    }
+
+    /** Record a row leaving the table */
+    void RemoveRow(uint32 Hash, const TSharedPtr<RowType>& Row)
+    {
+        Pending.Add(FTableSnapshotChange<RowType>{ Hash, Row, false });
+    }
+
+    /**
+     * Publish the recorded changes as the next version.
+     * Copies the bucket table and the buckets that changed, every other bucket is shared with the previous version.
+     */
+    void Publish()
+    {
+        if (Pending.IsEmpty())
+        {
+            return;
+        }
+
+        const FTableSnapshot<RowType>& Previous = *Current;
+        const uint32 Mask = Previous.Buckets.Num() - 1;
+        TSharedPtr<FTableSnapshot<RowType>> Next = MakeShared<FTableSnapshot<RowType>>();
+        Next->Epoch = Previous.Epoch + 1;
+        Next->NumRows = Previous.NumRows;
+        Next->Buckets = Previous.Buckets;
+
+        if (bDeferVisible && VisibleChangesHandler)
+        {
+            // Kept in recorded order for the game thread, which replays them once this version is visible
+            FScopeLock Lock(&UnseenVersionsLock);
+            UnseenVersions.Add(FUnseenVersion{ Next->Epoch, Pending });
+        }
+
+        // Group the changes by bucket, keeping their order within a bucket so a remove and add of the same row replay in sequence
+        Algo::StableSortBy(Pending, [Mask](const FTableSnapshotChange<RowType>& Change) { return Change.Hash & Mask; });
+
+        for (int32 First = 0; First < Pending.Num();)
+        {
+            const uint32 BucketIndex = Pending[First].Hash & Mask;
+            TSharedPtr<FTableSnapshotBucket<RowType>> Bucket = MakeShared<FTableSnapshotBucket<RowType>>(*Previous.Buckets[BucketIndex]);
+            for (; First < Pending.Num() && (Pending[First].Hash & Mask) == BucketIndex; ++First)
+            {
+                const FTableSnapshotChange<RowType>& Change = Pending[First];
+                if (Change.bAdd)
+                {
+                    Bucket->Add(FTableSnapshotRow<RowType>{ Change.Hash, Change.Row });
+                    ++Next->NumRows;
+                }
+                else
+                {
+                    const int32 Index = Bucket->IndexOfByPredicate([&Change](const FTableSnapshotRow<RowType>& Entry) { return Entry.Row.Get() == Change.Row.Get(); });
+                    if (Index != INDEX_NONE)
+                    {
+                        Bucket->RemoveAtSwap(Index, 1, EAllowShrinking::No);
+                        --Next->NumRows;
+                    }
+                }
+            }
+            Next->Buckets[BucketIndex] = MoveTemp(Bucket);
+        }
+        Pending.Reset();
+
+        if (Next->NumRows > Next->Buckets.Num() * MaxRowsPerBucket)
+        {
+            Next = Rebucket(*Next, Next->Buckets.Num() * 2);
+        }
+        Next->CountRowsBefore();
+
+        TSharedPtr<const FTableSnapshot<RowType>> Retired[2];
+        {
+            FWriteScopeLock Lock(CurrentLock);
+            Retired[0] = MoveTemp(Current);
+            Current = MoveTemp(Next);
+            if (!bDeferVisible)
+            {
+                Retired[1] = MoveTemp(Visible);
+                Visible = Current;
+            }
+        }
+        // Retired versions are released outside the lock, they are only freed here if no reader pins them
+    }
+
+private:
+    /** Changes of a published version the game thread has not made visible yet */
+    struct FUnseenVersion
+    {
+        uint64 Epoch;
+        TArray<FTableSnapshotChange<RowType>> Changes;
+    };
+
+    static TSharedPtr<FTableSnapshot<RowType>> MakeSnapshot(uint64 Epoch, int32 NumBuckets)
+    {
+        TSharedPtr<FTableSnapshot<RowType>> Snapshot = MakeShared<FTableSnapshot<RowType>>();
+        Snapshot->Epoch = Epoch;
+        const TSharedPtr<const FTableSnapshotBucket<RowType>> Empty = MakeShared<FTableSnapshotBucket<RowType>>();
+        Snapshot->Buckets.Init(Empty, NumBuckets);
+        Snapshot->RowsBefore.Init(0, NumBuckets);
+        return Snapshot;
+    }
+
+    /** Copy of Source spread over NumBuckets buckets, with the same epoch and rows */
+    static TSharedPtr<FTableSnapshot<RowType>> Rebucket(const FTableSnapshot<RowType>& Source, int32 NumBuckets)
+    {
+        TArray<TSharedPtr<FTableSnapshotBucket<RowType>>> NewBuckets;
+        NewBuckets.Reserve(NumBuckets);
+        for (int32 Index = 0; Index < NumBuckets; ++Index)
+        {
+            NewBuckets.Add(MakeShared<FTableSnapshotBucket<RowType>>());
+        }
+        for (const TSharedPtr<const FTableSnapshotBucket<RowType>>& Bucket : Source.Buckets)
+        {
+            for (const FTableSnapshotRow<RowType>& Entry : *Bucket)
+            {
+                NewBuckets[Entry.Hash & (NumBuckets - 1)]->Add(Entry);
+            }
+        }
+
+        TSharedPtr<FTableSnapshot<RowType>> Snapshot = MakeShared<FTableSnapshot<RowType>>();
+        Snapshot->Epoch = Source.Epoch;
+        Snapshot->NumRows = Source.NumRows;
+        Snapshot->Buckets.Reserve(NumBuckets);
+        for (TSharedPtr<FTableSnapshotBucket<RowType>>& Bucket : NewBuckets)
+        {
+            Snapshot->Buckets.Add(MoveTemp(Bucket));
+        }
+        return Snapshot;
+    }
+
+    /** Changes recorded since the last Publish, in the order they were made */
+    TArray<FTableSnapshotChange<RowType>> Pending;
+
+    /** Published while visibility is deferred and not visible yet, oldest first. Filled by Publish, drained by MakeVisible */
+    TArray<FUnseenVersion> UnseenVersions;
+    FCriticalSection UnseenVersionsLock;
+
+    FVisibleChangesHandler VisibleChangesHandler;
+
+    /** Guards the Current and Visible pointers only, it is held for a pointer copy */
+    mutable FRWLock CurrentLock;
+    TSharedPtr<const FTableSnapshot<RowType>> Current;
+    TSharedPtr<const FTableSnapshot<RowType>> Visible;
+
+    /** Set once before diffs are applied off the game thread */
+    bool bDeferVisible = false;
+};
@@ -1,6 +1,7 @@
 #pragma once
 #include "CoreMinimal.h"
 #include "IUniqueIndex.h"
+#include "WithBsatn.h"
 
 /* ============================================================================ *
  *  UniqueIndex.h (2025-05-28)
@@ -48,7 +49,7 @@ public:
      *
      * @param Row  Shared pointer to the row being added.
      */
-    virtual void AddRow(TSharedPtr<RowType> Row) override
+    virtual void AddRow(const TSharedPtr<RowType>& Row) override
     {
         // Extract the unique key from the row.
         const ColType Key = GetKey(*Row);
@@ -63,13 +64,17 @@ public:
      *
      * @param Row  Shared pointer to the row being removed.
      */
-    virtual void RemoveRow(TSharedPtr<RowType> Row) override
+    virtual void RemoveRow(const TSharedPtr<RowType>& Row) override
     {
         // Extract the unique key from the row.
         const ColType Key = GetKey(*Row);
 
-        // Remove the entry with this key from the map.
-        int32 Removed = Rows.Remove(Key);
+        // Remove the entry only if it still maps to this row, another row may have taken over the value.
+        const TSharedPtr<RowType>* Found = Rows.Find(Key);
+        if (Found && *Found == Row)
+        {
+            Rows.Remove(Key);
+        }
     }
 
 
@@ -117,12 +122,12 @@ public:
 };
 
 /**
- * Computes a hash for a byte array using CRC32.
+ * Computes a hash for a byte array using HashRowBytes.
  *
  * @param Bytes  The byte array to hash.
  * @return       32-bit hash value.
  */
 FORCEINLINE uint32 GetTypeHash(const TArray<uint8>& Bytes)
 {
-    return FCrc::MemCrc32(Bytes.GetData(), Bytes.Num());
+    return HashRowBytes(Bytes);
 }
@@ -1,17 +1,115 @@
 #pragma once
 #include "CoreMinimal.h"
+#include "Hash/xxhash.h"
 
-/** Wrapper holding a row and its BSATN serialized bytes */
+/** Row bytes of a whole row list, shared by every row decoded from it */
+using FRowBytesArena = TSharedPtr<const TArray<uint8>>;
+
+/**
+ * Hash of serialized row bytes, XXH3 folded to 32 bits.
+ * Rows are hashed once on the decode thread and the hash travels with the row bytes, so cache lookups never rehash.
+ */
+FORCEINLINE uint32 HashRowBytes(TArrayView<const uint8> Bytes)
+{
+    const uint64 Hash = FXxHash64::HashBuffer(Bytes.GetData(), Bytes.Num()).Hash;
+    return static_cast<uint32>(Hash ^ (Hash >> 32));
+}
+
+/** Borrowed row bytes and their hash, used to look up cache entries without copying the bytes */
+struct FRowBytesView
+{
+    TArrayView<const uint8> Bytes;
+    uint32 Hash;
+
+    explicit FRowBytesView(TArrayView<const uint8> InBytes)
+        : Bytes(InBytes), Hash(HashRowBytes(InBytes)) {
+    }
+    FRowBytesView(TArrayView<const uint8> InBytes, uint32 InHash)
+        : Bytes(InBytes), Hash(InHash) {
+    }
+};
+
+/** Owned cache key: serialized row bytes plus their precomputed hash */
+struct FRowKey
+{
+    TArray<uint8> Bytes;
+    uint32 Hash = 0;
+
+    FRowKey() = default;
+    explicit FRowKey(const TArray<uint8>& InBytes)
+        : Bytes(InBytes), Hash(HashRowBytes(InBytes)) {
+    }
+    explicit FRowKey(const FRowBytesView& View)
+        : Bytes(View.Bytes.GetData(), View.Bytes.Num()), Hash(View.Hash) {
+    }
+
+    friend uint32 GetTypeHash(const FRowKey& Key) { return Key.Hash; }
+
+    friend bool operator==(const FRowKey& A, const FRowKey& B)
+    {
+        return A.Hash == B.Hash && A.Bytes == B.Bytes;
+    }
+    friend bool operator==(const FRowKey& A, const FRowBytesView& B)
+    {
+        return A.Hash == B.Hash && A.Bytes.Num() == B.Bytes.Num() && FMemory::Memcmp(A.Bytes.GetData(), B.Bytes.GetData(), B.Bytes.Num()) == 0;
+    }
+};
+
+/** Wrapper holding a row, a view of its BSATN serialized bytes and its cache key */
 template<typename RowType>
 struct FWithBsatn
 {
-    /** Serialized BSATN bytes for this row */
-    TArray<uint8> Bsatn;
+    /** Bytes of the row list this row was decoded from, kept alive by every row of the list */
+    FRowBytesArena Arena;
+    /** Position of this row's serialized bytes in Arena */
+    int32 Offset = 0;
+    int32 Length = 0;
+    /**
+     * Bytes the cache keys this row on: the serialized primary key for tables that declare one,
+     * otherwise the row bytes themselves. Assigned by SetKey where the row is decoded.
+     */
+    FRowBytesArena KeyArena;
+    int32 KeyOffset = 0;
+    int32 KeyLength = 0;
+    /** HashRowBytes of the key bytes */
+    uint32 Hash = 0;
     /** Deserialized row value */
     RowType Row;
 
     FWithBsatn() = default;
+    FWithBsatn(const FRowBytesArena& InArena, int32 InOffset, int32 InLength, RowType&& InRow)
+        : Arena(InArena), Offset(InOffset), Length(InLength), Row(MoveTemp(InRow)) {
+    }
+    /** Standalone row holding its own copy of the bytes, keyed on them */
     FWithBsatn(const TArray<uint8>& InBsatn, const RowType& InRow)
-        : Bsatn(InBsatn), Row(InRow) {
+        : Arena(MakeShared<TArray<uint8>>(InBsatn)), Offset(0), Length(InBsatn.Num()), Row(InRow) {
+        SetKey(Arena, 0, Length);
+    }
+
+    /** Serialized BSATN bytes for this row */
+    TArrayView<const uint8> GetBsatn() const
+    {
+        return Arena.IsValid() ? TArrayView<const uint8>(Arena->GetData() + Offset, Length) : TArrayView<const uint8>();
+    }
+
+    /** Point the cache key at InKeyLength bytes of InKeyArena and hash them */
+    void SetKey(const FRowBytesArena& InKeyArena, int32 InKeyOffset, int32 InKeyLength)
+    {
+        KeyArena = InKeyArena;
+        KeyOffset = InKeyOffset;
+        KeyLength = InKeyLength;
+        Hash = HashRowBytes(GetKeyBytes());
+    }
+
+    /** Cache lookup key for this row, carrying the precomputed hash */
+    FRowBytesView GetKey() const
+    {
+        return FRowBytesView(GetKeyBytes(), Hash);
+    }
+
+private:
+    TArrayView<const uint8> GetKeyBytes() const
+    {
+        return KeyArena.IsValid() ? TArrayView<const uint8>(KeyArena->GetData() + KeyOffset, KeyLength) : TArrayView<const uint8>();
     }
-};
\ No newline at end of file
+};
@@ -97,60 +97,102 @@ public:
 
     FORCEINLINE bool IsCallReducer() const { return Tag == EClientMessageTag::CallReducer; }
 
-    FORCEINLINE FCallReducerType GetAsCallReducer() const
+    FORCEINLINE const FCallReducerType& GetAsCallReducer() const&
     {
         ensureMsgf(IsCallReducer(), TEXT("MessageData does not hold CallReducer!"));
         return MessageData.Get<FCallReducerType>();
     }
 
+    FORCEINLINE FCallReducerType GetAsCallReducer() &&
+    {
+        ensureMsgf(IsCallReducer(), TEXT("MessageData does not hold CallReducer!"));
+        return MoveTemp(MessageData.Get<FCallReducerType>());
+    }
+
     FORCEINLINE bool IsSubscribe() const { return Tag == EClientMessageTag::Subscribe; }
 
-    FORCEINLINE FSubscribeType GetAsSubscribe() const
+    FORCEINLINE const FSubscribeType& GetAsSubscribe() const&
     {
         ensureMsgf(IsSubscribe(), TEXT("MessageData does not hold Subscribe!"));
         return MessageData.Get<FSubscribeType>();
     }
 
+    FORCEINLINE FSubscribeType GetAsSubscribe() &&
+    {
+        ensureMsgf(IsSubscribe(), TEXT("MessageData does not hold Subscribe!"));
+        return MoveTemp(MessageData.Get<FSubscribeType>());
+    }
+
     FORCEINLINE bool IsOneOffQuery() const { return Tag == EClientMessageTag::OneOffQuery; }
 
-    FORCEINLINE FOneOffQueryType GetAsOneOffQuery() const
+    FORCEINLINE const FOneOffQueryType& GetAsOneOffQuery() const&
     {
         ensureMsgf(IsOneOffQuery(), TEXT("MessageData does not hold OneOffQuery!"));
         return MessageData.Get<FOneOffQueryType>();
     }
 
+    FORCEINLINE FOneOffQueryType GetAsOneOffQuery() &&
+    {
+        ensureMsgf(IsOneOffQuery(), TEXT("MessageData does not hold OneOffQuery!"));
+        return MoveTemp(MessageData.Get<FOneOffQueryType>());
+    }
+
     FORCEINLINE bool IsSubscribeSingle() const { return Tag == EClientMessageTag::SubscribeSingle; }
 
-    FORCEINLINE FSubscribeSingleType GetAsSubscribeSingle() const
+    FORCEINLINE const FSubscribeSingleType& GetAsSubscribeSingle() const&
     {
         ensureMsgf(IsSubscribeSingle(), TEXT("MessageData does not hold SubscribeSingle!"));
         return MessageData.Get<FSubscribeSingleType>();
     }
 
+    FORCEINLINE FSubscribeSingleType GetAsSubscribeSingle() &&
+    {
+        ensureMsgf(IsSubscribeSingle(), TEXT("MessageData does not hold SubscribeSingle!"));
+        return MoveTemp(MessageData.Get<FSubscribeSingleType>());
+    }
+
     FORCEINLINE bool IsSubscribeMulti() const { return Tag == EClientMessageTag::SubscribeMulti; }
 
-    FORCEINLINE FSubscribeMultiType GetAsSubscribeMulti() const
+    FORCEINLINE const FSubscribeMultiType& GetAsSubscribeMulti() const&
     {
         ensureMsgf(IsSubscribeMulti(), TEXT("MessageData does not hold SubscribeMulti!"));
         return MessageData.Get<FSubscribeMultiType>();
     }
 
+    FORCEINLINE FSubscribeMultiType GetAsSubscribeMulti() &&
+    {
+        ensureMsgf(IsSubscribeMulti(), TEXT("MessageData does not hold SubscribeMulti!"));
+        return MoveTemp(MessageData.Get<FSubscribeMultiType>());
+    }
+
     FORCEINLINE bool IsUnsubscribe() const { return Tag == EClientMessageTag::Unsubscribe; }
 
-    FORCEINLINE FUnsubscribeType GetAsUnsubscribe() const
+    FORCEINLINE const FUnsubscribeType& GetAsUnsubscribe() const&
     {
         ensureMsgf(IsUnsubscribe(), TEXT("MessageData does not hold Unsubscribe!"));
         return MessageData.Get<FUnsubscribeType>();
     }
 
+    FORCEINLINE FUnsubscribeType GetAsUnsubscribe() &&
+    {
+        ensureMsgf(IsUnsubscribe(), TEXT("MessageData does not hold Unsubscribe!"));
+        return MoveTemp(MessageData.Get<FUnsubscribeType>());
+    }
+
     FORCEINLINE bool IsUnsubscribeMulti() const { return Tag == EClientMessageTag::UnsubscribeMulti; }
 
-    FORCEINLINE FUnsubscribeMultiType GetAsUnsubscribeMulti() const
+    FORCEINLINE const FUnsubscribeMultiType& GetAsUnsubscribeMulti() const&
     {
         ensureMsgf(IsUnsubscribeMulti(), TEXT("MessageData does not hold UnsubscribeMulti!"));
         return MessageData.Get<FUnsubscribeMultiType>();
     }
 
+    FORCEINLINE FUnsubscribeMultiType GetAsUnsubscribeMulti() &&
+    {
+        ensureMsgf(IsUnsubscribeMulti(), TEXT("MessageData does not hold UnsubscribeMulti!"));
+        return MoveTemp(MessageData.Get<FUnsubscribeMultiType>());
+    }
+
     // Inline equality operators
     FORCEINLINE bool operator==(const FClientMessageType& Other) const
     {
@@ -55,28 +55,46 @@ public:
 
     FORCEINLINE bool IsUncompressed() const { return Tag == ECompressableQueryUpdateTag::Uncompressed; }
 
-    FORCEINLINE FQueryUpdateType GetAsUncompressed() const
+    FORCEINLINE const FQueryUpdateType& GetAsUncompressed() const&
     {
         ensureMsgf(IsUncompressed(), TEXT("MessageData does not hold Uncompressed!"));
         return MessageData.Get<FQueryUpdateType>();
     }
 
+    FORCEINLINE FQueryUpdateType GetAsUncompressed() &&
+    {
+        ensureMsgf(IsUncompressed(), TEXT("MessageData does not hold Uncompressed!"));
+        return MoveTemp(MessageData.Get<FQueryUpdateType>());
+    }
+
     FORCEINLINE bool IsBrotli() const { return Tag == ECompressableQueryUpdateTag::Brotli; }
 
-    FORCEINLINE TArray<uint8> GetAsBrotli() const
+    FORCEINLINE const TArray<uint8>& GetAsBrotli() const&
     {
         ensureMsgf(IsBrotli(), TEXT("MessageData does not hold Brotli!"));
         return MessageData.Get<TArray<uint8>>();
     }
 
+    FORCEINLINE TArray<uint8> GetAsBrotli() &&
+    {
+        ensureMsgf(IsBrotli(), TEXT("MessageData does not hold Brotli!"));
+        return MoveTemp(MessageData.Get<TArray<uint8>>());
+    }
+
     FORCEINLINE bool IsGzip() const { return Tag == ECompressableQueryUpdateTag::Gzip; }
 
-    FORCEINLINE TArray<uint8> GetAsGzip() const
+    FORCEINLINE const TArray<uint8>& GetAsGzip() const&
     {
         ensureMsgf(IsGzip(), TEXT("MessageData does not hold Gzip!"));
         return MessageData.Get<TArray<uint8>>();
     }
 
+    FORCEINLINE TArray<uint8> GetAsGzip() &&
+    {
+        ensureMsgf(IsGzip(), TEXT("MessageData does not hold Gzip!"));
+        return MoveTemp(MessageData.Get<TArray<uint8>>());
+    }
+
     // Inline equality operators
     FORCEINLINE bool operator==(const FCompressableQueryUpdateType& Other) const
     {
@@ -45,20 +45,32 @@ public:
 
     FORCEINLINE bool IsFixedSize() const { return Tag == ERowSizeHintTag::FixedSize; }
 
-    FORCEINLINE uint16 GetAsFixedSize() const
+    FORCEINLINE const uint16& GetAsFixedSize() const&
     {
         ensureMsgf(IsFixedSize(), TEXT("MessageData does not hold FixedSize!"));
         return MessageData.Get<uint16>();
     }
 
+    FORCEINLINE uint16 GetAsFixedSize() &&
+    {
+        ensureMsgf(IsFixedSize(), TEXT("MessageData does not hold FixedSize!"));
+        return MoveTemp(MessageData.Get<uint16>());
+    }
+
     FORCEINLINE bool IsRowOffsets() const { return Tag == ERowSizeHintTag::RowOffsets; }
 
-    FORCEINLINE TArray<uint64> GetAsRowOffsets() const
+    FORCEINLINE const TArray<uint64>& GetAsRowOffsets() const&
     {
         ensureMsgf(IsRowOffsets(), TEXT("MessageData does not hold RowOffsets!"));
         return MessageData.Get<TArray<uint64>>();
     }
 
+    FORCEINLINE TArray<uint64> GetAsRowOffsets() &&
+    {
+        ensureMsgf(IsRowOffsets(), TEXT("MessageData does not hold RowOffsets!"));
+        return MoveTemp(MessageData.Get<TArray<uint64>>());
+    }
+
     // Inline equality operators
     FORCEINLINE bool operator==(const FRowSizeHintType& Other) const
     {
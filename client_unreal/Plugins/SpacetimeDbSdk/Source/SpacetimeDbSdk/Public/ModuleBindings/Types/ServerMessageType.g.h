@@ -127,84 +127,144 @@ public:
 
     FORCEINLINE bool IsInitialSubscription() const { return Tag == EServerMessageTag::InitialSubscription; }
 
-    FORCEINLINE FInitialSubscriptionType GetAsInitialSubscription() const
+    FORCEINLINE const FInitialSubscriptionType& GetAsInitialSubscription() const&
     {
         ensureMsgf(IsInitialSubscription(), TEXT("MessageData does not hold InitialSubscription!"));
         return MessageData.Get<FInitialSubscriptionType>();
     }
 
+    FORCEINLINE FInitialSubscriptionType GetAsInitialSubscription() &&
+    {
+        ensureMsgf(IsInitialSubscription(), TEXT("MessageData does not hold InitialSubscription!"));
+        return MoveTemp(MessageData.Get<FInitialSubscriptionType>());
+    }
+
     FORCEINLINE bool IsTransactionUpdate() const { return Tag == EServerMessageTag::TransactionUpdate; }
 
-    FORCEINLINE FTransactionUpdateType GetAsTransactionUpdate() const
+    FORCEINLINE const FTransactionUpdateType& GetAsTransactionUpdate() const&
     {
         ensureMsgf(IsTransactionUpdate(), TEXT("MessageData does not hold TransactionUpdate!"));
         return MessageData.Get<FTransactionUpdateType>();
     }
 
+    FORCEINLINE FTransactionUpdateType GetAsTransactionUpdate() &&
+    {
+        ensureMsgf(IsTransactionUpdate(), TEXT("MessageData does not hold TransactionUpdate!"));
+        return MoveTemp(MessageData.Get<FTransactionUpdateType>());
+    }
+
     FORCEINLINE bool IsTransactionUpdateLight() const { return Tag == EServerMessageTag::TransactionUpdateLight; }
 
-    FORCEINLINE FTransactionUpdateLightType GetAsTransactionUpdateLight() const
+    FORCEINLINE const FTransactionUpdateLightType& GetAsTransactionUpdateLight() const&
     {
         ensureMsgf(IsTransactionUpdateLight(), TEXT("MessageData does not hold TransactionUpdateLight!"));
         return MessageData.Get<FTransactionUpdateLightType>();
     }
 
+    FORCEINLINE FTransactionUpdateLightType GetAsTransactionUpdateLight() &&
+    {
+        ensureMsgf(IsTransactionUpdateLight(), TEXT("MessageData does not hold TransactionUpdateLight!"));
+        return MoveTemp(MessageData.Get<FTransactionUpdateLightType>());
+    }
+
     FORCEINLINE bool IsIdentityToken() const { return Tag == EServerMessageTag::IdentityToken; }
 
-    FORCEINLINE FIdentityTokenType GetAsIdentityToken() const
+    FORCEINLINE const FIdentityTokenType& GetAsIdentityToken() const&
     {
         ensureMsgf(IsIdentityToken(), TEXT("MessageData does not hold IdentityToken!"));
         return MessageData.Get<FIdentityTokenType>();
     }
 
+    FORCEINLINE FIdentityTokenType GetAsIdentityToken() &&
+    {
+        ensureMsgf(IsIdentityToken(), TEXT("MessageData does not hold IdentityToken!"));
+        return MoveTemp(MessageData.Get<FIdentityTokenType>());
+    }
+
     FORCEINLINE bool IsOneOffQueryResponse() const { return Tag == EServerMessageTag::OneOffQueryResponse; }
 
-    FORCEINLINE FOneOffQueryResponseType GetAsOneOffQueryResponse() const
+    FORCEINLINE const FOneOffQueryResponseType& GetAsOneOffQueryResponse() const&
     {
         ensureMsgf(IsOneOffQueryResponse(), TEXT("MessageData does not hold OneOffQueryResponse!"));
         return MessageData.Get<FOneOffQueryResponseType>();
     }
 
+    FORCEINLINE FOneOffQueryResponseType GetAsOneOffQueryResponse() &&
+    {
+        ensureMsgf(IsOneOffQueryResponse(), TEXT("MessageData does not hold OneOffQueryResponse!"));
+        return MoveTemp(MessageData.Get<FOneOffQueryResponseType>());
+    }
+
     FORCEINLINE bool IsSubscribeApplied() const { return Tag == EServerMessageTag::SubscribeApplied; }
 
-    FORCEINLINE FSubscribeAppliedType GetAsSubscribeApplied() const
+    FORCEINLINE const FSubscribeAppliedType& GetAsSubscribeApplied() const&
     {
         ensureMsgf(IsSubscribeApplied(), TEXT("MessageData does not hold SubscribeApplied!"));
         return MessageData.Get<FSubscribeAppliedType>();
     }
 
+    FORCEINLINE FSubscribeAppliedType GetAsSubscribeApplied() &&
+    {
+        ensureMsgf(IsSubscribeApplied(), TEXT("MessageData does not hold SubscribeApplied!"));
+        return MoveTemp(MessageData.Get<FSubscribeAppliedType>());
+    }
+
     FORCEINLINE bool IsUnsubscribeApplied() const { return Tag == EServerMessageTag::UnsubscribeApplied; }
 
-    FORCEINLINE FUnsubscribeAppliedType GetAsUnsubscribeApplied() const
+    FORCEINLINE const FUnsubscribeAppliedType& GetAsUnsubscribeApplied() const&
     {
         ensureMsgf(IsUnsubscribeApplied(), TEXT("MessageData does not hold UnsubscribeApplied!"));
         return MessageData.Get<FUnsubscribeAppliedType>();
     }
 
+    FORCEINLINE FUnsubscribeAppliedType GetAsUnsubscribeApplied() &&
+    {
+        ensureMsgf(IsUnsubscribeApplied(), TEXT("MessageData does not hold UnsubscribeApplied!"));
+        return MoveTemp(MessageData.Get<FUnsubscribeAppliedType>());
+    }
+
     FORCEINLINE bool IsSubscriptionError() const { return Tag == EServerMessageTag::SubscriptionError; }
 
-    FORCEINLINE FSubscriptionErrorType GetAsSubscriptionError() const
+    FORCEINLINE const FSubscriptionErrorType& GetAsSubscriptionError() const&
     {
         ensureMsgf(IsSubscriptionError(), TEXT("MessageData does not hold SubscriptionError!"));
         return MessageData.Get<FSubscriptionErrorType>();
     }
 
+    FORCEINLINE FSubscriptionErrorType GetAsSubscriptionError() &&
+    {
+        ensureMsgf(IsSubscriptionError(), TEXT("MessageData does not hold SubscriptionError!"));
+        return MoveTemp(MessageData.Get<FSubscriptionErrorType>());
+    }
+
     FORCEINLINE bool IsSubscribeMultiApplied() const { return Tag == EServerMessageTag::SubscribeMultiApplied; }
 
-    FORCEINLINE FSubscribeMultiAppliedType GetAsSubscribeMultiApplied() const
+    FORCEINLINE const FSubscribeMultiAppliedType& GetAsSubscribeMultiApplied() const&
     {
         ensureMsgf(IsSubscribeMultiApplied(), TEXT("MessageData does not hold SubscribeMultiApplied!"));
         return MessageData.Get<FSubscribeMultiAppliedType>();
     }
 
+    FORCEINLINE FSubscribeMultiAppliedType GetAsSubscribeMultiApplied() &&
+    {
+        ensureMsgf(IsSubscribeMultiApplied(), TEXT("MessageData does not hold SubscribeMultiApplied!"));
+        return MoveTemp(MessageData.Get<FSubscribeMultiAppliedType>());
+    }
+
     FORCEINLINE bool IsUnsubscribeMultiApplied() const { return Tag == EServerMessageTag::UnsubscribeMultiApplied; }
 
-    FORCEINLINE FUnsubscribeMultiAppliedType GetAsUnsubscribeMultiApplied() const
+    FORCEINLINE const FUnsubscribeMultiAppliedType& GetAsUnsubscribeMultiApplied() const&
     {
         ensureMsgf(IsUnsubscribeMultiApplied(), TEXT("MessageData does not hold UnsubscribeMultiApplied!"));
         return MessageData.Get<FUnsubscribeMultiAppliedType>();
     }
 
+    FORCEINLINE FUnsubscribeMultiAppliedType GetAsUnsubscribeMultiApplied() &&
+    {
+        ensureMsgf(IsUnsubscribeMultiApplied(), TEXT("MessageData does not hold UnsubscribeMultiApplied!"));
+        return MoveTemp(MessageData.Get<FUnsubscribeMultiAppliedType>());
+    }
+
     // Inline equality operators
     FORCEINLINE bool operator==(const FServerMessageType& Other) const
     {
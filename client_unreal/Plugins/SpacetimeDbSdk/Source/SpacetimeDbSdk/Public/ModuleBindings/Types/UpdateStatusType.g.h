@@ -56,28 +56,46 @@ public:
 
     FORCEINLINE bool IsCommitted() const { return Tag == EUpdateStatusTag::Committed; }
 
-    FORCEINLINE FDatabaseUpdateType GetAsCommitted() const
+    FORCEINLINE const FDatabaseUpdateType& GetAsCommitted() const&
     {
         ensureMsgf(IsCommitted(), TEXT("MessageData does not hold Committed!"));
         return MessageData.Get<FDatabaseUpdateType>();
     }
 
+    FORCEINLINE FDatabaseUpdateType GetAsCommitted() &&
+    {
+        ensureMsgf(IsCommitted(), TEXT("MessageData does not hold Committed!"));
+        return MoveTemp(MessageData.Get<FDatabaseUpdateType>());
+    }
+
     FORCEINLINE bool IsFailed() const { return Tag == EUpdateStatusTag::Failed; }
 
-    FORCEINLINE FString GetAsFailed() const
+    FORCEINLINE const FString& GetAsFailed() const&
     {
         ensureMsgf(IsFailed(), TEXT("MessageData does not hold Failed!"));
         return MessageData.Get<FString>();
     }
 
+    FORCEINLINE FString GetAsFailed() &&
+    {
+        ensureMsgf(IsFailed(), TEXT("MessageData does not hold Failed!"));
+        return MoveTemp(MessageData.Get<FString>());
+    }
+
     FORCEINLINE bool IsOutOfEnergy() const { return Tag == EUpdateStatusTag::OutOfEnergy; }
 
-    FORCEINLINE FSpacetimeDBUnit GetAsOutOfEnergy() const
+    FORCEINLINE const FSpacetimeDBUnit& GetAsOutOfEnergy() const&
     {
         ensureMsgf(IsOutOfEnergy(), TEXT("MessageData does not hold OutOfEnergy!"));
         return MessageData.Get<FSpacetimeDBUnit>();
     }
 
+    FORCEINLINE FSpacetimeDBUnit GetAsOutOfEnergy() &&
+    {
+        ensureMsgf(IsOutOfEnergy(), TEXT("MessageData does not hold OutOfEnergy!"));
+        return MoveTemp(MessageData.Get<FSpacetimeDBUnit>());
+    }
+
     // Inline equality operators
     FORCEINLINE bool operator==(const FUpdateStatusType& Other) const
     {
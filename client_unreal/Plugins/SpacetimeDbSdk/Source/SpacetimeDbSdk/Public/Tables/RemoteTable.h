@@ -22,14 +22,14 @@ protected:
 
     /**
      * Apply a diff to the local cache.
-     * @param InsertsRef Insert operations with BSATN encoded keys
+     * @param InsertsRef Insert operations with BSATN encoded keys, their rows are moved into the cache
      * @param DeletesRef Delete operations with BSATN encoded keys
      * @param ClientCache Cache instance for this table
      * @param InTableName Name of the table being updated
      */
     template<typename T>
     FTableAppliedDiff<T> BaseUpdate(
-        const TArray<FWithBsatn<T>>& InsertsRef,
+        TArray<FWithBsatn<T>>& InsertsRef,
         const TArray<FWithBsatn<T>>& DeletesRef,
         const TSharedPtr<UClientCache<T>>& ClientCache,
         const FString& InTableName
@@ -42,19 +42,7 @@ protected:
             return {};
         }
 
-        TArray<TPair<TArray<uint8>, T>> Inserts;
-        for (const FWithBsatn<T>& Insert : InsertsRef)
-        {
-            Inserts.Add({ Insert.Bsatn, Insert.Row });
-        }
-
-        TArray<TArray<uint8>> Deletes;
-        for (const FWithBsatn<T>& Delete : DeletesRef)
-        {
-            Deletes.Add(Delete.Bsatn);
-        }
-
-        // Forward to the shared client cache implementation
-        return ClientCache->ApplyDiff(InTableName, Inserts, Deletes);
+        // Forward to the shared client cache implementation, which reads the row bytes in place
+        return ClientCache->ApplyDiff(InTableName, MoveTemp(InsertsRef), DeletesRef);
     }
 };
\ No newline at end of file
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Connection/DbConnectionBase.h"
+
+#include "SpacetimeDBTestConnection.generated.h"
+
+/**
+ * Connection used by the automation tests. Applies every database update to the registered tables
+ * the way the generated UDbConnection does, so the tests drive the whole message pipeline.
+ */
+UCLASS()
+class SPACETIMEDBSDK_API UTestDbConnection : public UDbConnectionBase
+{
+	GENERATED_BODY()
+
+public:
+	/** Event context handed to the table delegates, of the type the tables were registered with. */
+	void* TableEventContext = nullptr;
+
+	/** Hooks called for each TransactionUpdate, in order, with the reducer name where the hook gets the event. */
+	TArray<FString> ReducerEventCalls;
+
+protected:
+	virtual void DbUpdate(const FDatabaseUpdateType& Update, const FSpacetimeDBEvent& Event) override
+	{
+		ReducerEventCalls.Add(TEXT("DbUpdate"));
+		ApplyRegisteredTableUpdates(Update, TableEventContext);
+	}
+
+	virtual void BeginReducerEvent(const FReducerEvent& Event) override
+	{
+		ReducerEventCalls.Add(TEXT("Begin ") + Event.ReducerCall.ReducerName);
+	}
+
+	virtual void EndReducerEvent() override
+	{
+		ReducerEventCalls.Add(TEXT("End"));
+	}
+
+	virtual void ReducerEvent(const FReducerEvent& Event) override
+	{
+		ReducerEventCalls.Add(TEXT("Reducer ") + Event.ReducerCall.ReducerName);
+	}
+
+	virtual void ReducerEventFailed(const FReducerEvent& Event, const FString ErrorMessage) override
+	{
+		ReducerEventCalls.Add(TEXT("Failed ") + ErrorMessage);
+	}
+};
@@ -584,17 +584,29 @@ public:
     FORCEINLINE bool IsInterval() const { return Tag == EScheduleAtTag::Interval; }
     FORCEINLINE bool IsTime()     const { return Tag == EScheduleAtTag::Time; }
 
-    FORCEINLINE FSpacetimeDBTimeDuration GetAsInterval() const
+    FORCEINLINE const FSpacetimeDBTimeDuration& GetAsInterval() const&
     {
         ensureMsgf(IsInterval(), TEXT("MessageData does not hold Interval!"));
         return Data.Get<FSpacetimeDBTimeDuration>();
     }
-    FORCEINLINE FSpacetimeDBTimestamp GetAsTime() const
+
+    FORCEINLINE FSpacetimeDBTimeDuration GetAsInterval() &&
+    {
+        ensureMsgf(IsInterval(), TEXT("MessageData does not hold Interval!"));
+        return MoveTemp(Data.Get<FSpacetimeDBTimeDuration>());
+    }
+    FORCEINLINE const FSpacetimeDBTimestamp& GetAsTime() const&
     {
         ensureMsgf(IsTime(), TEXT("MessageData does not hold Time!"));
         return Data.Get<FSpacetimeDBTimestamp>();
     }
 
+    FORCEINLINE FSpacetimeDBTimestamp GetAsTime() &&
+    {
+        ensureMsgf(IsTime(), TEXT("MessageData does not hold Time!"));
+        return MoveTemp(Data.Get<FSpacetimeDBTimestamp>());
+    }
+
     // Equality
     FORCEINLINE bool operator==(const FSpacetimeDBScheduleAt& Other) const
     {
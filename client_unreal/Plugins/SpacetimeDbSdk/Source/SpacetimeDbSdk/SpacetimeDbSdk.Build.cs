@@ -35,6 +35,9 @@ public class SpacetimeDbSdk : ModuleRules
 			);
 		
 		
+		// Streaming gzip inflate
+		AddEngineThirdPartyPrivateStaticDependencies(Target, "zlib");
+
 		DynamicallyLoadedModuleNames.AddRange(
 			new string[]
 			{
@@ -4,6 +4,7 @@
 #include "ModuleBindings/SpacetimeDBClient.g.h"
 #include "DBCache/WithBsatn.h"
 #include "BSATN/UEBSATNHelpers.h"
+#include "Connection/ReducerNameHash.h"
 #include "ModuleBindings/Tables/PlayerCharacterTable.g.h"
 #include "ModuleBindings/Tables/PlayerCharacterTable.g.h"
 #include "ModuleBindings/Tables/EntityTable.g.h"
@@ -11,47 +12,74 @@
 #include "ModuleBindings/Tables/PlayerTable.g.h"
 #include "ModuleBindings/Tables/PlayerTable.g.h"
 
-static FReducer DecodeReducer(const FReducerEvent& Event)
+static bool DecodeReducer(const FReducerEvent& Event, FReducer& OutReducer)
 {
     const FString& ReducerName = Event.ReducerCall.ReducerName;
 
-    if (ReducerName == TEXT("connect"))
+    // Switch on the name hash, the full name is still compared in case an unknown reducer collides
+    switch (UE::SpacetimeDB::ReducerNameHash(ReducerName))
     {
-        FConnectArgs Args = UE::SpacetimeDB::Deserialize<FConnectArgs>(Event.ReducerCall.Args);
-        return FReducer::Connect(Args);
-    }
+    case UE::SpacetimeDB::ReducerNameHash(TEXT("connect")):
+        if (ReducerName.Equals(TEXT("connect"), ESearchCase::CaseSensitive))
+        {
+            OutReducer = FReducer::Connect(UE::SpacetimeDB::Deserialize<FConnectArgs>(Event.ReducerCall.Args));
+            return true;
+        }
+        break;
 
-    if (ReducerName == TEXT("disconnect"))
-    {
-        FDisconnectArgs Args = UE::SpacetimeDB::Deserialize<FDisconnectArgs>(Event.ReducerCall.Args);
-        return FReducer::Disconnect(Args);
-    }
+    case UE::SpacetimeDB::ReducerNameHash(TEXT("disconnect")):
+        if (ReducerName.Equals(TEXT("disconnect"), ESearchCase::CaseSensitive))
+        {
+            OutReducer = FReducer::Disconnect(UE::SpacetimeDB::Deserialize<FDisconnectArgs>(Event.ReducerCall.Args));
+            return true;
+        }
+        break;
 
-    if (ReducerName == TEXT("enter_game"))
-    {
-        FEnterGameArgs Args = UE::SpacetimeDB::Deserialize<FEnterGameArgs>(Event.ReducerCall.Args);
-        return FReducer::EnterGame(Args);
-    }
+    case UE::SpacetimeDB::ReducerNameHash(TEXT("enter_game")):
+        if (ReducerName.Equals(TEXT("enter_game"), ESearchCase::CaseSensitive))
+        {
+            OutReducer = FReducer::EnterGame(UE::SpacetimeDB::Deserialize<FEnterGameArgs>(Event.ReducerCall.Args));
+            return true;
+        }
+        break;
 
-    if (ReducerName == TEXT("move_all_players"))
-    {
-        FMoveAllPlayersArgs Args = UE::SpacetimeDB::Deserialize<FMoveAllPlayersArgs>(Event.ReducerCall.Args);
-        return FReducer::MoveAllPlayers(Args);
-    }
+    case UE::SpacetimeDB::ReducerNameHash(TEXT("move_all_players")):
+        if (ReducerName.Equals(TEXT("move_all_players"), ESearchCase::CaseSensitive))
+        {
+            OutReducer = FReducer::MoveAllPlayers(UE::SpacetimeDB::Deserialize<FMoveAllPlayersArgs>(Event.ReducerCall.Args));
+            return true;
+        }
+        break;
 
-    if (ReducerName == TEXT("respawn"))
-    {
-        FRespawnArgs Args = UE::SpacetimeDB::Deserialize<FRespawnArgs>(Event.ReducerCall.Args);
-        return FReducer::Respawn(Args);
-    }
+    case UE::SpacetimeDB::ReducerNameHash(TEXT("player_spawned")):
+        if (ReducerName.Equals(TEXT("player_spawned"), ESearchCase::CaseSensitive))
+        {
+            OutReducer = FReducer::PlayerSpawned(UE::SpacetimeDB::Deserialize<FPlayerSpawnedArgs>(Event.ReducerCall.Args));
+            return true;
+        }
+        break;
 
-    if (ReducerName == TEXT("update_player_input"))
-    {
-        FUpdatePlayerInputArgs Args = UE::SpacetimeDB::Deserialize<FUpdatePlayerInputArgs>(Event.ReducerCall.Args);
-        return FReducer::UpdatePlayerInput(Args);
+    case UE::SpacetimeDB::ReducerNameHash(TEXT("respawn")):
+        if (ReducerName.Equals(TEXT("respawn"), ESearchCase::CaseSensitive))
+        {
+            OutReducer = FReducer::Respawn(UE::SpacetimeDB::Deserialize<FRespawnArgs>(Event.ReducerCall.Args));
+            return true;
+        }
+        break;
+
+    case UE::SpacetimeDB::ReducerNameHash(TEXT("update_player_input")):
+        if (ReducerName.Equals(TEXT("update_player_input"), ESearchCase::CaseSensitive))
+        {
+            OutReducer = FReducer::UpdatePlayerInput(UE::SpacetimeDB::Deserialize<FUpdatePlayerInputArgs>(Event.ReducerCall.Args));
+            return true;
+        }
+        break;
+
+    default:
+        break;
     }
 
-    return FReducer();
+    return false;
 }
 
 UDbConnection::UDbConnection(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
@@ -371,80 +399,100 @@ void UDbConnection::OnUnhandledReducerErrorHandler(const FReducerEventContext& C
     }
 }
 
+void UDbConnection::BeginReducerEvent(const FReducerEvent& Event)
+{
+    CurrentReducer.Reset();
+    FReducer Decoded;
+    if (DecodeReducer(Event, Decoded))
+    {
+        CurrentReducer.Emplace(MoveTemp(Decoded));
+    }
+}
+
+void UDbConnection::EndReducerEvent()
+{
+    CurrentReducer.Reset();
+}
+
 void UDbConnection::ReducerEvent(const FReducerEvent& Event)
 {
     if (!Reducers) { return; }
 
-    FReducer DecodedReducer = DecodeReducer(Event);
-
     FClientUnrealReducerEvent ReducerEvent;
     ReducerEvent.CallerConnectionId = Event.CallerConnectionId;
     ReducerEvent.CallerIdentity     = Event.CallerIdentity;
     ReducerEvent.EnergyConsumed     = Event.EnergyConsumed;
     ReducerEvent.Status             = Event.Status;
     ReducerEvent.Timestamp          = Event.Timestamp;
-    ReducerEvent.Reducer            = DecodedReducer;
 
-    FReducerEventContext Context(this, ReducerEvent);
+    // Reuse the args decoded for this transaction's table update
+    if (CurrentReducer.IsSet())
+    {
+        ReducerEvent.Reducer = CurrentReducer.GetValue();
+    }
+    else if (!DecodeReducer(Event, ReducerEvent.Reducer))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Unknown reducer: %s"), *Event.ReducerCall.ReducerName);
+        return;
+    }
 
-    // Use hardcoded string matching for reducer dispatching
-    const FString& ReducerName = Event.ReducerCall.ReducerName;
+    FReducerEventContext Context(this, ReducerEvent);
 
-    if (ReducerName == TEXT("connect"))
+    switch (ReducerEvent.Reducer.Tag)
+    {
+    case EReducerTag::Connect:
     {
-        FConnectArgs Args = ReducerEvent.Reducer.GetAsConnect();
         UConnectReducer* Reducer = NewObject<UConnectReducer>();
         Reducers->InvokeConnect(Context, Reducer);
-        return;
+        break;
     }
-    if (ReducerName == TEXT("disconnect"))
+    case EReducerTag::Disconnect:
     {
-        FDisconnectArgs Args = ReducerEvent.Reducer.GetAsDisconnect();
         UDisconnectReducer* Reducer = NewObject<UDisconnectReducer>();
         Reducers->InvokeDisconnect(Context, Reducer);
-        return;
+        break;
     }
-    if (ReducerName == TEXT("enter_game"))
+    case EReducerTag::EnterGame:
     {
-        FEnterGameArgs Args = ReducerEvent.Reducer.GetAsEnterGame();
+        const FEnterGameArgs& Args = ReducerEvent.Reducer.GetAsEnterGame();
         UEnterGameReducer* Reducer = NewObject<UEnterGameReducer>();
         Reducer->Name = Args.Name;
         Reducers->InvokeEnterGame(Context, Reducer);
-        return;
+        break;
     }
-    if (ReducerName == TEXT("move_all_players"))
+    case EReducerTag::MoveAllPlayers:
     {
-        FMoveAllPlayersArgs Args = ReducerEvent.Reducer.GetAsMoveAllPlayers();
+        const FMoveAllPlayersArgs& Args = ReducerEvent.Reducer.GetAsMoveAllPlayers();
         UMoveAllPlayersReducer* Reducer = NewObject<UMoveAllPlayersReducer>();
         Reducer->Timer = Args.Timer;
         Reducers->InvokeMoveAllPlayers(Context, Reducer);
-        return;
+        break;
     }
-    if (ReducerName == TEXT("player_spawned"))
+    case EReducerTag::PlayerSpawned:
     {
-        FPlayerSpawnedArgs Args = ReducerEvent.Reducer.GetAsPlayerSpawned();
+        const FPlayerSpawnedArgs& Args = ReducerEvent.Reducer.GetAsPlayerSpawned();
         UPlayerSpawnedReducer* Reducer = NewObject<UPlayerSpawnedReducer>();
         Reducer->CharacterId = Args.CharacterId;
         Reducers->InvokePlayerSpawned(Context, Reducer);
-        return;
+        break;
     }
-    if (ReducerName == TEXT("respawn"))
+    case EReducerTag::Respawn:
     {
-        FRespawnArgs Args = ReducerEvent.Reducer.GetAsRespawn();
         URespawnReducer* Reducer = NewObject<URespawnReducer>();
         Reducers->InvokeRespawn(Context, Reducer);
-        return;
+        break;
     }
-    if (ReducerName == TEXT("update_player_input"))
+    case EReducerTag::UpdatePlayerInput:
     {
-        FUpdatePlayerInputArgs Args = ReducerEvent.Reducer.GetAsUpdatePlayerInput();
+        const FUpdatePlayerInputArgs& Args = ReducerEvent.Reducer.GetAsUpdatePlayerInput();
         UUpdatePlayerInputReducer* Reducer = NewObject<UUpdatePlayerInputReducer>();
         Reducer->NewTransform = Args.NewTransform;
         Reducers->InvokeUpdatePlayerInput(Context, Reducer);
-        return;
+        break;
+    }
+    default:
+        break;
     }
-
-    UE_LOG(LogTemp, Warning, TEXT("Unknown reducer: %s"), *ReducerName);
 }
 
 void UDbConnection::ReducerEventFailed(const FReducerEvent& Event, const FString ErrorMessage)
@@ -558,6 +606,14 @@ UDbConnectionBuilder* UDbConnectionBuilder::WithCompression(const ESpacetimeDBCo
 {
 	return Cast<UDbConnectionBuilder>(WithCompressionBase(InCompression));
 }
+UDbConnectionBuilder* UDbConnectionBuilder::WithDecodeWorkerCount(int32 InWorkerCount)
+{
+	return Cast<UDbConnectionBuilder>(WithDecodeWorkerCountBase(InWorkerCount));
+}
+UDbConnectionBuilder* UDbConnectionBuilder::WithApplyThread(bool bUseApplyThread)
+{
+	return Cast<UDbConnectionBuilder>(WithApplyThreadBase(bUseApplyThread));
+}
 UDbConnectionBuilder* UDbConnectionBuilder::OnConnect(FOnConnectDelegate Callback)
 {
 	OnConnectDelegateInternal = Callback;
@@ -618,9 +674,16 @@ void UDbConnection::DbUpdate(const FDatabaseUpdateType& Update, const FSpacetime
     {
     case ESpacetimeDBEventTag::Reducer:
     {
-        FReducerEvent ReducerEvent = Event.GetAsReducer();
-        FReducer Reducer = DecodeReducer(ReducerEvent);
-        BaseEvent = FClientUnrealEvent::Reducer(Reducer);
+        if (CurrentReducer.IsSet())
+        {
+            BaseEvent = FClientUnrealEvent::Reducer(CurrentReducer.GetValue());
+        }
+        else
+        {
+            FReducer Reducer;
+            DecodeReducer(Event.GetAsReducer(), Reducer);
+            BaseEvent = FClientUnrealEvent::Reducer(Reducer);
+        }
         break;
     }
 
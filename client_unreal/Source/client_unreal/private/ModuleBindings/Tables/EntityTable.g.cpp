@@ -16,6 +16,15 @@ void UEntityTable::PostInitialize()
     EntityTable->AddUniqueConstraint<uint32>("entity_id", [](const FEntityType& Row) -> const uint32& {
         return Row.EntityId; });
 
+    // Register an ordered index named "entity_id" on the EntityTable for primary key range queries.
+    EntityTable->AddMultiKeyBTreeIndex<TTuple<uint32>>(
+        TEXT("entity_id"),
+        [](const FEntityType& Row)
+        {
+            return MakeTuple(Row.EntityId);
+        }
+    );
+
     EntityId = NewObject<UEntityEntityIdUniqueIndex>(this);
     EntityId->SetCache(EntityTable);
 
@@ -45,3 +54,73 @@ TArray<FEntityType> UEntityTable::Iter() const
 {
     return GetAllRowsFromTable<FEntityType>(Data, TableName);
 }
+
+TArray<FEntityType> UEntityTable::IterPage(int32 Cursor, int32 PageSize, int32& NextCursor, bool& bHasMore) const
+{
+    return GetRowPageFromTable<FEntityType>(Data, TableName, Cursor, PageSize, NextCursor, bHasMore);
+}
+
+void UEntityTable::ForEach(TFunctionRef<void(const FEntityType&)> Visit) const
+{
+    ForEachRowInTable<FEntityType>(Data, TableName, Visit);
+}
+
+const FTableCache<FEntityType>& UEntityTable::Rows() const
+{
+    TSharedPtr<const FTableCache<FEntityType>> EntityTable = Data->GetTable(TableName);
+    if (!EntityTable.IsValid() || !ensureMsgf(!EntityTable->ReadsThroughSnapshots(), TEXT("%s is owned by the apply thread, read it through PinSnapshot"), *TableName))
+    {
+        static const FTableCache<FEntityType> Empty;
+        return Empty;
+    }
+    return *EntityTable;
+}
+
+void UEntityTable::EnableSnapshots()
+{
+    Data->GetOrAdd(TableName)->EnableSnapshots();
+}
+
+TSharedPtr<const FTableSnapshot<FEntityType>> UEntityTable::PinSnapshot() const
+{
+    TSharedPtr<const FTableCache<FEntityType>> EntityTable = Data->GetTable(TableName);
+    return EntityTable.IsValid() ? EntityTable->PinSnapshot() : nullptr;
+}
+
+TSharedPtr<FTableSnapshotPublisher<FEntityType>> UEntityTable::GetSnapshotPublisher() const
+{
+    TSharedPtr<const FTableCache<FEntityType>> EntityTable = Data->GetTable(TableName);
+    return EntityTable.IsValid() ? EntityTable->SnapshotPublisher : nullptr;
+}
+
+void UEntityTable::EnableSpatialIndex(float CellSize)
+{
+    TSharedPtr<FTableCache<FEntityType>> EntityTable = Data->GetOrAdd(TableName);
+    if (!EntityTable->FindSpatialIndex(SpatialIndexName))
+    {
+        EntityTable->AddSpatialIndex(SpatialIndexName, CellSize, [](const FEntityType& Row)
+        {
+            return GetTransformLocation(Row.Transform);
+        });
+    }
+}
+
+TArray<FEntityType> UEntityTable::FindInRadius(FVector Center, float Radius) const
+{
+    return FindInRadiusFromTable<FEntityType>(Data, TableName, SpatialIndexName, Center, Radius);
+}
+
+TArray<FEntityType> UEntityTable::FindInBox(FBox Box) const
+{
+    return FindInBoxFromTable<FEntityType>(Data, TableName, SpatialIndexName, Box);
+}
+
+TArray<FEntityType> UEntityTable::FindNearest(FVector Center, int32 Count, float MaxRadius) const
+{
+    return FindNearestFromTable<FEntityType>(Data, TableName, SpatialIndexName, Center, Count, MaxRadius);
+}
+
+const FSpatialHashGrid<FEntityType>* UEntityTable::GetSpatialIndex() const
+{
+    return FindSpatialIndexInTable<FEntityType>(Data, TableName, SpatialIndexName);
+}
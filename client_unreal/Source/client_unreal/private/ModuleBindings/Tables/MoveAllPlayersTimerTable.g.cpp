@@ -16,6 +16,15 @@ void UMoveAllPlayersTimerTable::PostInitialize()
     MoveAllPlayersTimerTable->AddUniqueConstraint<uint64>("scheduled_id", [](const FMoveAllPlayersTimerType& Row) -> const uint64& {
         return Row.ScheduledId; });
 
+    // Register an ordered index named "scheduled_id" on the MoveAllPlayersTimerTable for primary key range queries.
+    MoveAllPlayersTimerTable->AddMultiKeyBTreeIndex<TTuple<uint64>>(
+        TEXT("scheduled_id"),
+        [](const FMoveAllPlayersTimerType& Row)
+        {
+            return MakeTuple(Row.ScheduledId);
+        }
+    );
+
     ScheduledId = NewObject<UMoveAllPlayersTimerScheduledIdUniqueIndex>(this);
     ScheduledId->SetCache(MoveAllPlayersTimerTable);
 
@@ -45,3 +54,41 @@ TArray<FMoveAllPlayersTimerType> UMoveAllPlayersTimerTable::Iter() const
 {
     return GetAllRowsFromTable<FMoveAllPlayersTimerType>(Data, TableName);
 }
+
+TArray<FMoveAllPlayersTimerType> UMoveAllPlayersTimerTable::IterPage(int32 Cursor, int32 PageSize, int32& NextCursor, bool& bHasMore) const
+{
+    return GetRowPageFromTable<FMoveAllPlayersTimerType>(Data, TableName, Cursor, PageSize, NextCursor, bHasMore);
+}
+
+void UMoveAllPlayersTimerTable::ForEach(TFunctionRef<void(const FMoveAllPlayersTimerType&)> Visit) const
+{
+    ForEachRowInTable<FMoveAllPlayersTimerType>(Data, TableName, Visit);
+}
+
+const FTableCache<FMoveAllPlayersTimerType>& UMoveAllPlayersTimerTable::Rows() const
+{
+    TSharedPtr<const FTableCache<FMoveAllPlayersTimerType>> MoveAllPlayersTimerTable = Data->GetTable(TableName);
+    if (!MoveAllPlayersTimerTable.IsValid() || !ensureMsgf(!MoveAllPlayersTimerTable->ReadsThroughSnapshots(), TEXT("%s is owned by the apply thread, read it through PinSnapshot"), *TableName))
+    {
+        static const FTableCache<FMoveAllPlayersTimerType> Empty;
+        return Empty;
+    }
+    return *MoveAllPlayersTimerTable;
+}
+
+void UMoveAllPlayersTimerTable::EnableSnapshots()
+{
+    Data->GetOrAdd(TableName)->EnableSnapshots();
+}
+
+TSharedPtr<const FTableSnapshot<FMoveAllPlayersTimerType>> UMoveAllPlayersTimerTable::PinSnapshot() const
+{
+    TSharedPtr<const FTableCache<FMoveAllPlayersTimerType>> MoveAllPlayersTimerTable = Data->GetTable(TableName);
+    return MoveAllPlayersTimerTable.IsValid() ? MoveAllPlayersTimerTable->PinSnapshot() : nullptr;
+}
+
+TSharedPtr<FTableSnapshotPublisher<FMoveAllPlayersTimerType>> UMoveAllPlayersTimerTable::GetSnapshotPublisher() const
+{
+    TSharedPtr<const FTableCache<FMoveAllPlayersTimerType>> MoveAllPlayersTimerTable = Data->GetTable(TableName);
+    return MoveAllPlayersTimerTable.IsValid() ? MoveAllPlayersTimerTable->SnapshotPublisher : nullptr;
+}
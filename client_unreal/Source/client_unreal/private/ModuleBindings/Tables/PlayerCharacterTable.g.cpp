@@ -16,6 +16,15 @@ void UPlayerCharacterTable::PostInitialize()
     PlayerCharacterTable->AddUniqueConstraint<uint32>("character_id", [](const FPlayerCharacterType& Row) -> const uint32& {
         return Row.CharacterId; });
 
+    // Register an ordered index named "character_id" on the PlayerCharacterTable for primary key range queries.
+    PlayerCharacterTable->AddMultiKeyBTreeIndex<TTuple<uint32>>(
+        TEXT("character_id"),
+        [](const FPlayerCharacterType& Row)
+        {
+            return MakeTuple(Row.CharacterId);
+        }
+    );
+
     CharacterId = NewObject<UPlayerCharacterCharacterIdUniqueIndex>(this);
     CharacterId->SetCache(PlayerCharacterTable);
 
@@ -26,6 +35,11 @@ void UPlayerCharacterTable::PostInitialize()
         {
             // This tuple is stored in the B-Tree index for fast composite key lookups.
             return MakeTuple(Row.EntityId);
+        },
+        [](const FPlayerCharacterType& A, const FPlayerCharacterType& B)
+        {
+            // Rows sharing a key are kept ordered by primary key.
+            return A.CharacterId < B.CharacterId;
         }
     );
 
@@ -39,6 +53,11 @@ void UPlayerCharacterTable::PostInitialize()
         {
             // This tuple is stored in the B-Tree index for fast composite key lookups.
             return MakeTuple(Row.PlayerId);
+        },
+        [](const FPlayerCharacterType& A, const FPlayerCharacterType& B)
+        {
+            // Rows sharing a key are kept ordered by primary key.
+            return A.CharacterId < B.CharacterId;
         }
     );
 
@@ -71,3 +90,73 @@ TArray<FPlayerCharacterType> UPlayerCharacterTable::Iter() const
 {
     return GetAllRowsFromTable<FPlayerCharacterType>(Data, TableName);
 }
+
+TArray<FPlayerCharacterType> UPlayerCharacterTable::IterPage(int32 Cursor, int32 PageSize, int32& NextCursor, bool& bHasMore) const
+{
+    return GetRowPageFromTable<FPlayerCharacterType>(Data, TableName, Cursor, PageSize, NextCursor, bHasMore);
+}
+
+void UPlayerCharacterTable::ForEach(TFunctionRef<void(const FPlayerCharacterType&)> Visit) const
+{
+    ForEachRowInTable<FPlayerCharacterType>(Data, TableName, Visit);
+}
+
+const FTableCache<FPlayerCharacterType>& UPlayerCharacterTable::Rows() const
+{
+    TSharedPtr<const FTableCache<FPlayerCharacterType>> PlayerCharacterTable = Data->GetTable(TableName);
+    if (!PlayerCharacterTable.IsValid() || !ensureMsgf(!PlayerCharacterTable->ReadsThroughSnapshots(), TEXT("%s is owned by the apply thread, read it through PinSnapshot"), *TableName))
+    {
+        static const FTableCache<FPlayerCharacterType> Empty;
+        return Empty;
+    }
+    return *PlayerCharacterTable;
+}
+
+void UPlayerCharacterTable::EnableSnapshots()
+{
+    Data->GetOrAdd(TableName)->EnableSnapshots();
+}
+
+TSharedPtr<const FTableSnapshot<FPlayerCharacterType>> UPlayerCharacterTable::PinSnapshot() const
+{
+    TSharedPtr<const FTableCache<FPlayerCharacterType>> PlayerCharacterTable = Data->GetTable(TableName);
+    return PlayerCharacterTable.IsValid() ? PlayerCharacterTable->PinSnapshot() : nullptr;
+}
+
+TSharedPtr<FTableSnapshotPublisher<FPlayerCharacterType>> UPlayerCharacterTable::GetSnapshotPublisher() const
+{
+    TSharedPtr<const FTableCache<FPlayerCharacterType>> PlayerCharacterTable = Data->GetTable(TableName);
+    return PlayerCharacterTable.IsValid() ? PlayerCharacterTable->SnapshotPublisher : nullptr;
+}
+
+void UPlayerCharacterTable::EnableSpatialIndex(float CellSize)
+{
+    TSharedPtr<FTableCache<FPlayerCharacterType>> PlayerCharacterTable = Data->GetOrAdd(TableName);
+    if (!PlayerCharacterTable->FindSpatialIndex(SpatialIndexName))
+    {
+        PlayerCharacterTable->AddSpatialIndex(SpatialIndexName, CellSize, [](const FPlayerCharacterType& Row)
+        {
+            return GetTransformLocation(Row.Transform);
+        });
+    }
+}
+
+TArray<FPlayerCharacterType> UPlayerCharacterTable::FindInRadius(FVector Center, float Radius) const
+{
+    return FindInRadiusFromTable<FPlayerCharacterType>(Data, TableName, SpatialIndexName, Center, Radius);
+}
+
+TArray<FPlayerCharacterType> UPlayerCharacterTable::FindInBox(FBox Box) const
+{
+    return FindInBoxFromTable<FPlayerCharacterType>(Data, TableName, SpatialIndexName, Box);
+}
+
+TArray<FPlayerCharacterType> UPlayerCharacterTable::FindNearest(FVector Center, int32 Count, float MaxRadius) const
+{
+    return FindNearestFromTable<FPlayerCharacterType>(Data, TableName, SpatialIndexName, Center, Count, MaxRadius);
+}
+
+const FSpatialHashGrid<FPlayerCharacterType>* UPlayerCharacterTable::GetSpatialIndex() const
+{
+    return FindSpatialIndexInTable<FPlayerCharacterType>(Data, TableName, SpatialIndexName);
+}
@@ -50,3 +50,41 @@ TArray<FPlayerType> UPlayerTable::Iter() const
 {
     return GetAllRowsFromTable<FPlayerType>(Data, TableName);
 }
+
+TArray<FPlayerType> UPlayerTable::IterPage(int32 Cursor, int32 PageSize, int32& NextCursor, bool& bHasMore) const
+{
+    return GetRowPageFromTable<FPlayerType>(Data, TableName, Cursor, PageSize, NextCursor, bHasMore);
+}
+
+void UPlayerTable::ForEach(TFunctionRef<void(const FPlayerType&)> Visit) const
+{
+    ForEachRowInTable<FPlayerType>(Data, TableName, Visit);
+}
+
+const FTableCache<FPlayerType>& UPlayerTable::Rows() const
+{
+    TSharedPtr<const FTableCache<FPlayerType>> PlayerTable = Data->GetTable(TableName);
+    if (!PlayerTable.IsValid() || !ensureMsgf(!PlayerTable->ReadsThroughSnapshots(), TEXT("%s is owned by the apply thread, read it through PinSnapshot"), *TableName))
+    {
+        static const FTableCache<FPlayerType> Empty;
+        return Empty;
+    }
+    return *PlayerTable;
+}
+
+void UPlayerTable::EnableSnapshots()
+{
+    Data->GetOrAdd(TableName)->EnableSnapshots();
+}
+
+TSharedPtr<const FTableSnapshot<FPlayerType>> UPlayerTable::PinSnapshot() const
+{
+    TSharedPtr<const FTableCache<FPlayerType>> PlayerTable = Data->GetTable(TableName);
+    return PlayerTable.IsValid() ? PlayerTable->PinSnapshot() : nullptr;
+}
+
+TSharedPtr<FTableSnapshotPublisher<FPlayerType>> UPlayerTable::GetSnapshotPublisher() const
+{
+    TSharedPtr<const FTableCache<FPlayerType>> PlayerTable = Data->GetTable(TableName);
+    return PlayerTable.IsValid() ? PlayerTable->SnapshotPublisher : nullptr;
+}
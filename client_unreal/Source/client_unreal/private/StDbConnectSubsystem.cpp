@@ -81,7 +81,8 @@ void UStDbConnectSubsystem::BuildAndStartConnection()
 		->WithModuleName(ModuleName)
 		->OnConnect(ConnectDelegate)
 		->OnDisconnect(DisconnectDelegate)
-		->OnConnectError(ConnectErrorDelegate);
+		->OnConnectError(ConnectErrorDelegate)
+		->WithApplyThread(bUseApplyThread);
 
 	if (!Token.IsEmpty())
 	{
@@ -89,6 +90,10 @@ void UStDbConnectSubsystem::BuildAndStartConnection()
 	}
 
 	Conn = Builder->Build();
+	if (Conn)
+	{
+		Conn->SetOutgoingSendRate(InputSendRateHz);
+	}
 }
 
 void UStDbConnectSubsystem::HandleConnect(UDbConnection* InConn, FSpacetimeDBIdentity Identity, const FString& Token)
@@ -112,6 +117,9 @@ void UStDbConnectSubsystem::HandleConnect(UDbConnection* InConn, FSpacetimeDBIde
 		// Entity table events - optional minimal logging
 		Conn->Db->Entity->OnUpdate.AddDynamic(this, &UStDbConnectSubsystem::OnEntityUpdate);
 		Conn->Db->Entity->OnDelete.AddDynamic(this, &UStDbConnectSubsystem::OnEntityDelete);
+
+		// Proximity queries on entities, kept up to date as diffs are applied
+		Conn->Db->Entity->EnableSpatialIndex(EntitySpatialCellSize);
 	}
 
 	FOnSubscriptionApplied AppliedDelegate;
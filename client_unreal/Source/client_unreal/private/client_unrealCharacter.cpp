@@ -174,6 +174,21 @@ void Aclient_unrealCharacter::SendTransformToServer()
 	Transform.Pitch = Rotation.Pitch;
 	Transform.Roll = Rotation.Roll;
 
-	// Send to server
-	ConnectSubsystem->Conn->Reducers->UpdatePlayerInput(Transform);
+	// Input fires many times per frame, only the latest transform is sent at the connection's send rate
+	static const FString UpdatePlayerInputReducer(TEXT("update_player_input"));
+	const float LocationThreshold = LocationSendThreshold;
+	const float RotationThreshold = RotationSendThreshold;
+	ConnectSubsystem->Conn->CallReducerCoalesced<FUpdatePlayerInputArgs>(
+		UpdatePlayerInputReducer, GetUniqueID(), FUpdatePlayerInputArgs(Transform), ConnectSubsystem->Conn->SetReducerFlags,
+		[LocationThreshold, RotationThreshold](const FUpdatePlayerInputArgs& LastSent, const FUpdatePlayerInputArgs& Next)
+		{
+			const FTransformType& A = LastSent.NewTransform;
+			const FTransformType& B = Next.NewTransform;
+			const float MovedSquared = FMath::Square(B.X - A.X) + FMath::Square(B.Y - A.Y) + FMath::Square(B.Z - A.Z);
+			const double Turned = FMath::Max3(
+				FMath::Abs(FRotator::NormalizeAxis(B.Yaw - A.Yaw)),
+				FMath::Abs(FRotator::NormalizeAxis(B.Pitch - A.Pitch)),
+				FMath::Abs(FRotator::NormalizeAxis(B.Roll - A.Roll)));
+			return MovedSquared >= FMath::Square(LocationThreshold) || Turned >= RotationThreshold;
+		});
 }
@@ -145,12 +145,18 @@ public:
     }
 
     FORCEINLINE bool IsConnect() const { return Tag == EReducerTag::Connect; }
-    FORCEINLINE FConnectArgs GetAsConnect() const
+    FORCEINLINE const FConnectArgs& GetAsConnect() const&
     {
         ensureMsgf(IsConnect(), TEXT("Reducer does not hold Connect!"));
         return Data.Get<FConnectArgs>();
     }
 
+    FORCEINLINE FConnectArgs GetAsConnect() &&
+    {
+        ensureMsgf(IsConnect(), TEXT("Reducer does not hold Connect!"));
+        return MoveTemp(Data.Get<FConnectArgs>());
+    }
+
     static FReducer Disconnect(const FDisconnectArgs& Value)
     {
         FReducer Out;
@@ -161,12 +167,18 @@ public:
     }
 
     FORCEINLINE bool IsDisconnect() const { return Tag == EReducerTag::Disconnect; }
-    FORCEINLINE FDisconnectArgs GetAsDisconnect() const
+    FORCEINLINE const FDisconnectArgs& GetAsDisconnect() const&
     {
         ensureMsgf(IsDisconnect(), TEXT("Reducer does not hold Disconnect!"));
         return Data.Get<FDisconnectArgs>();
     }
 
+    FORCEINLINE FDisconnectArgs GetAsDisconnect() &&
+    {
+        ensureMsgf(IsDisconnect(), TEXT("Reducer does not hold Disconnect!"));
+        return MoveTemp(Data.Get<FDisconnectArgs>());
+    }
+
     static FReducer EnterGame(const FEnterGameArgs& Value)
     {
         FReducer Out;
@@ -177,12 +189,18 @@ public:
     }
 
     FORCEINLINE bool IsEnterGame() const { return Tag == EReducerTag::EnterGame; }
-    FORCEINLINE FEnterGameArgs GetAsEnterGame() const
+    FORCEINLINE const FEnterGameArgs& GetAsEnterGame() const&
     {
         ensureMsgf(IsEnterGame(), TEXT("Reducer does not hold EnterGame!"));
         return Data.Get<FEnterGameArgs>();
     }
 
+    FORCEINLINE FEnterGameArgs GetAsEnterGame() &&
+    {
+        ensureMsgf(IsEnterGame(), TEXT("Reducer does not hold EnterGame!"));
+        return MoveTemp(Data.Get<FEnterGameArgs>());
+    }
+
     static FReducer MoveAllPlayers(const FMoveAllPlayersArgs& Value)
     {
         FReducer Out;
@@ -193,12 +211,18 @@ public:
     }
 
     FORCEINLINE bool IsMoveAllPlayers() const { return Tag == EReducerTag::MoveAllPlayers; }
-    FORCEINLINE FMoveAllPlayersArgs GetAsMoveAllPlayers() const
+    FORCEINLINE const FMoveAllPlayersArgs& GetAsMoveAllPlayers() const&
     {
         ensureMsgf(IsMoveAllPlayers(), TEXT("Reducer does not hold MoveAllPlayers!"));
         return Data.Get<FMoveAllPlayersArgs>();
     }
 
+    FORCEINLINE FMoveAllPlayersArgs GetAsMoveAllPlayers() &&
+    {
+        ensureMsgf(IsMoveAllPlayers(), TEXT("Reducer does not hold MoveAllPlayers!"));
+        return MoveTemp(Data.Get<FMoveAllPlayersArgs>());
+    }
+
     static FReducer PlayerSpawned(const FPlayerSpawnedArgs& Value)
     {
         FReducer Out;
@@ -209,12 +233,18 @@ public:
     }
 
     FORCEINLINE bool IsPlayerSpawned() const { return Tag == EReducerTag::PlayerSpawned; }
-    FORCEINLINE FPlayerSpawnedArgs GetAsPlayerSpawned() const
+    FORCEINLINE const FPlayerSpawnedArgs& GetAsPlayerSpawned() const&
     {
         ensureMsgf(IsPlayerSpawned(), TEXT("Reducer does not hold PlayerSpawned!"));
         return Data.Get<FPlayerSpawnedArgs>();
     }
 
+    FORCEINLINE FPlayerSpawnedArgs GetAsPlayerSpawned() &&
+    {
+        ensureMsgf(IsPlayerSpawned(), TEXT("Reducer does not hold PlayerSpawned!"));
+        return MoveTemp(Data.Get<FPlayerSpawnedArgs>());
+    }
+
     static FReducer Respawn(const FRespawnArgs& Value)
     {
         FReducer Out;
@@ -225,12 +255,18 @@ public:
     }
 
     FORCEINLINE bool IsRespawn() const { return Tag == EReducerTag::Respawn; }
-    FORCEINLINE FRespawnArgs GetAsRespawn() const
+    FORCEINLINE const FRespawnArgs& GetAsRespawn() const&
     {
         ensureMsgf(IsRespawn(), TEXT("Reducer does not hold Respawn!"));
         return Data.Get<FRespawnArgs>();
     }
 
+    FORCEINLINE FRespawnArgs GetAsRespawn() &&
+    {
+        ensureMsgf(IsRespawn(), TEXT("Reducer does not hold Respawn!"));
+        return MoveTemp(Data.Get<FRespawnArgs>());
+    }
+
     static FReducer UpdatePlayerInput(const FUpdatePlayerInputArgs& Value)
     {
         FReducer Out;
@@ -241,12 +277,18 @@ public:
     }
 
     FORCEINLINE bool IsUpdatePlayerInput() const { return Tag == EReducerTag::UpdatePlayerInput; }
-    FORCEINLINE FUpdatePlayerInputArgs GetAsUpdatePlayerInput() const
+    FORCEINLINE const FUpdatePlayerInputArgs& GetAsUpdatePlayerInput() const&
     {
         ensureMsgf(IsUpdatePlayerInput(), TEXT("Reducer does not hold UpdatePlayerInput!"));
         return Data.Get<FUpdatePlayerInputArgs>();
     }
 
+    FORCEINLINE FUpdatePlayerInputArgs GetAsUpdatePlayerInput() &&
+    {
+        ensureMsgf(IsUpdatePlayerInput(), TEXT("Reducer does not hold UpdatePlayerInput!"));
+        return MoveTemp(Data.Get<FUpdatePlayerInputArgs>());
+    }
+
     FORCEINLINE bool operator==(const FReducer& Other) const
     {
         if (Tag != Other.Tag || ReducerId != Other.ReducerId || RequestId != Other.RequestId || ReducerName != Other.ReducerName) return false;
@@ -260,6 +302,8 @@ public:
             return GetAsEnterGame() == Other.GetAsEnterGame();
         case EReducerTag::MoveAllPlayers:
             return GetAsMoveAllPlayers() == Other.GetAsMoveAllPlayers();
+        case EReducerTag::PlayerSpawned:
+            return GetAsPlayerSpawned() == Other.GetAsPlayerSpawned();
         case EReducerTag::Respawn:
             return GetAsRespawn() == Other.GetAsRespawn();
         case EReducerTag::UpdatePlayerInput:
@@ -462,47 +506,83 @@ struct CLIENT_UNREAL_API FClientUnrealEvent
 	}
 
 	FORCEINLINE bool IsReducer() const { return Tag == ESpacetimeDBEventTag::Reducer; }
-	FORCEINLINE FReducer GetAsReducer() const
+	FORCEINLINE const FReducer& GetAsReducer() const&
 	{
 		ensureMsgf(IsReducer(), TEXT("MessageData does not hold Reducer!"));
 		return MessageData.Get<FReducer>();
 	}
 
+	FORCEINLINE FReducer GetAsReducer() &&
+	{
+		ensureMsgf(IsReducer(), TEXT("MessageData does not hold Reducer!"));
+		return MoveTemp(MessageData.Get<FReducer>());
+	}
+
 	FORCEINLINE bool IsSubscribeApplied() const { return Tag == ESpacetimeDBEventTag::SubscribeApplied; }
-	FORCEINLINE FSpacetimeDBUnit GetAsSubscribeApplied() const
+	FORCEINLINE const FSpacetimeDBUnit& GetAsSubscribeApplied() const&
 	{
 		ensureMsgf(IsSubscribeApplied(), TEXT("MessageData does not hold SubscribeApplied!"));
 		return MessageData.Get<FSpacetimeDBUnit>();
 	}
 
+	FORCEINLINE FSpacetimeDBUnit GetAsSubscribeApplied() &&
+	{
+		ensureMsgf(IsSubscribeApplied(), TEXT("MessageData does not hold SubscribeApplied!"));
+		return MoveTemp(MessageData.Get<FSpacetimeDBUnit>());
+	}
+
 	FORCEINLINE bool IsUnsubscribeApplied() const { return Tag == ESpacetimeDBEventTag::UnsubscribeApplied; }
-	FORCEINLINE FSpacetimeDBUnit GetAsUnsubscribeApplied() const
+	FORCEINLINE const FSpacetimeDBUnit& GetAsUnsubscribeApplied() const&
 	{
 		ensureMsgf(IsUnsubscribeApplied(), TEXT("MessageData does not hold UnsubscribeApplied!"));
 		return MessageData.Get<FSpacetimeDBUnit>();
 	}
 
+	FORCEINLINE FSpacetimeDBUnit GetAsUnsubscribeApplied() &&
+	{
+		ensureMsgf(IsUnsubscribeApplied(), TEXT("MessageData does not hold UnsubscribeApplied!"));
+		return MoveTemp(MessageData.Get<FSpacetimeDBUnit>());
+	}
+
 	FORCEINLINE bool IsDisconnected() const { return Tag == ESpacetimeDBEventTag::Disconnected; }
-	FORCEINLINE FSpacetimeDBUnit GetAsDisconnected() const
+	FORCEINLINE const FSpacetimeDBUnit& GetAsDisconnected() const&
 	{
 		ensureMsgf(IsDisconnected(), TEXT("MessageData does not hold Disconnected!"));
 		return MessageData.Get<FSpacetimeDBUnit>();
 	}
 
+	FORCEINLINE FSpacetimeDBUnit GetAsDisconnected() &&
+	{
+		ensureMsgf(IsDisconnected(), TEXT("MessageData does not hold Disconnected!"));
+		return MoveTemp(MessageData.Get<FSpacetimeDBUnit>());
+	}
+
 	FORCEINLINE bool IsSubscribeError() const { return Tag == ESpacetimeDBEventTag::SubscribeError; }
-	FORCEINLINE FString GetAsSubscribeError() const
+	FORCEINLINE const FString& GetAsSubscribeError() const&
 	{
 		ensureMsgf(IsSubscribeError(), TEXT("MessageData does not hold SubscribeError!"));
 		return MessageData.Get<FString>();
 	}
 
+	FORCEINLINE FString GetAsSubscribeError() &&
+	{
+		ensureMsgf(IsSubscribeError(), TEXT("MessageData does not hold SubscribeError!"));
+		return MoveTemp(MessageData.Get<FString>());
+	}
+
 	FORCEINLINE bool IsUnknownTransaction() const { return Tag == ESpacetimeDBEventTag::UnknownTransaction; }
-	FORCEINLINE FSpacetimeDBUnit GetAsUnknownTransaction() const
+	FORCEINLINE const FSpacetimeDBUnit& GetAsUnknownTransaction() const&
 	{
 		ensureMsgf(IsUnknownTransaction(), TEXT("MessageData does not hold UnknownTransaction!"));
 		return MessageData.Get<FSpacetimeDBUnit>();
 	}
 
+	FORCEINLINE FSpacetimeDBUnit GetAsUnknownTransaction() &&
+	{
+		ensureMsgf(IsUnknownTransaction(), TEXT("MessageData does not hold UnknownTransaction!"));
+		return MoveTemp(MessageData.Get<FSpacetimeDBUnit>());
+	}
+
 	FORCEINLINE bool operator==(const FClientUnrealEvent& Other) const
 	{
 		if (Tag != Other.Tag) return false;
@@ -919,6 +999,10 @@ public:
     UFUNCTION(BlueprintCallable, Category = "SpacetimeDB")
     UDbConnectionBuilder* WithCompression(const ESpacetimeDBCompression& InCompression);
     UFUNCTION(BlueprintCallable, Category = "SpacetimeDB")
+    UDbConnectionBuilder* WithDecodeWorkerCount(int32 InWorkerCount);
+    UFUNCTION(BlueprintCallable, Category = "SpacetimeDB")
+    UDbConnectionBuilder* WithApplyThread(bool bUseApplyThread);
+    UFUNCTION(BlueprintCallable, Category = "SpacetimeDB")
     UDbConnectionBuilder* OnConnect(FOnConnectDelegate Callback);
     UFUNCTION(BlueprintCallable, Category = "SpacetimeDB")
     UDbConnectionBuilder* OnConnectError(FOnConnectErrorDelegate Callback);
@@ -986,10 +1070,18 @@ protected:
     // Override the DbConnectionBase methods to handle updates and events
     virtual void DbUpdate(const FDatabaseUpdateType& Update, const FSpacetimeDBEvent& Event) override;
     
+    // Decode the reducer args once per transaction
+    virtual void BeginReducerEvent(const FReducerEvent& Event) override;
+    virtual void EndReducerEvent() override;
+
     // Override the reducer event handler to dispatch events to the appropriate reducers
     virtual void ReducerEvent(const FReducerEvent& Event) override;
     
     // Override the reducer event failed handler
     virtual void ReducerEventFailed(const FReducerEvent& Event, const FString ErrorMessage) override;
+
+private:
+    // Reducer decoded by BeginReducerEvent, shared by DbUpdate and ReducerEvent
+    TOptional<FReducer> CurrentReducer;
 };
 
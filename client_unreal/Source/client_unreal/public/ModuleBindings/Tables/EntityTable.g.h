@@ -40,6 +40,18 @@ public:
         return EntityIdIndexHelper.FindUniqueIndex(Key);
     }
 
+    /**
+     * Finds every Entity whose entityid is in [Lower, Upper), ordered by entityid.
+     * @param Lower The first entityid of the range.
+     * @param Upper The entityid ending the range, excluded.
+     * @return The matching FEntityType rows.
+     */
+    // NOTE: Not exposed to Blueprint because uint32 types are not Blueprint-compatible
+    TArray<FEntityType> FilterRange(uint32 Lower, uint32 Upper) const
+    {
+        return EntityIdIndexHelper.FindUniqueIndexRange(Lower, Upper);
+    }
+
     // A public setter to provide the cache to the helper after construction
     // This is a common pattern when the cache might be created or provided by another system.
     void SetCache(TSharedPtr<const FTableCache<FEntityType>> InEntityCache)
@@ -60,6 +72,10 @@ public:
 
     void PostInitialize();
 
+    /** Primary key column, the client cache keys rows on it */
+    using FPrimaryKey = uint32;
+    static const uint32& GetPrimaryKey(const FEntityType& Row) { return Row.EntityId; }
+
     /** Update function for entities table*/
     FTableAppliedDiff<FEntityType> Update(TArray<FWithBsatn<FEntityType>> InsertsRef, TArray<FWithBsatn<FEntityType>> DeletesRef);
 
@@ -71,6 +87,47 @@ public:
     UFUNCTION(BlueprintCallable, Category = "SpacetimeDB")
     TArray<FEntityType> Iter() const;
 
+    /** Return at most PageSize subscribed rows starting at Cursor, 0 for the first page. NextCursor is where the next page starts, bHasMore is set when rows remain */
+    UFUNCTION(BlueprintCallable, Category = "SpacetimeDB")
+    TArray<FEntityType> IterPage(int32 Cursor, int32 PageSize, int32& NextCursor, bool& bHasMore) const;
+
+    /** Visit every subscribed row in the cache in place, without copying it */
+    void ForEach(TFunctionRef<void(const FEntityType&)> Visit) const;
+
+    /**
+     * Subscribed rows in the cache for range-based for loops, read in place and valid until the next applied diff.
+     * Empty when diffs are applied on the apply thread, read PinSnapshot instead.
+     */
+    const FTableCache<FEntityType>& Rows() const;
+
+    /** Start publishing snapshots of the subscribed rows for worker threads, the first one holds the rows already in the cache */
+    void EnableSnapshots();
+
+    /** Latest snapshot of the subscribed rows, may be pinned and read from any thread. nullptr until EnableSnapshots is called */
+    TSharedPtr<const FTableSnapshot<FEntityType>> PinSnapshot() const;
+
+    /** Publisher of the snapshots, lets the connection hand the table to the apply thread. nullptr until EnableSnapshots is called */
+    TSharedPtr<FTableSnapshotPublisher<FEntityType>> GetSnapshotPublisher() const;
+
+    /** Build the spatial index over Transform, rows already in the cache are added to it. Spatial queries return nothing until it is enabled */
+    UFUNCTION(BlueprintCallable, Category = "SpacetimeDB")
+    void EnableSpatialIndex(float CellSize);
+
+    /** Subscribed rows whose Transform is within Radius of Center */
+    UFUNCTION(BlueprintCallable, Category = "SpacetimeDB")
+    TArray<FEntityType> FindInRadius(FVector Center, float Radius) const;
+
+    /** Subscribed rows whose Transform is inside Box */
+    UFUNCTION(BlueprintCallable, Category = "SpacetimeDB")
+    TArray<FEntityType> FindInBox(FBox Box) const;
+
+    /** The Count subscribed rows whose Transform is nearest to Center within MaxRadius, nearest first */
+    UFUNCTION(BlueprintCallable, Category = "SpacetimeDB")
+    TArray<FEntityType> FindNearest(FVector Center, int32 Count, float MaxRadius) const;
+
+    /** Spatial index over Transform for queries without copies, nullptr until EnableSpatialIndex is called */
+    const FSpatialHashGrid<FEntityType>* GetSpatialIndex() const;
+
     // Table Events
     DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams( 
         FOnEntityInsert,
@@ -98,6 +155,8 @@ public:
     FOnEntityDelete OnDelete;
 
 private:
+    const FString SpatialIndexName = TEXT("transform");
+
     const FString TableName = TEXT("entities");
 
     TSharedPtr<UClientCache<FEntityType>> Data;
@@ -40,6 +40,18 @@ public:
         return ScheduledIdIndexHelper.FindUniqueIndex(Key);
     }
 
+    /**
+     * Finds every MoveAllPlayersTimer whose scheduledid is in [Lower, Upper), ordered by scheduledid.
+     * @param Lower The first scheduledid of the range.
+     * @param Upper The scheduledid ending the range, excluded.
+     * @return The matching FMoveAllPlayersTimerType rows.
+     */
+    // NOTE: Not exposed to Blueprint because uint64 types are not Blueprint-compatible
+    TArray<FMoveAllPlayersTimerType> FilterRange(uint64 Lower, uint64 Upper) const
+    {
+        return ScheduledIdIndexHelper.FindUniqueIndexRange(Lower, Upper);
+    }
+
     // A public setter to provide the cache to the helper after construction
     // This is a common pattern when the cache might be created or provided by another system.
     void SetCache(TSharedPtr<const FTableCache<FMoveAllPlayersTimerType>> InMoveAllPlayersTimerCache)
@@ -60,6 +72,10 @@ public:
 
     void PostInitialize();
 
+    /** Primary key column, the client cache keys rows on it */
+    using FPrimaryKey = uint64;
+    static const uint64& GetPrimaryKey(const FMoveAllPlayersTimerType& Row) { return Row.ScheduledId; }
+
     /** Update function for move_all_players_timer table*/
     FTableAppliedDiff<FMoveAllPlayersTimerType> Update(TArray<FWithBsatn<FMoveAllPlayersTimerType>> InsertsRef, TArray<FWithBsatn<FMoveAllPlayersTimerType>> DeletesRef);
 
@@ -71,6 +87,28 @@ public:
     UFUNCTION(BlueprintCallable, Category = "SpacetimeDB")
     TArray<FMoveAllPlayersTimerType> Iter() const;
 
+    /** Return at most PageSize subscribed rows starting at Cursor, 0 for the first page. NextCursor is where the next page starts, bHasMore is set when rows remain */
+    UFUNCTION(BlueprintCallable, Category = "SpacetimeDB")
+    TArray<FMoveAllPlayersTimerType> IterPage(int32 Cursor, int32 PageSize, int32& NextCursor, bool& bHasMore) const;
+
+    /** Visit every subscribed row in the cache in place, without copying it */
+    void ForEach(TFunctionRef<void(const FMoveAllPlayersTimerType&)> Visit) const;
+
+    /**
+     * Subscribed rows in the cache for range-based for loops, read in place and valid until the next applied diff.
+     * Empty when diffs are applied on the apply thread, read PinSnapshot instead.
+     */
+    const FTableCache<FMoveAllPlayersTimerType>& Rows() const;
+
+    /** Start publishing snapshots of the subscribed rows for worker threads, the first one holds the rows already in the cache */
+    void EnableSnapshots();
+
+    /** Latest snapshot of the subscribed rows, may be pinned and read from any thread. nullptr until EnableSnapshots is called */
+    TSharedPtr<const FTableSnapshot<FMoveAllPlayersTimerType>> PinSnapshot() const;
+
+    /** Publisher of the snapshots, lets the connection hand the table to the apply thread. nullptr until EnableSnapshots is called */
+    TSharedPtr<FTableSnapshotPublisher<FMoveAllPlayersTimerType>> GetSnapshotPublisher() const;
+
     // Table Events
     DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams( 
         FOnMoveAllPlayersTimerInsert,
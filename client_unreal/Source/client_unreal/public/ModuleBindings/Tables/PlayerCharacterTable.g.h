@@ -40,6 +40,18 @@ public:
         return CharacterIdIndexHelper.FindUniqueIndex(Key);
     }
 
+    /**
+     * Finds every PlayerCharacter whose characterid is in [Lower, Upper), ordered by characterid.
+     * @param Lower The first characterid of the range.
+     * @param Upper The characterid ending the range, excluded.
+     * @return The matching FPlayerCharacterType rows.
+     */
+    // NOTE: Not exposed to Blueprint because uint32 types are not Blueprint-compatible
+    TArray<FPlayerCharacterType> FilterRange(uint32 Lower, uint32 Upper) const
+    {
+        return CharacterIdIndexHelper.FindUniqueIndexRange(Lower, Upper);
+    }
+
     // A public setter to provide the cache to the helper after construction
     // This is a common pattern when the cache might be created or provided by another system.
     void SetCache(TSharedPtr<const FTableCache<FPlayerCharacterType>> InPlayerCharacterCache)
@@ -68,6 +80,31 @@ public:
         return OutResults;
     }
 
+    /**
+     * Rows with the given EntityId read in place, without copies. Valid until the next applied diff, so only read them
+     * on the game thread outside the FrameTick apply. Other threads read a pinned snapshot, see PinSnapshot.
+     */
+    FIndexRowRange<FPlayerCharacterType> FilterRows(const uint32& EntityId) const
+    {
+        static const FString IndexName(TEXT("entity_id"));
+        return LocalCache->FindRowsByMultiKeyBTreeIndex<TTuple<uint32>>(IndexName, MakeTuple(EntityId));
+    }
+
+    /** Rows with Lower <= EntityId < Upper, ordered by EntityId then by primary key */
+    TArray<FPlayerCharacterType> FilterRange(const uint32& Lower, const uint32& Upper) const
+    {
+        TArray<FPlayerCharacterType> OutResults;
+
+        LocalCache->FindRangeByMultiKeyBTreeIndex<TTuple<uint32>>(
+            OutResults,
+            TEXT("entity_id"),
+            MakeTuple(Lower),
+            MakeTuple(Upper)
+        );
+
+        return OutResults;
+    }
+
     void SetCache(TSharedPtr<FTableCache<FPlayerCharacterType>> InCache)
     {
         LocalCache = InCache;
@@ -102,6 +139,31 @@ public:
         return OutResults;
     }
 
+    /**
+     * Rows with the given PlayerId read in place, without copies. Valid until the next applied diff, so only read them
+     * on the game thread outside the FrameTick apply. Other threads read a pinned snapshot, see PinSnapshot.
+     */
+    FIndexRowRange<FPlayerCharacterType> FilterRows(const uint32& PlayerId) const
+    {
+        static const FString IndexName(TEXT("player_id"));
+        return LocalCache->FindRowsByMultiKeyBTreeIndex<TTuple<uint32>>(IndexName, MakeTuple(PlayerId));
+    }
+
+    /** Rows with Lower <= PlayerId < Upper, ordered by PlayerId then by primary key */
+    TArray<FPlayerCharacterType> FilterRange(const uint32& Lower, const uint32& Upper) const
+    {
+        TArray<FPlayerCharacterType> OutResults;
+
+        LocalCache->FindRangeByMultiKeyBTreeIndex<TTuple<uint32>>(
+            OutResults,
+            TEXT("player_id"),
+            MakeTuple(Lower),
+            MakeTuple(Upper)
+        );
+
+        return OutResults;
+    }
+
     void SetCache(TSharedPtr<FTableCache<FPlayerCharacterType>> InCache)
     {
         LocalCache = InCache;
@@ -134,6 +196,10 @@ public:
 
     void PostInitialize();
 
+    /** Primary key column, the client cache keys rows on it */
+    using FPrimaryKey = uint32;
+    static const uint32& GetPrimaryKey(const FPlayerCharacterType& Row) { return Row.CharacterId; }
+
     /** Update function for player_characters table*/
     FTableAppliedDiff<FPlayerCharacterType> Update(TArray<FWithBsatn<FPlayerCharacterType>> InsertsRef, TArray<FWithBsatn<FPlayerCharacterType>> DeletesRef);
 
@@ -145,6 +211,47 @@ public:
     UFUNCTION(BlueprintCallable, Category = "SpacetimeDB")
     TArray<FPlayerCharacterType> Iter() const;
 
+    /** Return at most PageSize subscribed rows starting at Cursor, 0 for the first page. NextCursor is where the next page starts, bHasMore is set when rows remain */
+    UFUNCTION(BlueprintCallable, Category = "SpacetimeDB")
+    TArray<FPlayerCharacterType> IterPage(int32 Cursor, int32 PageSize, int32& NextCursor, bool& bHasMore) const;
+
+    /** Visit every subscribed row in the cache in place, without copying it */
+    void ForEach(TFunctionRef<void(const FPlayerCharacterType&)> Visit) const;
+
+    /**
+     * Subscribed rows in the cache for range-based for loops, read in place and valid until the next applied diff.
+     * Empty when diffs are applied on the apply thread, read PinSnapshot instead.
+     */
+    const FTableCache<FPlayerCharacterType>& Rows() const;
+
+    /** Start publishing snapshots of the subscribed rows for worker threads, the first one holds the rows already in the cache */
+    void EnableSnapshots();
+
+    /** Latest snapshot of the subscribed rows, may be pinned and read from any thread. nullptr until EnableSnapshots is called */
+    TSharedPtr<const FTableSnapshot<FPlayerCharacterType>> PinSnapshot() const;
+
+    /** Publisher of the snapshots, lets the connection hand the table to the apply thread. nullptr until EnableSnapshots is called */
+    TSharedPtr<FTableSnapshotPublisher<FPlayerCharacterType>> GetSnapshotPublisher() const;
+
+    /** Build the spatial index over Transform, rows already in the cache are added to it. Spatial queries return nothing until it is enabled */
+    UFUNCTION(BlueprintCallable, Category = "SpacetimeDB")
+    void EnableSpatialIndex(float CellSize);
+
+    /** Subscribed rows whose Transform is within Radius of Center */
+    UFUNCTION(BlueprintCallable, Category = "SpacetimeDB")
+    TArray<FPlayerCharacterType> FindInRadius(FVector Center, float Radius) const;
+
+    /** Subscribed rows whose Transform is inside Box */
+    UFUNCTION(BlueprintCallable, Category = "SpacetimeDB")
+    TArray<FPlayerCharacterType> FindInBox(FBox Box) const;
+
+    /** The Count subscribed rows whose Transform is nearest to Center within MaxRadius, nearest first */
+    UFUNCTION(BlueprintCallable, Category = "SpacetimeDB")
+    TArray<FPlayerCharacterType> FindNearest(FVector Center, int32 Count, float MaxRadius) const;
+
+    /** Spatial index over Transform for queries without copies, nullptr until EnableSpatialIndex is called */
+    const FSpatialHashGrid<FPlayerCharacterType>* GetSpatialIndex() const;
+
     // Table Events
     DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams( 
         FOnPlayerCharacterInsert,
@@ -172,6 +279,8 @@ public:
     FOnPlayerCharacterDelete OnDelete;
 
 private:
+    const FString SpatialIndexName = TEXT("transform");
+
     const FString TableName = TEXT("player_characters");
 
     TSharedPtr<UClientCache<FPlayerCharacterType>> Data;
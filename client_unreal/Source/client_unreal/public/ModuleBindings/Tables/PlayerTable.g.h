@@ -100,6 +100,10 @@ public:
 
     void PostInitialize();
 
+    /** Primary key column, the client cache keys rows on it */
+    using FPrimaryKey = FSpacetimeDBIdentity;
+    static const FSpacetimeDBIdentity& GetPrimaryKey(const FPlayerType& Row) { return Row.Identity; }
+
     /** Update function for players table*/
     FTableAppliedDiff<FPlayerType> Update(TArray<FWithBsatn<FPlayerType>> InsertsRef, TArray<FWithBsatn<FPlayerType>> DeletesRef);
 
@@ -111,6 +115,28 @@ public:
     UFUNCTION(BlueprintCallable, Category = "SpacetimeDB")
     TArray<FPlayerType> Iter() const;
 
+    /** Return at most PageSize subscribed rows starting at Cursor, 0 for the first page. NextCursor is where the next page starts, bHasMore is set when rows remain */
+    UFUNCTION(BlueprintCallable, Category = "SpacetimeDB")
+    TArray<FPlayerType> IterPage(int32 Cursor, int32 PageSize, int32& NextCursor, bool& bHasMore) const;
+
+    /** Visit every subscribed row in the cache in place, without copying it */
+    void ForEach(TFunctionRef<void(const FPlayerType&)> Visit) const;
+
+    /**
+     * Subscribed rows in the cache for range-based for loops, read in place and valid until the next applied diff.
+     * Empty when diffs are applied on the apply thread, read PinSnapshot instead.
+     */
+    const FTableCache<FPlayerType>& Rows() const;
+
+    /** Start publishing snapshots of the subscribed rows for worker threads, the first one holds the rows already in the cache */
+    void EnableSnapshots();
+
+    /** Latest snapshot of the subscribed rows, may be pinned and read from any thread. nullptr until EnableSnapshots is called */
+    TSharedPtr<const FTableSnapshot<FPlayerType>> PinSnapshot() const;
+
+    /** Publisher of the snapshots, lets the connection hand the table to the apply thread. nullptr until EnableSnapshots is called */
+    TSharedPtr<FTableSnapshotPublisher<FPlayerType>> GetSnapshotPublisher() const;
+
     // Table Events
     DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams( 
         FOnPlayerInsert,
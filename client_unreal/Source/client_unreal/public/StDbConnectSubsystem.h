@@ -48,6 +48,19 @@ public:
 	UPROPERTY(EditAnywhere, Category = "MMORPG|Connection")
 	FString TokenFilePath = TEXT(".spacetime_mmorpg");
 
+	// Rate at which coalesced player input is sent to the server
+	UPROPERTY(EditAnywhere, Category = "MMORPG|Connection", meta = (ClampMin = "0.0"))
+	float InputSendRateHz = 30.0f;
+
+	// Cell size of the spatial index kept over the Entity table, about the usual proximity query radius
+	UPROPERTY(EditAnywhere, Category = "MMORPG|Connection", meta = (ClampMin = "1.0"))
+	float EntitySpatialCellSize = 2000.0f;
+
+	// Apply table updates on a dedicated thread, the game thread then only fires the table events.
+	// Index lookups and the Entity spatial index keep working, they follow the rows the events reported
+	UPROPERTY(EditAnywhere, Category = "MMORPG|Connection")
+	bool bUseApplyThread = true;
+
 	UPROPERTY(BlueprintReadOnly, Category = "MMORPG|Connection")
 	FSpacetimeDBIdentity LocalIdentity;
 
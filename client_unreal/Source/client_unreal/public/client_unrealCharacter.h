@@ -49,6 +49,14 @@ protected:
 	UPROPERTY(EditAnywhere, Category="Input")
 	UInputAction* MouseLookAction;
 
+	/** Minimum distance in cm the character has to move before its transform is sent again */
+	UPROPERTY(EditAnywhere, Category="Networking", meta = (ClampMin = "0.0"))
+	float LocationSendThreshold = 1.0f;
+
+	/** Minimum rotation in degrees the character has to turn before its transform is sent again */
+	UPROPERTY(EditAnywhere, Category="Networking", meta = (ClampMin = "0.0"))
+	float RotationSendThreshold = 0.5f;
+
 public:
 
 	/** Constructor */
@@ -86,7 +94,7 @@ public:
 	virtual void DoJumpEnd();
 
 private:
-	/** Send current transform to server */
+	/** Queue the current transform for the server, sent at the connection's outgoing rate */
 	void SendTransformToServer();
 
 public: